@@ -32,8 +32,9 @@ const char* rfc_err_str( int nr )
 
 
 // Parse RFC counting parameters
+// (streaming: total data length is unknown in advance, see Counter object)
 static
-int parse_rfc_kwargs( PyObject* kwargs, Py_ssize_t len, Rainflow *rf, Rainflow::rfc_res_method *res_method )
+int parse_rfc_kwargs( PyObject* kwargs, Py_ssize_t len, Rainflow *rf, Rainflow::rfc_res_method *res_method, int streaming )
 {
     PyObject   *empty           =  PyTuple_New(0);
     int         class_count     =  100;
@@ -46,7 +47,8 @@ int parse_rfc_kwargs( PyObject* kwargs, Py_ssize_t len, Rainflow *rf, Rainflow::
     int         lc_method       =  0;  // Count rising slopes only
     int         flags           =  Rainflow::RFC_FLAGS_DEFAULT;
     int         auto_resize     =  0;  // false
-    int         spread_damage   =  Rainflow::RFC_SD_TRANSIENT_23c;
+    int         spread_damage   =  streaming ? (int)Rainflow::RFC_SD_NONE
+                                             : (int)Rainflow::RFC_SD_TRANSIENT_23c;
     PyObject   *wl              =  NULL;
     double      wl_sd           =  1e3, wl_nd = 1e7, 
                 wl_k            =  5,   wl_k2 = 5;
@@ -203,6 +205,13 @@ int parse_rfc_kwargs( PyObject* kwargs, Py_ssize_t len, Rainflow *rf, Rainflow::
         return 0;
     }
 
+    if( streaming && spread_damage > (int)Rainflow::RFC_SD_NONE )
+    {
+        PyErr_SetString( PyExc_RuntimeError, "Parameter 'spread_damage' requires the total data length in advance "
+                                             "and is not supported when streaming!" );
+        return 0;
+    }
+
     if( spread_damage > (int)Rainflow::RFC_SD_NONE )
     {
         if( !rf->dh_init( (Rainflow::rfc_sd_method_e) spread_damage, NULL, (size_t)len, /*is_static*/ false ) )
@@ -237,20 +246,17 @@ int parse_rfc_kwargs( PyObject* kwargs, Py_ssize_t len, Rainflow *rf, Rainflow::
 }
 
 
-// Parse input data array
-static 
-int parse_rfc_input_series( PyObject* input_series_arg, PyArrayObject **arr_data, npy_double **data, Py_ssize_t *len )
+// Parse input data array.
+// PyArray_FROM_OTF passes aligned C contiguous float64 buffers through without
+// copying, the raw data pointer is accessed in place then (zero copy). A
+// conversion (copy) only takes place for any other input type.
+static
+int parse_rfc_input_array( PyObject* arg1, PyArrayObject **arr_data, npy_double **data, Py_ssize_t *len )
 {
-    PyObject *arg1;
-
     *arr_data = NULL;
     *data = NULL;
     *len = 0;
 
-    if( !PyArg_ParseTuple( input_series_arg, "O", &arg1 ) )
-    {
-        return 0;
-    }
     /*
     if( !PyArray_Check( arg1 ) )
     {
@@ -265,37 +271,67 @@ int parse_rfc_input_series( PyObject* input_series_arg, PyArrayObject **arr_data
     }
 
     // Number of dimensions
-    int arr_nd = PyArray_NDIM( *arr_data );
-    int arr_type = PyArray_TYPE( *arr_data );
-    npy_intp *arr_dims = PyArray_DIMS( *arr_data );
-
-    if( arr_nd != 1 )
+    if( PyArray_NDIM( *arr_data ) != 1 )
     {
         PyErr_SetString( PyExc_RuntimeError, "Data must have only one dimension!" );
+        Py_DECREF( *arr_data );
+        *arr_data = NULL;
         return 0;
     }
 
-    int r = PyArray_AsCArray( (PyObject**)arr_data, (void**)data, arr_dims, arr_nd, PyArray_DescrFromType(arr_type) );
-    if( r < 0 )
+    *data = (npy_double*)PyArray_DATA( *arr_data );
+    *len  = (Py_ssize_t)PyArray_DIM( *arr_data, 0 );
+
+    return 1;
+}
+
+
+// Parse input data array from a positional argument tuple
+static
+int parse_rfc_input_series( PyObject* input_series_arg, PyArrayObject **arr_data, npy_double **data, Py_ssize_t *len )
+{
+    PyObject *arg1;
+
+    *arr_data = NULL;
+    *data = NULL;
+    *len = 0;
+
+    if( !PyArg_ParseTuple( input_series_arg, "O", &arg1 ) )
     {
-        PyErr_SetString( PyExc_RuntimeError, "Could not convert input to C array" );
         return 0;
     }
 
-    *len = arr_dims[0];
+    return parse_rfc_input_array( arg1, arr_data, data, len );
+}
+
+
+// Feed data into the counter, the GIL is released while counting
+static
+int do_rainflow_feed( Rainflow *rf, const npy_double *data, Py_ssize_t len )
+{
+    bool ok;
+
+    Py_BEGIN_ALLOW_THREADS
+    ok = rf->feed( data, len );
+    Py_END_ALLOW_THREADS
+
+    if( !ok )
+    {
+        PyErr_Format( PyExc_RuntimeError, "Error while counting (%s)", rfc_err_str( rf->error_get() ) );
+        return 0;
+    }
 
     return 1;
 }
 
 
-// Process rainflow counting
+// Grab the raw residuum and finalize the counter
 static
-int do_rainflow( Rainflow *rf, npy_double *data, Py_ssize_t len, Rainflow::rfc_res_method res_method, rfc_residuum_vec &residuum_raw )
+int do_rainflow_finalize( Rainflow *rf, Rainflow::rfc_res_method res_method, rfc_residuum_vec &residuum_raw )
 {
     const Rainflow::rfc_value_tuple_s *residuum;
     unsigned residuum_len;
-
-    if( !rf->feed( data, len ) ) goto fail;
+    bool ok;
 
     if( !rf->res_get( &residuum, &residuum_len ) ) goto fail;
 
@@ -333,7 +369,11 @@ int do_rainflow( Rainflow *rf, npy_double *data, Py_ssize_t len, Rainflow::rfc_r
         }
     }
 
-    if( !rf->finalize( res_method ) ) goto fail;
+    Py_BEGIN_ALLOW_THREADS
+    ok = rf->finalize( res_method );
+    Py_END_ALLOW_THREADS
+
+    if( !ok ) goto fail;
 
     return 1;
 fail:
@@ -342,6 +382,15 @@ fail:
 }
 
 
+// Process rainflow counting in one go
+static
+int do_rainflow( Rainflow *rf, npy_double *data, Py_ssize_t len, Rainflow::rfc_res_method res_method, rfc_residuum_vec &residuum_raw )
+{
+    return do_rainflow_feed( rf, data, len ) &&
+           do_rainflow_finalize( rf, res_method, residuum_raw );
+}
+
+
 // Prepare results
 static
 int prepare_results( Rainflow *rf, Py_ssize_t data_len, Rainflow::rfc_res_method res_method, rfc_residuum_vec &residuum_raw, PyObject **ret )
@@ -511,7 +560,7 @@ static PyObject* rfc( PyObject *self, PyObject *args, PyObject *kwargs )
             break;
         }
 
-        if( !parse_rfc_kwargs( kwargs, len, &rf, &res_method ) )
+        if( !parse_rfc_kwargs( kwargs, len, &rf, &res_method, /*streaming*/ 0 ) )
         {
             break;
         }
@@ -539,16 +588,180 @@ static PyObject* rfc( PyObject *self, PyObject *args, PyObject *kwargs )
     
     rf.deinit();
 
-    if( arr_data && data )
+    if( arr_data )
     {
         Py_DECREF( arr_data );
-        PyArray_Free( (PyObject*)arr_data, (void*)data );
     }
 
     return ret;
 }
 
 
+// Stateful counter object, counts chunk-wise fed data ("rfcnt.Counter")
+typedef struct
+{
+    PyObject_HEAD
+    Rainflow                   *rf;          // Counter instance, heap allocated
+    Rainflow::rfc_res_method    res_method;  // Residual method, applied on finalizing
+    Py_ssize_t                  chunks_len;  // Number of data points fed so far
+    int                         finalized;   // Non-zero, after finalize() was called
+} CounterObject;
+
+
+static
+PyObject* Counter_new( PyTypeObject *type, PyObject *args, PyObject *kwargs )
+{
+    CounterObject *self = (CounterObject*)type->tp_alloc( type, 0 );
+
+    if( self )
+    {
+        self->rf         = NULL;
+        self->res_method = Rainflow::RFC_RES_REPEATED;
+        self->chunks_len = 0;
+        self->finalized  = 0;
+    }
+
+    return (PyObject*)self;
+}
+
+
+static
+int Counter_init( CounterObject *self, PyObject *args, PyObject *kwargs )
+{
+    if( args && PyTuple_Size( args ) > 0 )
+    {
+        PyErr_SetString( PyExc_RuntimeError, "Counter() takes keyword arguments only!" );
+        return -1;
+    }
+
+    delete self->rf;
+    self->rf         = new Rainflow;
+    self->chunks_len = 0;
+    self->finalized  = 0;
+
+    // Total data length is unknown in advance (streaming)
+    if( !parse_rfc_kwargs( kwargs, /*len*/ 0, self->rf, &self->res_method, /*streaming*/ 1 ) )
+    {
+        delete self->rf;
+        self->rf = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+static
+void Counter_dealloc( CounterObject *self )
+{
+    delete self->rf;
+    Py_TYPE( self )->tp_free( (PyObject*)self );
+}
+
+
+static
+PyObject* Counter_feed( CounterObject *self, PyObject *args )
+{
+    PyArrayObject *arr_data = NULL;
+    npy_double *data;
+    Py_ssize_t len;
+    int ok;
+
+    if( !self->rf )
+    {
+        PyErr_SetString( PyExc_RuntimeError, "Counter not initialized!" );
+        return NULL;
+    }
+
+    if( self->finalized )
+    {
+        PyErr_SetString( PyExc_RuntimeError, "Counter already finalized!" );
+        return NULL;
+    }
+
+    if( !parse_rfc_input_series( args, &arr_data, &data, &len ) )
+    {
+        return NULL;
+    }
+
+    ok = do_rainflow_feed( self->rf, data, len );
+
+    Py_DECREF( arr_data );
+
+    if( !ok )
+    {
+        return NULL;
+    }
+
+    self->chunks_len += len;
+
+    Py_RETURN_NONE;
+}
+
+
+static
+PyObject* Counter_finalize( CounterObject *self, PyObject *args, PyObject *kwargs )
+{
+    PyObject *ret = NULL;
+    rfc_residuum_vec residuum_raw;
+    int res_method = -1;  // -1 = "as passed on construction"
+
+    static char* kw[] = {"residual_method", NULL};
+
+    if( !self->rf )
+    {
+        PyErr_SetString( PyExc_RuntimeError, "Counter not initialized!" );
+        return NULL;
+    }
+
+    if( self->finalized )
+    {
+        PyErr_SetString( PyExc_RuntimeError, "Counter already finalized!" );
+        return NULL;
+    }
+
+    if( !PyArg_ParseTupleAndKeywords( args, kwargs, "|i", kw, &res_method ) )
+    {
+        return NULL;
+    }
+
+    if( res_method >= 0 )
+    {
+        if( res_method >= (int)Rainflow::RFC_RES_COUNT )
+        {
+            PyErr_SetString( PyExc_RuntimeError, "Unknown method for handling residue!" );
+            return NULL;
+        }
+        self->res_method = (Rainflow::rfc_res_method)res_method;
+    }
+
+    if( !do_rainflow_finalize( self->rf, self->res_method, residuum_raw ) )
+    {
+        return NULL;
+    }
+
+    self->finalized = 1;
+
+    if( !prepare_results( self->rf, self->chunks_len, self->res_method, residuum_raw, &ret ) )
+    {
+        return NULL;
+    }
+
+    return ret;
+}
+
+
+static PyMethodDef Counter_methods[] = {
+    {"feed", (PyCFunction) Counter_feed, METH_VARARGS, "Feed the next chunk of data"},
+    {"finalize", (PyCFunction) Counter_finalize, METH_VARARGS | METH_KEYWORDS, "Finalize counting and return results"},
+    {NULL, NULL, 0, NULL} // Sentinel value ending the table
+};
+
+
+// Type object, slots are filled in PyInit_rfcnt() (C++ lacks designated initializers)
+static PyTypeObject CounterType = { PyVarObject_HEAD_INIT( NULL, 0 ) };
+
+
 // Exported methods are collected in a table
 PyMethodDef method_table[] = {
     {"rfc", (PyCFunction) rfc, METH_VARARGS | METH_KEYWORDS, "Rainflow counting"},
@@ -572,8 +785,38 @@ PyModuleDef mymath_module = {
 
 // The module init function
 PyMODINIT_FUNC PyInit_rfcnt(void) {
-    PyObject* mod = PyModule_Create(&mymath_module);
+    PyObject* mod;
+
+    CounterType.tp_name      = "rfcnt.Counter";
+    CounterType.tp_doc       = PyDoc_STR( "Stateful rainflow counter, fed chunk by chunk" );
+    CounterType.tp_basicsize = sizeof( CounterObject );
+    CounterType.tp_itemsize  = 0;
+    CounterType.tp_flags     = Py_TPFLAGS_DEFAULT;
+    CounterType.tp_new       = Counter_new;
+    CounterType.tp_init      = (initproc)Counter_init;
+    CounterType.tp_dealloc   = (destructor)Counter_dealloc;
+    CounterType.tp_methods   = Counter_methods;
+
+    if( PyType_Ready( &CounterType ) < 0 )
+    {
+        return NULL;
+    }
+
+    mod = PyModule_Create(&mymath_module);
+    if( mod == NULL )
+    {
+        return NULL;
+    }
     // Initialize numpy
     import_array();
+
+    Py_INCREF( &CounterType );
+    if( PyModule_AddObject( mod, "Counter", (PyObject*)&CounterType ) < 0 )
+    {
+        Py_DECREF( &CounterType );
+        Py_DECREF( mod );
+        return NULL;
+    }
+
     return mod;
 }
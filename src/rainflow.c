@@ -107,9 +107,22 @@
 
 #include <assert.h>  /* assert() */
 #include <math.h>    /* exp(), log(), fabs() */
+#include <stdint.h>  /* uint32_t */
 #include <stdlib.h>  /* calloc(), free(), abs() */
 #include <string.h>  /* memset() */
 #include <float.h>   /* DBL_MAX */
+#if RFC_FILE_SUPPORT
+#include <stdio.h>   /* File ingest, see RFC_feed_file() */
+#if defined(__unix__) || defined(__linux__) || ( defined(__APPLE__) && defined(__MACH__) )
+#define RFC_FEED_FILE_USE_MMAP 1
+#include <sys/mman.h>   /* mmap() */
+#include <sys/stat.h>   /* fstat() */
+#include <fcntl.h>      /* open() */
+#include <unistd.h>     /* close() */
+#else /*no mmap*/
+#define RFC_FEED_FILE_USE_MMAP 0
+#endif
+#endif /*RFC_FILE_SUPPORT*/
 
 #ifndef CALLOC
 #define CALLOC calloc
@@ -142,7 +155,13 @@
 "             Sm = Mean load\n"\
 "              M = Mean load sensitivity\n"\
 "         target = Mean load or mean load ratio (R)\n"\
-"    target_is_R = true, if target is R (otherwise target is test rig mean load)\n"
+"    target_is_R = true, if target is R (otherwise target is test rig mean load)\n"\
+"\n"\
+"Streaming (context kept alive across calls):\n"\
+"[handle] = rfc( 'init', class_count, class_width, class_offset, hysteresis, residual_method, enforce_margin, use_hcm, use_astm, spread_damage, auto_resize )\n"\
+"           rfc( 'feed', handle, chunk )\n"\
+"[pd,re,rm,rp,lc,tp,dh] = rfc( 'results', handle )\n"\
+"           rfc( 'deinit', handle )\n"
 #else /*RFC_MINIMAL*/
 #define RFC_MEX_USAGE \
 "\nUsage:\n"\
@@ -177,6 +196,9 @@ static bool                 feed_once                       (       rfc_ctx_s *,
 #if RFC_DH_SUPPORT
 static bool                 feed_once_dh                    (       rfc_ctx_s *, const rfc_value_tuple_s* pt );
 #endif /*RFC_DH_SUPPORT*/
+#if !RFC_MINIMAL
+static bool                 feed_once_followers             (       rfc_ctx_s *, const rfc_value_tuple_s* pt );
+#endif /*!RFC_MINIMAL*/
 #if RFC_TP_SUPPORT
 static bool                 feed_once_tp_check_margin       (       rfc_ctx_s *, const rfc_value_tuple_s* pt, rfc_value_tuple_s** tp_residue );
 #endif /*RFC_TP_SUPPORT*/
@@ -211,33 +233,59 @@ static bool                 finalize_res_repeated           (       rfc_ctx_s *,
 static bool                 residue_exchange                (       rfc_ctx_s *, rfc_value_tuple_s **residue, size_t *residue_cap, size_t *residue_cnt, bool restore );
 #endif /*!RFC_MINIMAL*/
 static void                 residue_remove_item             (       rfc_ctx_s *, size_t index, size_t count );
+#if !RFC_MINIMAL
+/* Methods on sparse rainflow matrix */
+static rfc_counts_t *       rfm_sparse_at                   (       rfc_ctx_s *, unsigned class_from, unsigned class_to, bool insert );
+static bool                 rfm_sparse_rehash               (       rfc_ctx_s *, size_t new_cap );
+static int                  rfm_sparse_item_compare         ( const void *lhs, const void *rhs );
+/* Methods on context snapshots */
+static size_t               ctx_snapshot_scalars            (       rfc_ctx_s *, unsigned char *buffer, size_t buffer_size, bool do_write );
+#endif /*!RFC_MINIMAL*/
 /* Memory allocator */
 static void *               mem_alloc                       ( void *ptr, size_t num, size_t size, int aim );
+static void *               ctx_mem_alloc                   (       rfc_ctx_s *, void *ptr, size_t num, size_t size, int aim );
+#if !RFC_MINIMAL
+static void *               mem_arena_alloc                 (       rfc_mem_arena_s *, void *ptr, size_t size );
+static void *               mem_alloc_arena                 ( void *ptr, size_t num, size_t size, int aim );
+#endif /*!RFC_MINIMAL*/
 #if RFC_TP_SUPPORT
 /* Methods on turning points history */
 static bool                 tp_set                          (       rfc_ctx_s *, size_t tp_pos, rfc_value_tuple_s *pt );
 static bool                 tp_get                          (       rfc_ctx_s *, size_t tp_pos, rfc_value_tuple_s **pt );
 static bool                 tp_inc_damage                   (       rfc_ctx_s *, size_t tp_pos, double damage );
 static void                 tp_lock                         (       rfc_ctx_s *, bool do_lock );
+static size_t               tp_prune_map                    ( const rfc_ctx_s *, size_t tp_pos );
+static bool                 tp_prune_inc_start              (       rfc_ctx_s *, size_t limit );
+static void                 tp_prune_inc_step               (       rfc_ctx_s *, size_t max_move );
 static bool                 tp_refeed                       (       rfc_ctx_s *, rfc_value_t new_hysteresis, const rfc_class_param_s *new_class_param );
 #endif /*RFC_TP_SUPPORT*/
 #if RFC_DH_SUPPORT
 static bool                 spread_damage                   (       rfc_ctx_s *, rfc_value_tuple_s *from, rfc_value_tuple_s *to, rfc_value_tuple_s *next, rfc_flags_e flags );
 static bool                 spread_damage_map_tp            (       rfc_ctx_s * );
+static bool                 dh_add                          (       rfc_ctx_s *, size_t pos_0, double damage );
 #endif /*RFC_DH_SUPPORT*/
 #if RFC_AT_SUPPORT
 static bool                 at_R_to_Sm_norm                 (       rfc_ctx_s *, double R, double *Sm_norm );
 static bool                 at_alleviation                  (       rfc_ctx_s *, double Sm_norm, double *alleviation );
+static bool                 at_transform_exact              (       rfc_ctx_s *, double Sa, double Sm, double *Sa_transformed );
+static bool                 at_lut_build                    (       rfc_ctx_s * );
+static bool                 at_lut_interpolate              ( const rfc_ctx_s *, double Sa, double Sm, double *Sa_transformed );
 #endif /*RFC_AT_SUPPORT*/
 /* Other */
 static bool                 damage_calc_amplitude           (       rfc_ctx_s *, double Sa, double *damage );
 static bool                 damage_calc                     (       rfc_ctx_s *, unsigned class_from, unsigned class_to, double *damage, double *Sa_ret );
 #if RFC_DAMAGE_FAST
 static bool                 damage_lut_init                 (       rfc_ctx_s * );
+static bool                 damage_lut_fill_row             (       rfc_ctx_s *, unsigned class_from );
+static bool                 damage_lut_fill_all             (       rfc_ctx_s * );
+static bool                 damage_lut_detach               (       rfc_ctx_s * );
 static bool                 damage_calc_fast                (       rfc_ctx_s *, unsigned class_from, unsigned class_to, double *damage, double *Sa_ret );
 #endif /*RFC_DAMAGE_FAST*/
 static bool                 error_raise                     (       rfc_ctx_s *, rfc_error_e );
 static rfc_value_t          value_delta                     (       rfc_ctx_s *, const rfc_value_tuple_s* pt_from, const rfc_value_tuple_s* pt_to, int *sign_ptr );
+#if !RFC_MINIMAL
+static void                 wl_param_assign                 (       rfc_ctx_s *, const rfc_wl_param_s * );
+#endif /*!RFC_MINIMAL*/
 
 
 #define QUANTIZE( r, v )    ( (r)->class_count ? (unsigned)( ((v) - (r)->class_offset) / (r)->class_width ) : 0 )
@@ -247,6 +295,46 @@ static rfc_value_t          value_delta                     (       rfc_ctx_s *,
 #define NUMEL( x )          ( sizeof(x) / sizeof(*(x)) )
 #define MAT_OFFS( i, j )    ( (i) * class_count + (j) )
 
+#if RFC_USE_INTEGRAL_COUNTS > 1
+/* Saturating histogram increment: clamp at RFC_COUNTS_LIMIT and latch
+   RFC_ERROR_COUNTS_SATURATED, counting proceeds (context is not poisoned) */
+#define COUNTS_INC( r, lhs, inc )                                   \
+    do {                                                            \
+        if( (lhs) > (rfc_counts_t)RFC_COUNTS_LIMIT - (inc) )        \
+        {                                                           \
+            (lhs)      = (rfc_counts_t)RFC_COUNTS_LIMIT;            \
+            (r)->error = RFC_ERROR_COUNTS_SATURATED;                \
+        }                                                           \
+        else                                                        \
+        {                                                           \
+            (lhs) += (inc);                                         \
+        }                                                           \
+    } while(0)
+#else /*RFC_USE_INTEGRAL_COUNTS <= 1*/
+#define COUNTS_INC( r, lhs, inc )   do { (lhs) += (inc); } while(0)
+#endif /*RFC_USE_INTEGRAL_COUNTS > 1*/
+
+#if !RFC_MINIMAL
+/* Arena (bump) allocator, see RFC_mem_arena_init(). Each block is preceded
+   by a header, so the allocation functor can tell arena blocks from heap
+   fallback blocks without a context at hand. */
+typedef struct mem_arena_header
+{
+    rfc_mem_arena_s                    *arena;                      /**< Owning arena, NULL for heap fallback blocks */
+    size_t                              size;                       /**< Block size in bytes (aligned) */
+} mem_arena_header_s;
+
+struct rfc_mem_arena
+{
+    unsigned char                      *slab;                       /**< Contiguous storage, right after this struct */
+    size_t                              size;                       /**< Slab size in bytes */
+    size_t                              offset;                     /**< Bump position */
+    void                               *last;                       /**< Header of the most recent block, rollback candidate */
+};
+
+#define MEM_ARENA_ALIGN( S )        ( ( (S) + sizeof(double) - 1 ) & ~( sizeof(double) - 1 ) )
+#endif /*!RFC_MINIMAL*/
+
 #define RFC_CTX_CHECK_AND_ASSIGN                                                    \
     rfc_ctx_s *rfc_ctx = (rfc_ctx_s*)ctx;                                           \
                                                                                     \
@@ -388,7 +476,7 @@ bool RFC_init( void *ctx, unsigned class_count, rfc_value_t class_width, rfc_val
     }
     else
     {
-        rfc_ctx->residue                    = (rfc_value_tuple_s*)rfc_ctx->mem_alloc( NULL, rfc_ctx->residue_cap, 
+        rfc_ctx->residue                    = (rfc_value_tuple_s*)ctx_mem_alloc( rfc_ctx, NULL, rfc_ctx->residue_cap, 
                                                                                       sizeof(rfc_value_tuple_s), RFC_MEM_AIM_RESIDUE );
         rfc_ctx->internal.res_static        = false;
     }
@@ -400,23 +488,32 @@ bool RFC_init( void *ctx, unsigned class_count, rfc_value_t class_width, rfc_val
         if( ok && ( flags & RFC_FLAGS_COUNT_RFM ) )
         {
             /* Non-sparse storages (optional, may be NULL) */
-            rfc_ctx->rfm                    = (rfc_counts_t*)rfc_ctx->mem_alloc( NULL, class_count * class_count, 
+            rfc_ctx->rfm                    = (rfc_counts_t*)ctx_mem_alloc( rfc_ctx, NULL, class_count * class_count,
                                                                                  sizeof(rfc_counts_t), RFC_MEM_AIM_MATRIX );
             if( !rfc_ctx->rfm ) ok = false;
         }
 #if !RFC_MINIMAL
+        /* Sparse rainflow matrix storage (optional, see RFC_rfm_init_sparse()) */
+        rfc_ctx->rfm_sparse                 = NULL;
+        rfc_ctx->rfm_sparse_cap             = 0;
+        rfc_ctx->rfm_sparse_cnt             = 0;
+
         if( ok && ( flags & RFC_FLAGS_COUNT_RP ) )
         {
-            rfc_ctx->rp                     = (rfc_counts_t*)rfc_ctx->mem_alloc( NULL, class_count,
+            rfc_ctx->rp                     = (rfc_counts_t*)ctx_mem_alloc( rfc_ctx, NULL, class_count,
                                                                                  sizeof(rfc_counts_t), RFC_MEM_AIM_RP );
-            if( !rfc_ctx->rp ) ok = false;
+            rfc_ctx->rp_bin_version         = (size_t*)ctx_mem_alloc( rfc_ctx, NULL, class_count,
+                                                                                 sizeof(size_t), RFC_MEM_AIM_RP );
+            if( !rfc_ctx->rp || !rfc_ctx->rp_bin_version ) ok = false;
         }
 
         if( ok && ( flags & RFC_FLAGS_COUNT_LC ) )
         {
-            rfc_ctx->lc                     = (rfc_counts_t*)rfc_ctx->mem_alloc( NULL, class_count,
+            rfc_ctx->lc                     = (rfc_counts_t*)ctx_mem_alloc( rfc_ctx, NULL, class_count,
                                                                                  sizeof(rfc_counts_t), RFC_MEM_AIM_LC );
-            if( !rfc_ctx->lc ) ok = false;
+            rfc_ctx->lc_bin_version         = (size_t*)ctx_mem_alloc( rfc_ctx, NULL, class_count,
+                                                                                 sizeof(size_t), RFC_MEM_AIM_LC );
+            if( !rfc_ctx->lc || !rfc_ctx->lc_bin_version ) ok = false;
         }
 #endif /*!RFC_MINIMAL*/
         if( !ok )
@@ -442,6 +539,17 @@ bool RFC_init( void *ctx, unsigned class_count, rfc_value_t class_width, rfc_val
     rfc_ctx->state = RFC_STATE_INIT;   /* Bypass sanity check for state in wl_init() */
     RFC_wl_param_get( rfc_ctx, &rfc_ctx->internal.wl );
     rfc_ctx->state = RFC_STATE_INIT0;  /* Reset state */
+    rfc_ctx->internal.ring                  = NULL;
+    /* Follower contexts (optional, see RFC_ctx_attach()) */
+    rfc_ctx->followers                      = NULL;
+    rfc_ctx->follower_cnt                   = 0;
+    rfc_ctx->follower_cap                   = 0;
+    /* Histogram versions (see RFC_rp_get_delta(), RFC_lc_get_delta()) */
+    rfc_ctx->rp_version                     = 0;
+    rfc_ctx->lc_version                     = 0;
+#if RFC_STATS_SUPPORT
+    memset( &rfc_ctx->internal.stats, 0, sizeof( rfc_ctx->internal.stats ) );
+#endif /*RFC_STATS_SUPPORT*/
 #endif /*!RFC_MINIMAL*/
 #if RFC_TP_SUPPORT
     rfc_ctx->internal.margin[0]             = nil;  /* left  margin */
@@ -454,6 +562,8 @@ bool RFC_init( void *ctx, unsigned class_count, rfc_value_t class_width, rfc_val
     rfc_ctx->tp_locked                      = 0;
     rfc_ctx->tp_prune_threshold             = (size_t)-1;
     rfc_ctx->tp_prune_size                  = (size_t)-1;
+    rfc_ctx->internal.tp_prune_removal      = 0;
+    rfc_ctx->internal.tp_prune_moved        = 0;
 #endif /*RFC_TP_SUPPORT*/
 
 
@@ -465,8 +575,9 @@ bool RFC_init( void *ctx, unsigned class_count, rfc_value_t class_width, rfc_val
         rfc_ctx->internal.hcm.IR            = 1;
         /* Residue */
         rfc_ctx->internal.hcm.stack_cap     = 2 * rfc_ctx->class_count + 1; /* max size is 2*n plus interim point = 2*n+1 */
-        rfc_ctx->internal.hcm.stack         = (rfc_value_tuple_s*)rfc_ctx->mem_alloc( NULL, rfc_ctx->internal.hcm.stack_cap, 
+        rfc_ctx->internal.hcm.stack         = (rfc_value_tuple_s*)ctx_mem_alloc( rfc_ctx, NULL, rfc_ctx->internal.hcm.stack_cap,
                                                                                       sizeof(rfc_value_tuple_s), RFC_MEM_AIM_HCM );
+        rfc_ctx->internal.hcm.stack_static  = false;
     }
 #endif /*RFC_HCM_SUPPORT*/
 
@@ -479,6 +590,15 @@ bool RFC_init( void *ctx, unsigned class_count, rfc_value_t class_width, rfc_val
     rfc_ctx->at.R_rig                       = 0.0;
     rfc_ctx->at.R_pinned                    = false;
 
+    rfc_ctx->at_lut.grid                    = NULL;
+    rfc_ctx->at_lut.sa_divisions            = 0;
+    rfc_ctx->at_lut.sm_divisions            = 0;
+    rfc_ctx->at_lut.sa_max                  = 0.0;
+    rfc_ctx->at_lut.sm_min                  = 0.0;
+    rfc_ctx->at_lut.sm_max                  = 0.0;
+    rfc_ctx->at_lut.sa_scale                = 0.0;
+    rfc_ctx->at_lut.sm_scale                = 0.0;
+
     rfc_ctx->internal.at_haigh.count        = 0;
 #endif /*RFC_AT_SUPPORT*/
 
@@ -487,13 +607,16 @@ bool RFC_init( void *ctx, unsigned class_count, rfc_value_t class_width, rfc_val
 #if RFC_DAMAGE_FAST
     if( rfc_ctx->class_count )
     {
-        rfc_ctx->damage_lut                 = (double*)rfc_ctx->mem_alloc( rfc_ctx->damage_lut,    class_count * class_count, 
+        rfc_ctx->damage_lut                 = (double*)ctx_mem_alloc( rfc_ctx, rfc_ctx->damage_lut,    class_count * class_count, 
                                                                            sizeof(double), RFC_MEM_AIM_DLUT );
         rfc_ctx->damage_lut_inapt           = 1;
 #if RFC_AT_SUPPORT
-        rfc_ctx->amplitude_lut              = (double*)rfc_ctx->mem_alloc( rfc_ctx->amplitude_lut, class_count * class_count, 
+        rfc_ctx->amplitude_lut              = (double*)ctx_mem_alloc( rfc_ctx, rfc_ctx->amplitude_lut, class_count * class_count,
                                                                            sizeof(double), RFC_MEM_AIM_ALUT );
 #endif /*RFC_AT_SUPPORT*/
+        rfc_ctx->damage_lut_row_valid       = (unsigned char*)ctx_mem_alloc( rfc_ctx, rfc_ctx->damage_lut_row_valid, class_count,
+                                                                           sizeof(unsigned char), RFC_MEM_AIM_DLUT );
+        rfc_ctx->damage_lut_refcnt          = NULL;
         return damage_lut_init( rfc_ctx );
     }
 #endif /*RFC_DAMAGE_FAST*/
@@ -727,6 +850,70 @@ bool RFC_wl_init_any( void *ctx, const rfc_wl_param_s* wl_param )
 #endif /*!RFC_MINIMAL*/
 
 
+#if RFC_HCM_SUPPORT
+/**
+ * @brief      Initialize the HCM (Clormann/Seeger) residue stack with a given
+ *             buffer, replacing the stack allocated by RFC_init(). The stack
+ *             depth is bounded by 2*class_count+1 (all turning points able to
+ *             close plus one interim point), buffers below that bound are
+ *             rejected, so the stack cannot overflow and counting stays
+ *             allocation-free. A static buffer (e.g. aligned to cache line
+ *             boundaries by the caller) is left alone on RFC_deinit(), but
+ *             can't grow on autoresize then.
+ *
+ * @param      ctx        The rainflow context
+ * @param      stack      The buffer for the stack, may be NULL
+ * @param      stack_cap  The stack capacity in number of elements, at least 2*class_count+1
+ * @param      is_static  Indicates if stack is static
+ *
+ * @return     true on success
+ */
+bool RFC_hcm_init( void *ctx, rfc_value_tuple_s *stack, size_t stack_cap, bool is_static )
+{
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( rfc_ctx->state != RFC_STATE_INIT )
+    {
+        return false;
+    }
+
+    if( stack_cap < 2 * (size_t)rfc_ctx->class_count + 1 )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( !stack )
+    {
+        if( is_static )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+        }
+
+        stack = (rfc_value_tuple_s*)ctx_mem_alloc( rfc_ctx, NULL, stack_cap, sizeof(rfc_value_tuple_s), RFC_MEM_AIM_HCM );
+
+        if( !stack )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+        }
+    }
+
+    /* Dispose the stack from RFC_init() */
+    if( rfc_ctx->internal.hcm.stack && !rfc_ctx->internal.hcm.stack_static )
+    {
+        ctx_mem_alloc( rfc_ctx, rfc_ctx->internal.hcm.stack, 0, 0, RFC_MEM_AIM_HCM );
+    }
+
+    rfc_ctx->internal.hcm.stack        = stack;
+    rfc_ctx->internal.hcm.stack_cap    = stack_cap;
+    rfc_ctx->internal.hcm.stack_static = is_static;
+    rfc_ctx->internal.hcm.IZ           = 0;
+    rfc_ctx->internal.hcm.IR           = 1;
+
+    return true;
+}
+#endif /*RFC_HCM_SUPPORT*/
+
+
 #if RFC_TP_SUPPORT
 /**
  * @brief      Initialize tp buffer
@@ -754,7 +941,7 @@ bool RFC_tp_init( void *ctx, rfc_value_tuple_s *tp, size_t tp_cap, bool is_stati
 
     if( !tp && tp_cap && !is_static )
     {
-        tp = (rfc_value_tuple_s*)rfc_ctx->mem_alloc( tp, tp_cap, sizeof(rfc_value_tuple_s), RFC_MEM_AIM_TP );
+        tp = (rfc_value_tuple_s*)ctx_mem_alloc( rfc_ctx, tp, tp_cap, sizeof(rfc_value_tuple_s), RFC_MEM_AIM_TP );
 
         if( !tp )
         {
@@ -819,12 +1006,18 @@ bool RFC_tp_prune( void *ctx, size_t limit, rfc_flags_e flags )
     }
 
 #if RFC_DH_SUPPORT
-    if( rfc_ctx->dh )
+    if( rfc_ctx->dh || rfc_ctx->dh_sparse )
     {
         return error_raise( rfc_ctx, RFC_ERROR_UNSUPPORTED );
     }
 #endif /*RFC_DH_SUPPORT*/
 
+    /* Settle a pending incremental compaction first, see tp_prune_inc_start() */
+    if( rfc_ctx->internal.tp_prune_removal )
+    {
+        tp_prune_inc_step( rfc_ctx, (size_t)-1 );
+    }
+
     if( rfc_ctx->tp_cnt > limit )
     {
         rfc_value_tuple_s   *src_beg_it,    /* Source (begin) (tp) */
@@ -841,6 +1034,10 @@ bool RFC_tp_prune( void *ctx, size_t limit, rfc_flags_e flags )
         bool                 preserve_pos;  /* Don't justify position */
         bool                 preserve_res;  /* Don't remove turning points, if referenced by residue */
 
+#if RFC_STATS_SUPPORT
+        rfc_ctx->internal.stats.tp_prunes++;
+#endif /*RFC_STATS_SUPPORT*/
+
         removal     = rfc_ctx->tp_cnt - limit;
         dst_it      = rfc_ctx->tp;
         dst_i       = 0;
@@ -999,7 +1196,9 @@ bool RFC_tp_clear( void *ctx )
         return false;
     }
 
-    rfc_ctx->tp_cnt = 0;
+    rfc_ctx->tp_cnt                    = 0;
+    rfc_ctx->internal.tp_prune_removal = 0;
+    rfc_ctx->internal.tp_prune_moved   = 0;
 
     for( i = 0; i < rfc_ctx->residue_cnt; i++ )
     {
@@ -1012,6 +1211,58 @@ bool RFC_tp_clear( void *ctx )
 #endif /*RFC_TP_SUPPORT*/
 
 
+#if RFC_STATS_SUPPORT
+/**
+ * @brief      Returns a copy of the hot path statistics
+ *
+ * @param      ctx    The rainflow context
+ * @param[out] stats  The statistics
+ *
+ * @return     true on success
+ */
+bool RFC_stats_get( const void *ctx, rfc_stats_s *stats )
+{
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( rfc_ctx->state < RFC_STATE_INIT )
+    {
+        return false;
+    }
+
+    if( !stats )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    *stats = rfc_ctx->internal.stats;
+
+    return true;
+}
+
+
+/**
+ * @brief      Reset the hot path statistics, countings are left untouched
+ *
+ * @param      ctx   The rainflow context
+ *
+ * @return     true on success
+ */
+bool RFC_stats_reset( void *ctx )
+{
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( rfc_ctx->state < RFC_STATE_INIT )
+    {
+        return false;
+    }
+
+    memset( &rfc_ctx->internal.stats, 0, sizeof( rfc_ctx->internal.stats ) );
+
+    return true;
+}
+#endif /*RFC_STATS_SUPPORT*/
+
+
 /**
  * @brief      Returns the residuum
  *
@@ -1067,7 +1318,7 @@ bool RFC_dh_init( void *ctx, rfc_sd_method_e method, double *dh, size_t dh_cap,
 
     if( !dh && dh_cap && !is_static )
     {
-        dh = (double*)rfc_ctx->mem_alloc( NULL, dh_cap, sizeof(double), RFC_MEM_AIM_DH );
+        dh = (double*)ctx_mem_alloc( rfc_ctx, NULL, dh_cap, sizeof(double), RFC_MEM_AIM_DH );
 
         if( !dh )
         {
@@ -1092,6 +1343,60 @@ bool RFC_dh_init( void *ctx, rfc_sd_method_e method, double *dh, size_t dh_cap,
 }
 
 
+/**
+ * @brief      Initialize sparse damage history storage
+ *
+ *             Alternative to RFC_dh_init(): damage only accrues where cycles
+ *             close, so a dense history is dominated by runs of zeros. The
+ *             sparse storage holds one (position, damage) item per affected
+ *             sample instead of one double per input sample and is queried
+ *             with RFC_dh_window_damage().
+ *             The methods RFC_SD_TRANSIENT_23 and RFC_SD_TRANSIENT_23c write
+ *             the history densely and demand RFC_dh_init().
+ *
+ * @param      ctx        The rainflow context
+ * @param[in]  method     The mode, how to spread (RFC_SD_...)
+ * @param[in]  cap        Initial capacity in elements, 0 chooses a default
+ *
+ * @return     true on success
+ */
+bool RFC_dh_init_sparse( void *ctx, rfc_sd_method_e method, size_t cap )
+{
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( rfc_ctx->state != RFC_STATE_INIT )
+    {
+        return false;
+    }
+
+    if( rfc_ctx->dh || rfc_ctx->dh_sparse ||
+        method == RFC_SD_TRANSIENT_23 || method == RFC_SD_TRANSIENT_23c )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( !cap )
+    {
+        cap = 512;
+    }
+
+    rfc_ctx->dh_sparse = (rfc_dh_item_s*)ctx_mem_alloc( rfc_ctx, NULL, cap, sizeof(rfc_dh_item_s), RFC_MEM_AIM_DH );
+
+    if( !rfc_ctx->dh_sparse )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+    }
+
+    rfc_ctx->spread_damage_method = method;
+    rfc_ctx->dh_istream           = (const rfc_value_t*)NULL;
+    rfc_ctx->dh_sparse_cap        = cap;
+    rfc_ctx->dh_sparse_cnt        = 0;
+    rfc_ctx->dh_cnt               = 0;
+
+    return true;
+}
+
+
 /**
  * @brief      Get damage history storage
  *
@@ -1115,6 +1420,77 @@ bool RFC_dh_get( const void *ctx, const double **dh, size_t *count )
 
     return true;
 }
+
+
+/**
+ * @brief      Sum the damage assigned to a window of the input stream
+ *
+ *             Works likewise on dense (RFC_dh_init()) and sparse
+ *             (RFC_dh_init_sparse()) damage history storage. The window is
+ *             given in stream positions, base 0, and is half open:
+ *             [pos_from, pos_to)
+ *
+ * @param      ctx        The rainflow context
+ * @param[in]  pos_from   First stream position included, base 0
+ * @param[in]  pos_to     First stream position beyond the window, base 0
+ * @param[out] damage     The damage sum over the window
+ *
+ * @return     true on success
+ */
+bool RFC_dh_window_damage( const void *ctx, size_t pos_from, size_t pos_to, double *damage )
+{
+    double D = 0.0;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( rfc_ctx->state < RFC_STATE_INIT || !damage )
+    {
+        return false;
+    }
+
+    if( rfc_ctx->dh )
+    {
+        size_t i;
+
+        if( pos_to > rfc_ctx->dh_cnt )
+        {
+            pos_to = rfc_ctx->dh_cnt;
+        }
+
+        for( i = pos_from; i < pos_to; i++ )
+        {
+            D += rfc_ctx->dh[i];
+        }
+    }
+    else if( rfc_ctx->dh_sparse )
+    {
+        /* Find the leftmost item with .pos >= pos_from, storage is ascending by .pos */
+        size_t lo = 0, hi = rfc_ctx->dh_sparse_cnt;
+
+        while( lo < hi )
+        {
+            size_t mid = lo + ( hi - lo ) / 2;
+
+            if( rfc_ctx->dh_sparse[mid].pos < pos_from )
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+
+        for( ; lo < rfc_ctx->dh_sparse_cnt && rfc_ctx->dh_sparse[lo].pos < pos_to; lo++ )
+        {
+            D += rfc_ctx->dh_sparse[lo].damage;
+        }
+    }
+
+    *damage = D;
+
+    return true;
+}
 #endif /*RFC_DH_SUPPORT*/
 
 
@@ -1250,10 +1626,100 @@ bool RFC_at_init( void *ctx, const double *Sa, const double *Sm, unsigned count,
     }
 
 #if RFC_DAMAGE_FAST
-    return damage_lut_init( rfc_ctx );
-#else /*!RFC_DAMAGE_FAST*/
-    return true;
+    if( !damage_lut_init( rfc_ctx ) )
+    {
+        return false;
+    }
 #endif /*RFC_DAMAGE_FAST*/
+
+    if( rfc_ctx->at_lut.grid && !at_lut_build( rfc_ctx ) )
+    {
+        /* Grid nodes reflect the former reference curve, rebuild */
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Set up a dense precomputed transform grid over the (Sa,Sm)
+ *             plane, sampled from the reference curve given to RFC_at_init().
+ *             With a grid attached, RFC_at_transform() replaces the piecewise
+ *             Haigh diagram interpolation by a bilinear look-up for any point
+ *             covered by the grid and only falls back to the exact calculation
+ *             outside. The grid is rebuilt automatically when RFC_at_init()
+ *             changes the reference curve.
+ *
+ * @param      ctx           The rainflow context
+ * @param      Sa_max        Upper amplitude bound, the grid covers [0, Sa_max]
+ * @param      Sm_min        Lower mean load bound
+ * @param      Sm_max        Upper mean load bound. If Sa_max, Sm_min and
+ *                           Sm_max are all zero, bounds are derived from the
+ *                           class parameters (class_count required then)
+ * @param      Sa_divisions  Number of grid cells along the amplitude axis,
+ *                           0 for default (128)
+ * @param      Sm_divisions  Number of grid cells along the mean load axis,
+ *                           0 for default (128)
+ *
+ * @return     true on success
+ */
+bool RFC_at_lut_init( void *ctx, double Sa_max, double Sm_min, double Sm_max,
+                                 unsigned Sa_divisions, unsigned Sm_divisions )
+{
+    size_t node_count;
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( rfc_ctx->state < RFC_STATE_INIT )
+    {
+        return false;
+    }
+
+    if( !Sa_divisions ) Sa_divisions = 128;
+    if( !Sm_divisions ) Sm_divisions = 128;
+
+    if( Sa_max == 0.0 && Sm_min == 0.0 && Sm_max == 0.0 )
+    {
+        /* Derive grid bounds from class parameters */
+        if( !rfc_ctx->class_count )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+        }
+
+        Sa_max = (double)rfc_ctx->class_width * rfc_ctx->class_count / 2;
+        Sm_min = (double)rfc_ctx->class_offset;
+        Sm_max = Sm_min + (double)rfc_ctx->class_width * rfc_ctx->class_count;
+    }
+
+    if( Sa_max <= 0.0 || Sm_min >= Sm_max )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( rfc_ctx->at_lut.grid )
+    {
+        ctx_mem_alloc( rfc_ctx, rfc_ctx->at_lut.grid, 0, 0, RFC_MEM_AIM_ALUT );
+        rfc_ctx->at_lut.grid = NULL;
+    }
+
+    node_count = (size_t)( Sa_divisions + 1 ) * ( Sm_divisions + 1 );
+
+    rfc_ctx->at_lut.grid = (double*)ctx_mem_alloc( rfc_ctx, NULL, node_count, sizeof(double), RFC_MEM_AIM_ALUT );
+
+    if( !rfc_ctx->at_lut.grid )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+    }
+
+    rfc_ctx->at_lut.sa_divisions = Sa_divisions;
+    rfc_ctx->at_lut.sm_divisions = Sm_divisions;
+    rfc_ctx->at_lut.sa_max       = Sa_max;
+    rfc_ctx->at_lut.sm_min       = Sm_min;
+    rfc_ctx->at_lut.sm_max       = Sm_max;
+    rfc_ctx->at_lut.sa_scale     = Sa_divisions / Sa_max;
+    rfc_ctx->at_lut.sm_scale     = Sm_divisions / ( Sm_max - Sm_min );
+
+    return at_lut_build( rfc_ctx );
 }
 #endif /*RFC_AT_SUPPORT*/
 
@@ -1279,6 +1745,17 @@ bool RFC_clear_counts( void *ctx )
         memset( rfc_ctx->rfm, 0, sizeof(rfc_counts_t) * rfc_ctx->class_count * rfc_ctx->class_count );
     }
 
+    if( rfc_ctx->rfm_sparse )
+    {
+        size_t i;
+
+        for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
+        {
+            rfc_ctx->rfm_sparse[i].from = (unsigned)-1;
+        }
+        rfc_ctx->rfm_sparse_cnt = 0;
+    }
+
     if( rfc_ctx->rp )
     {
         memset( rfc_ctx->rp, 0, sizeof(rfc_counts_t) * rfc_ctx->class_count );
@@ -1289,17 +1766,40 @@ bool RFC_clear_counts( void *ctx )
         memset( rfc_ctx->lc, 0, sizeof(rfc_counts_t) * rfc_ctx->class_count );
     }
 
-    rfc_ctx->residue_cnt                = 0;
+    /* Clearing modifies every bin, delta readers resync completely */
+    if( rfc_ctx->rp_bin_version )
+    {
+        unsigned i;
 
-    rfc_ctx->internal.slope             = 0;
-    rfc_ctx->internal.extrema[0]        = nil;  /* local minimum */
-    rfc_ctx->internal.extrema[1]        = nil;  /* local maximum */
-#if RFC_GLOBAL_EXTREMA
-    rfc_ctx->internal.extrema_changed   = false;
-#endif
-    rfc_ctx->internal.pos               = 0;
-    rfc_ctx->internal.pos_offset        = 0;
-    
+        rfc_ctx->rp_version++;
+        for( i = 0; i < rfc_ctx->class_count; i++ )
+        {
+            rfc_ctx->rp_bin_version[i] = rfc_ctx->rp_version;
+        }
+    }
+
+    if( rfc_ctx->lc_bin_version )
+    {
+        unsigned i;
+
+        rfc_ctx->lc_version++;
+        for( i = 0; i < rfc_ctx->class_count; i++ )
+        {
+            rfc_ctx->lc_bin_version[i] = rfc_ctx->lc_version;
+        }
+    }
+
+    rfc_ctx->residue_cnt                = 0;
+
+    rfc_ctx->internal.slope             = 0;
+    rfc_ctx->internal.extrema[0]        = nil;  /* local minimum */
+    rfc_ctx->internal.extrema[1]        = nil;  /* local maximum */
+#if RFC_GLOBAL_EXTREMA
+    rfc_ctx->internal.extrema_changed   = false;
+#endif
+    rfc_ctx->internal.pos               = 0;
+    rfc_ctx->internal.pos_offset        = 0;
+    
     rfc_ctx->damage                     = 0.0;
     rfc_ctx->damage_residue             = 0.0;
 
@@ -1316,6 +1816,8 @@ bool RFC_clear_counts( void *ctx )
     rfc_ctx->internal.margin_stage      = 0;
     rfc_ctx->tp_cnt                     = 0;
     rfc_ctx->tp_locked                  = 0;
+    rfc_ctx->internal.tp_prune_removal  = 0;
+    rfc_ctx->internal.tp_prune_moved    = 0;
 #endif /*RFC_TP_SUPPORT*/
 
 #if RFC_DH_SUPPORT
@@ -1340,6 +1842,65 @@ bool RFC_clear_counts( void *ctx )
 
     return true;
 }
+
+
+/**
+ * @brief      Attach a built-in arena allocator. All internal allocations
+ *             (residue, histograms, look-up tables, turning points, scratch
+ *             buffers) are served from one contiguous slab with bump
+ *             allocation, avoiding heap locking and fragmentation with many
+ *             contexts per process. Must be called before RFC_init(), which
+ *             does the first allocations. Individual frees just rest in the
+ *             slab, RFC_deinit() releases it wholesale; blocks exceeding the
+ *             slab fall back to the heap transparently. Buffers handed out
+ *             by the context (e.g. RFC_rfm_get()) stay valid until
+ *             RFC_deinit() and are released through .mem_alloc as usual.
+ *             Not combinable with a custom allocation functor.
+ *
+ * @param      ctx   The rainflow context (before RFC_init())
+ * @param      size  The slab size in bytes
+ *
+ * @return     true on success
+ */
+bool RFC_mem_arena_init( void *ctx, size_t size )
+{
+    rfc_mem_arena_s *arena;
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( rfc_ctx->state != RFC_STATE_INIT0 )
+    {
+        return false;
+    }
+
+    if( !size )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( rfc_ctx->mem_alloc && rfc_ctx->mem_alloc != mem_alloc )
+    {
+        /* A custom allocation functor is attached already */
+        return error_raise( rfc_ctx, RFC_ERROR_UNSUPPORTED );
+    }
+
+    size  = MEM_ARENA_ALIGN( size );
+    arena = (rfc_mem_arena_s*)CALLOC( 1, sizeof(rfc_mem_arena_s) + size );
+
+    if( !arena )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+    }
+
+    arena->slab             = (unsigned char*)( arena + 1 );
+    arena->size             = size;
+    arena->offset           = 0;
+    arena->last             = NULL;
+
+    rfc_ctx->internal.arena = arena;
+    rfc_ctx->mem_alloc      = mem_alloc_arena;
+
+    return true;
+}
 #endif /*!RFC_MINIMAL*/
 
 
@@ -1361,34 +1922,53 @@ bool RFC_deinit( void *ctx )
     }
 
     if( !rfc_ctx->internal.res_static &&
-        rfc_ctx->residue )              rfc_ctx->mem_alloc( rfc_ctx->residue,       0, 0, RFC_MEM_AIM_RESIDUE );
-    if( rfc_ctx->rfm )                  rfc_ctx->mem_alloc( rfc_ctx->rfm,           0, 0, RFC_MEM_AIM_MATRIX );
+        rfc_ctx->residue )              ctx_mem_alloc( rfc_ctx, rfc_ctx->residue,       0, 0, RFC_MEM_AIM_RESIDUE );
+    if( rfc_ctx->rfm )                  ctx_mem_alloc( rfc_ctx, rfc_ctx->rfm,           0, 0, RFC_MEM_AIM_MATRIX );
 #if RFC_DAMAGE_FAST
-    if( rfc_ctx->damage_lut )           rfc_ctx->mem_alloc( rfc_ctx->damage_lut,    0, 0, RFC_MEM_AIM_DLUT );
+    if( rfc_ctx->damage_lut_refcnt && --(*rfc_ctx->damage_lut_refcnt) > 0 )
+    {
+        /* Look-up tables are shared and still referenced elsewhere, just let go */
+        rfc_ctx->damage_lut             =   NULL;
+        rfc_ctx->damage_lut_row_valid   =   NULL;
+        rfc_ctx->damage_lut_refcnt      =   NULL;
+#if RFC_AT_SUPPORT
+        rfc_ctx->amplitude_lut          =   NULL;
+#endif /*RFC_AT_SUPPORT*/
+    }
+    if( rfc_ctx->damage_lut_refcnt )    ctx_mem_alloc( rfc_ctx, rfc_ctx->damage_lut_refcnt,    0, 0, RFC_MEM_AIM_DLUT );
+    if( rfc_ctx->damage_lut )           ctx_mem_alloc( rfc_ctx, rfc_ctx->damage_lut,           0, 0, RFC_MEM_AIM_DLUT );
+    if( rfc_ctx->damage_lut_row_valid ) ctx_mem_alloc( rfc_ctx, rfc_ctx->damage_lut_row_valid, 0, 0, RFC_MEM_AIM_DLUT );
 #if RFC_AT_SUPPORT
-    if( rfc_ctx->amplitude_lut )        rfc_ctx->mem_alloc( rfc_ctx->amplitude_lut, 0, 0, RFC_MEM_AIM_ALUT );
+    if( rfc_ctx->amplitude_lut )        ctx_mem_alloc( rfc_ctx, rfc_ctx->amplitude_lut,        0, 0, RFC_MEM_AIM_ALUT );
 #endif /*RFC_AT_SUPPORT*/
 #endif /*RFC_DAMAGE_FAST*/
 #if !RFC_MINIMAL
-    if( rfc_ctx->rp )                   rfc_ctx->mem_alloc( rfc_ctx->rp,            0, 0, RFC_MEM_AIM_RP );
-    if( rfc_ctx->lc )                   rfc_ctx->mem_alloc( rfc_ctx->lc,            0, 0, RFC_MEM_AIM_LC );
+    if( rfc_ctx->rfm_sparse )           ctx_mem_alloc( rfc_ctx, rfc_ctx->rfm_sparse,    0, 0, RFC_MEM_AIM_RFM_ELEMENTS );
+    if( rfc_ctx->rp )                   ctx_mem_alloc( rfc_ctx, rfc_ctx->rp,            0, 0, RFC_MEM_AIM_RP );
+    if( rfc_ctx->lc )                   ctx_mem_alloc( rfc_ctx, rfc_ctx->lc,            0, 0, RFC_MEM_AIM_LC );
+    if( rfc_ctx->rp_bin_version )       ctx_mem_alloc( rfc_ctx, rfc_ctx->rp_bin_version, 0, 0, RFC_MEM_AIM_RP );
+    if( rfc_ctx->lc_bin_version )       ctx_mem_alloc( rfc_ctx, rfc_ctx->lc_bin_version, 0, 0, RFC_MEM_AIM_LC );
+    if( rfc_ctx->followers )            ctx_mem_alloc( rfc_ctx, rfc_ctx->followers,     0, 0, RFC_MEM_AIM_TEMP );
 #endif /*!RFC_MINIMAL*/
 #if RFC_TP_SUPPORT
     if( rfc_ctx->tp && !rfc_ctx->internal.tp_static )
     {
-                                        rfc_ctx->mem_alloc( rfc_ctx->tp,            0, 0, RFC_MEM_AIM_TP );
+                                        ctx_mem_alloc( rfc_ctx, rfc_ctx->tp,            0, 0, RFC_MEM_AIM_TP );
     }           
 #endif /*RFC_TP_SUPPORT*/
 #if RFC_DH_SUPPORT
+    if( rfc_ctx->dh_sparse )            ctx_mem_alloc( rfc_ctx, rfc_ctx->dh_sparse,     0, 0, RFC_MEM_AIM_DH );
     if( rfc_ctx->dh && !rfc_ctx->internal.dh_static )
     {               
-                                        rfc_ctx->mem_alloc( rfc_ctx->dh,            0, 0, RFC_MEM_AIM_DH );
+                                        ctx_mem_alloc( rfc_ctx, rfc_ctx->dh,            0, 0, RFC_MEM_AIM_DH );
     }
 #endif /*RFC_DH_SUPPORT*/
 
 #if RFC_DAMAGE_FAST
     rfc_ctx->damage_lut                 = NULL;
     rfc_ctx->damage_lut_inapt           = 1;
+    rfc_ctx->damage_lut_row_valid       = NULL;
+    rfc_ctx->damage_lut_refcnt          = NULL;
 #if RFC_AT_SUPPORT
     rfc_ctx->amplitude_lut              = NULL;
 #endif /*RFC_AT_SUPPORT*/
@@ -1400,8 +1980,19 @@ bool RFC_deinit( void *ctx )
 
     rfc_ctx->rfm                        = NULL;
 #if !RFC_MINIMAL
+    rfc_ctx->rfm_sparse                 = NULL;
+    rfc_ctx->rfm_sparse_cap             = 0;
+    rfc_ctx->rfm_sparse_cnt             = 0;
     rfc_ctx->rp                         = NULL;
     rfc_ctx->lc                         = NULL;
+    rfc_ctx->rp_bin_version             = NULL;
+    rfc_ctx->lc_bin_version             = NULL;
+    rfc_ctx->rp_version                 = 0;
+    rfc_ctx->lc_version                 = 0;
+    rfc_ctx->followers                  = NULL;
+    rfc_ctx->follower_cnt               = 0;
+    rfc_ctx->follower_cap               = 0;
+    rfc_ctx->internal.ring              = NULL;
 #endif /*!RFC_MINIMAL*/
     
     rfc_ctx->internal.slope             = 0;
@@ -1422,16 +2013,23 @@ bool RFC_deinit( void *ctx )
     rfc_ctx->tp_cnt                     = 0;
     rfc_ctx->tp_locked                  = 0;
     rfc_ctx->internal.tp_static         = false;
+    rfc_ctx->internal.tp_prune_removal  = 0;
+    rfc_ctx->internal.tp_prune_moved    = 0;
 #endif /*RFC_TP_SUPPORT*/
 
 #if RFC_DH_SUPPORT
     rfc_ctx->dh                         = NULL;
     rfc_ctx->dh_cap                     = 0;
     rfc_ctx->dh_cnt                     = 0;
+    rfc_ctx->dh_sparse                  = NULL;
+    rfc_ctx->dh_sparse_cap              = 0;
+    rfc_ctx->dh_sparse_cnt              = 0;
     rfc_ctx->internal.dh_static         = false;
 #endif /*RFC_DH_SUPPORT*/
 
 #if RFC_AT_SUPPORT
+    if( rfc_ctx->at_lut.grid )          ctx_mem_alloc( rfc_ctx, rfc_ctx->at_lut.grid,    0, 0, RFC_MEM_AIM_ALUT );
+
     rfc_ctx->at.Sa                      = NULL;
     rfc_ctx->at.Sm                      = NULL;
     rfc_ctx->at.count                   = 0;
@@ -1440,21 +2038,44 @@ bool RFC_deinit( void *ctx )
     rfc_ctx->at.R_rig                   = 0.0;
     rfc_ctx->at.R_pinned                = false;
 
+    rfc_ctx->at_lut.grid                = NULL;
+    rfc_ctx->at_lut.sa_divisions        = 0;
+    rfc_ctx->at_lut.sm_divisions        = 0;
+    rfc_ctx->at_lut.sa_max              = 0.0;
+    rfc_ctx->at_lut.sm_min              = 0.0;
+    rfc_ctx->at_lut.sm_max              = 0.0;
+    rfc_ctx->at_lut.sa_scale            = 0.0;
+    rfc_ctx->at_lut.sm_scale            = 0.0;
+
     rfc_ctx->internal.at_haigh.count    = 0;
 #endif /*RFC_AT_SUPPORT*/
 
 #if RFC_HCM_SUPPORT
     /* Remove stack */
-    if( rfc_ctx->internal.hcm.stack )   rfc_ctx->mem_alloc( rfc_ctx->internal.hcm.stack, 0, 0, RFC_MEM_AIM_HCM );
+    if( rfc_ctx->internal.hcm.stack && !rfc_ctx->internal.hcm.stack_static )
+    {
+                                        ctx_mem_alloc( rfc_ctx, rfc_ctx->internal.hcm.stack, 0, 0, RFC_MEM_AIM_HCM );
+    }
 
     rfc_ctx->internal.hcm.stack         = NULL;
     rfc_ctx->internal.hcm.stack_cap     = 0;
+    rfc_ctx->internal.hcm.stack_static  = false;
 
     /* Stack pointers */
     rfc_ctx->internal.hcm.IZ            = 0;
     rfc_ctx->internal.hcm.IR            = 1;
 #endif /*RFC_HCM_SUPPORT*/
 
+#if !RFC_MINIMAL
+    if( rfc_ctx->internal.arena )
+    {
+        /* All context owned storages are released, drop the slab wholesale */
+        FREE( rfc_ctx->internal.arena );
+        rfc_ctx->internal.arena         = NULL;
+        rfc_ctx->mem_alloc              = mem_alloc;
+    }
+#endif /*!RFC_MINIMAL*/
+
     rfc_ctx->state = RFC_STATE_INIT0;
 
     return true;
@@ -1522,8 +2143,40 @@ bool RFC_feed( void *ctx, const rfc_value_t * data, size_t data_count )
             }
 #endif /*RFC_AR_SUPPORT*/
         }
-        
+
         if( !feed_once( rfc_ctx, &tp, rfc_ctx->internal.flags ) ) return false;
+
+#if RFC_USE_HYSTERESIS_FILTER
+        /* Without RFC_USE_HYSTERESIS_FILTER, value_delta() works on quantized
+           classes and the interim turning point retained for a run depends on
+           which of its same-class samples is seen last, so every sample must
+           pass through */
+#if RFC_USE_DELEGATES
+        /* A delegated turning point filter may rely on seeing every sample */
+        if( !rfc_ctx->tp_next_fcn )
+#endif /*RFC_USE_DELEGATES*/
+        {
+            /* Peak-valley prefilter: samples lying strictly in between their
+               neighbors can never become turning points, feed_once() would
+               merely drag the interim turning point along the slope. Skip over
+               monotone runs and present their last point only. The first and
+               last sample of each block and plateau values always pass through.
+               Skipped samples are implicitly covered by the range check on the
+               run's end point, which is always the most extreme value of the run. */
+            while( data_count > 1 &&
+                   ( ( data[0] > data[-1] && data[1] > data[0] ) ||
+                     ( data[0] < data[-1] && data[1] < data[0] ) ) )
+            {
+                data++;
+                data_count--;
+                rfc_ctx->internal.pos++;
+#if RFC_STATS_SUPPORT
+                /* Skipped samples are consumed input samples nonetheless */
+                rfc_ctx->internal.stats.samples_fed++;
+#endif /*RFC_STATS_SUPPORT*/
+            }
+        }
+#endif /*RFC_USE_HYSTERESIS_FILTER*/
     }
 
     return true;
@@ -1656,239 +2309,2942 @@ bool RFC_feed_tuple( void *ctx, rfc_value_tuple_s *data, size_t data_count )
 
     return true;
 }
-#endif /*!RFC_MINIMAL*/
 
 
+/* Cross-thread index accesses for the feed ring. Acquire/release ordering
+   keeps sample stores and index publishing in order between exactly one
+   producer and one consumer thread. Without compiler support for atomics,
+   volatile accesses remain, which suffices on strongly ordered targets
+   (x86/x64), where aligned size_t accesses are atomic. */
+#if defined(__GNUC__) || defined(__clang__)
+#define RING_INDEX_LOAD( P )        __atomic_load_n( (P), __ATOMIC_ACQUIRE )
+#define RING_INDEX_STORE( P, V )    __atomic_store_n( (P), (V), __ATOMIC_RELEASE )
+#else
+#define RING_INDEX_LOAD( P )        ( *(P) )
+#define RING_INDEX_STORE( P, V )    ( *(P) = (V) )
+#endif
+
 /**
- * @brief      Finalize pending counts and turning point storage.
+ * @brief         Attach a lock-free ring buffer as feed frontend. One data
+ *                acquisition thread publishes raw samples wait-free via
+ *                RFC_feed_ring_push(), a worker thread forwards them into
+ *                the counting via RFC_feed_ring_drain(). Ring structure and
+ *                sample storage are caller owned (may be statically
+ *                allocated) and must outlive the attachment. One buffer slot
+ *                remains unused, so capacity-1 samples fit at most.
+ *                The damage history input stream (see RFC_dh_init()) demands
+ *                one contiguous stream and cannot be combined with the ring.
  *
- * @param      ctx              The rainflow context
- * @param      residual_method  The residual method (RFC_RES_...)
+ * @param         ctx         The rainflow context
+ * @param[in,out] ring        The ring structure (caller owned)
+ * @param[in]     buffer      Sample storage with given capacity (caller owned)
+ * @param         capacity    Buffer capacity in number of samples, at least 2
  *
- * @return     true on success
+ * @return        true on success
  */
-bool RFC_finalize( void *ctx, rfc_res_method_e residual_method )
+bool RFC_feed_ring_attach( void *ctx, rfc_ring_buffer_s *ring, rfc_value_t *buffer, size_t capacity )
 {
-    double damage;
-    bool ok;
     RFC_CTX_CHECK_AND_ASSIGN
-    
-    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state >= RFC_STATE_FINISHED )
-    {
-        return false;
-    }
-
-#if _DEBUG
-    rfc_ctx->internal.finalizing = true;
-#endif /*_DEBUG*/
-
-    damage = rfc_ctx->damage;
 
-#if RFC_USE_DELEGATES
-    if( rfc_ctx->finalize_fcn )
-    {
-        ok = rfc_ctx->finalize_fcn( rfc_ctx, residual_method );
-    }
-    else
-#endif /*RFC_USE_DELEGATES*/
+    if( rfc_ctx->state != RFC_STATE_INIT )
     {
-        int flags = rfc_ctx->internal.flags;
-
-#if !RFC_MINIMAL
-        /* Level crossing counting is already considered for residue */
-        flags &= ~RFC_FLAGS_COUNT_LC;
-#endif /*!RFC_MINIMAL*/
-
-        switch( residual_method )
-        {
-            case RFC_RES_NONE:
-                /* FALLTHROUGH */
-            case RFC_RES_IGNORE:
-                ok = finalize_res_ignore( rfc_ctx, flags );
-                break;
-            case RFC_RES_NO_FINALIZE:
-                ok = finalize_res_no_finalize( rfc_ctx, flags );
-                break;
-#if !RFC_MINIMAL
-            case RFC_RES_DISCARD:
-                ok = finalize_res_discard( rfc_ctx, flags );
-                break;
-            case RFC_RES_HALFCYCLES:
-                ok = finalize_res_weight_cycles( rfc_ctx, rfc_ctx->half_inc, flags );
-                break;
-            case RFC_RES_FULLCYCLES:
-                ok = finalize_res_weight_cycles( rfc_ctx, rfc_ctx->full_inc, flags );
-                break;
-            case RFC_RES_CLORMANN_SEEGER:
-                ok = finalize_res_clormann_seeger( rfc_ctx, flags );
-                break;
-            case RFC_RES_REPEATED:
-                ok = finalize_res_repeated( rfc_ctx, flags );
-                break;
-            case RFC_RES_RP_DIN45667:
-                ok = finalize_res_rp_DIN45667( rfc_ctx, flags );
-                break;
-#endif /*!RFC_MINIMAL*/
-            default:
-                assert( false );
-                ok = error_raise( rfc_ctx, RFC_ERROR_INVARG );
-        }
-        assert( rfc_ctx->state == RFC_STATE_FINALIZE );
+        return false;
     }
 
-#if !RFC_MINIMAL
-    if( rfc_ctx->counting_method == RFC_COUNTING_METHOD_NONE || !rfc_ctx->class_count )
-    {
-#else /*RFC_MINIMAL*/
-    if( !rfc_ctx->class_count )
+    if( !ring || !buffer || capacity < 2 )
     {
-#endif /*!RFC_MINIMAL*/
-        rfc_ctx->residue_cnt = 0;
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
     }
 
-    rfc_ctx->damage_residue = rfc_ctx->damage - damage;
-    rfc_ctx->state          = ok ? RFC_STATE_FINISHED : RFC_STATE_ERROR;
-
-#if _DEBUG
-    rfc_ctx->internal.finalizing = false;
-#endif /*_DEBUG*/
-
 #if RFC_DH_SUPPORT
-    if( ok )
+    if( rfc_ctx->dh || rfc_ctx->dh_sparse )
     {
-        ok = spread_damage_map_tp( rfc_ctx );
+        return error_raise( rfc_ctx, RFC_ERROR_UNSUPPORTED );
     }
 #endif /*RFC_DH_SUPPORT*/
 
-    return ok;
+    ring->buffer            = buffer;
+    ring->capacity          = capacity;
+    ring->head              = 0;
+    ring->tail              = 0;
+
+    rfc_ctx->internal.ring  = ring;
+
+    return true;
 }
 
 
-#if !RFC_MINIMAL
 /**
- * @brief      Make rainflow matrix symmetrical
+ * @brief         Publish samples to the ring, wait-free producer side.
+ *                Must be called from one single thread, doesn't touch the
+ *                rainflow context. All samples are stored or none: if less
+ *                than count slots are free, the call returns false and the
+ *                caller decides (retry, drop, count overrun).
  *
- * @param      ctx   The rainflow context
+ * @param[in,out] ring        The ring structure, see RFC_feed_ring_attach()
+ * @param[in]     data        The data samples
+ * @param         count       The data count
  *
- * @return     true on success
+ * @return        true, if all samples have been stored
  */
-bool RFC_rfm_make_symmetric( void *ctx )
+bool RFC_feed_ring_push( rfc_ring_buffer_s *ring, const rfc_value_t *data, size_t count )
 {
-    unsigned       class_count;
-    unsigned       from, to;
-    rfc_counts_t  *rfm;
+    size_t head, free_cnt, i;
 
-    RFC_CTX_CHECK_AND_ASSIGN
-    
-    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+    if( !ring || !ring->buffer )
     {
         return false;
     }
 
-    rfm = rfc_ctx->rfm;
+    if( !data ) return !count;
 
-    if( !rfm )
+    head     = ring->head;  /* Owned by the producer */
+    free_cnt = ( RING_INDEX_LOAD( &ring->tail ) + ring->capacity - head - 1 ) % ring->capacity;
+
+    if( count > free_cnt )
     {
         return false;
     }
 
-    class_count = rfc_ctx->class_count;
-
-    /* Cumulate entries symmetric by major diagonal */
-    for( from = 0; from < class_count; from++ )
+    for( i = 0; i < count; i++ )
     {
-        for( to = from + 1; to < class_count; to++ )
-        {
-            /* to > from, always */
-            rfm[ MAT_OFFS( from, to ) ] += rfm[ MAT_OFFS( to, from ) ];
-            rfm[ MAT_OFFS( to, from ) ]  = 0;
-        }
+        ring->buffer[ ( head + i ) % ring->capacity ] = data[i];
     }
 
+    /* Publish the samples after they are stored */
+    RING_INDEX_STORE( &ring->head, ( head + count ) % ring->capacity );
+
     return true;
 }
 
 
 /**
- * @brief      Returns the number of non zero entries in rainflow matrix
+ * @brief         Drain the attached ring into the counting, consumer side.
+ *                Forwards all samples published so far in (at most two)
+ *                contiguous batches to RFC_feed() and releases their slots.
+ *                Returns with true once the ring is empty; samples published
+ *                concurrently whilst draining are picked up on the next call.
  *
- * @param[in]  ctx   The rainflow context
+ * @param         ctx         The rainflow context
+ * @param[out]    count       Number of samples drained (optional, may be NULL)
  *
- * @return     true on success
+ * @return        true on success
  */
-bool RFC_rfm_non_zeros( const void *ctx, unsigned *count )
+bool RFC_feed_ring_drain( void *ctx, size_t *count )
 {
-    unsigned            class_count;
-    unsigned            from, to;
-    rfc_counts_t       *rfm_it;
-
+    rfc_ring_buffer_s *ring;
+    size_t             head, tail, drained = 0;
     RFC_CTX_CHECK_AND_ASSIGN
 
-    if( !count )
+    ring = rfc_ctx->internal.ring;
+
+    if( !ring )
     {
         return error_raise( rfc_ctx, RFC_ERROR_INVARG );
     }
-    
-    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
-    {
-        return false;
-    }
 
-    class_count = rfc_ctx->class_count;
-
-    rfm_it = rfc_ctx->rfm;
+    /* Snapshot the write index, the producer may advance it concurrently */
+    head = RING_INDEX_LOAD( &ring->head );
+    tail = ring->tail;  /* Owned by the consumer */
 
-    if( !rfm_it || !class_count )
+    while( tail != head )
     {
-        return false;
-    }
+        size_t batch = ( head > tail ) ? ( head - tail ) : ( ring->capacity - tail );
 
-    *count = 0;
-    for( from = 0; from < class_count; from++ )
-    {
-        for( to = 0; to < class_count; to++ )
+        if( !RFC_feed( rfc_ctx, ring->buffer + tail, batch ) )
         {
-            if( *rfm_it++ ) (*count)++;
+            /* Keep unfed samples in the ring */
+            if( count ) *count = drained;
+
+            return false;
         }
+
+        tail       = ( tail + batch ) % ring->capacity;
+        drained   += batch;
+
+        /* Release the slots not before their samples are fed */
+        RING_INDEX_STORE( &ring->tail, tail );
     }
 
+    if( count ) *count = drained;
+
     return true;
 }
 
 
 /**
- * @brief      Get the rainflow matrix as sparse elements
- *
- * @param      ctx     The rainflow context
- * @param[out] buffer  The elements buffer, if NULL memory will be allocated
- * @param[out] count   The number of elements in buffer
+ * @brief         Merge the counting results of a second context (map-reduce).
+ *                Both contexts must share identical class parameters. Histograms
+ *                (rfm, rp, lc) and damage are accumulated, then the residue of
+ *                the source context is fed across the seam, so cycles spanning
+ *                both parts close as if the data had been counted in one pass.
+ *                Level crossing is counted for the seam slopes only, the parts
+ *                have already considered their own slopes; crossings may deviate
+ *                by single counts, if the seam cuts an oscillation below the
+ *                hysteresis. Cycles closing near the seam may appear transposed
+ *                in the rainflow matrix (standing vs. hanging), amplitude and
+ *                mean are retained. Turning points and damage history of the
+ *                source context are not transferred.
+ *
+ * @param         ctx         The rainflow context (destination)
+ * @param[in]     ctx_src     The rainflow context merged into ctx (left intact)
  *
- * @return     true on success
- * @note       The counts are natively returned, regardless of .full_inc!
-*/
-bool RFC_rfm_get( const void *ctx, rfc_rfm_item_s **buffer, unsigned *count )
+ * @return        true on success
+ */
+bool RFC_ctx_merge( void *ctx, const void *ctx_src )
 {
-    unsigned            class_count;
-    unsigned            from, to;
-    unsigned            count_old;
-    rfc_counts_t       *rfm_it;
-    rfc_rfm_item_s     *item;
-
+    const rfc_ctx_s *src = (const rfc_ctx_s*)ctx_src;
+    size_t           pos_end, residue_cnt, i;
+    int              flags;
+    bool             first_tp_pending;
     RFC_CTX_CHECK_AND_ASSIGN
 
-    if( !buffer || !count )
+    if( !src || src->version != sizeof( rfc_ctx_s ) )
     {
         return error_raise( rfc_ctx, RFC_ERROR_INVARG );
     }
-    
-    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state >= RFC_STATE_FINISHED ||
+            src->state < RFC_STATE_INIT ||     src->state >= RFC_STATE_FINISHED )
     {
         return false;
     }
 
-    class_count = rfc_ctx->class_count;
-
-    rfm_it = rfc_ctx->rfm;
+    /* Class parameters and counting increments must match */
+    if( rfc_ctx->class_count  != src->class_count  ||
+        rfc_ctx->class_width  != src->class_width  ||
+        rfc_ctx->class_offset != src->class_offset ||
+        rfc_ctx->hysteresis   != src->hysteresis   ||
+        rfc_ctx->full_inc     != src->full_inc     ||
+        rfc_ctx->half_inc     != src->half_inc )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+#if RFC_HCM_SUPPORT
+    /* The HCM method maintains its residue on a separate stack, which is not subject to merging */
+    if( rfc_ctx->counting_method == RFC_COUNTING_METHOD_HCM ||
+            src->counting_method == RFC_COUNTING_METHOD_HCM )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_UNSUPPORTED );
+    }
+#endif /*RFC_HCM_SUPPORT*/
+
+    /* Accumulate histograms, either context may use sparse rainflow matrix storage */
+    if( src->rfm_sparse && ( rfc_ctx->rfm || rfc_ctx->rfm_sparse ) )
+    {
+        for( i = 0; i < src->rfm_sparse_cap; i++ )
+        {
+            const rfc_rfm_item_s *item = &src->rfm_sparse[i];
+
+            if( item->from != (unsigned)-1 && item->counts )
+            {
+                if( rfc_ctx->rfm )
+                {
+                    COUNTS_INC( rfc_ctx, rfc_ctx->rfm[ (size_t)rfc_ctx->class_count * item->from + item->to ], item->counts );
+                }
+                else
+                {
+                    rfc_counts_t *counts = rfm_sparse_at( rfc_ctx, item->from, item->to, /*insert*/ true );
+
+                    if( !counts ) return false;
+
+                    COUNTS_INC( rfc_ctx, *counts, item->counts );
+                }
+            }
+        }
+    }
+    else if( src->rfm && rfc_ctx->rfm )
+    {
+        for( i = 0; i < (size_t)rfc_ctx->class_count * rfc_ctx->class_count; i++ )
+        {
+            COUNTS_INC( rfc_ctx, rfc_ctx->rfm[i], src->rfm[i] );
+        }
+    }
+    else if( src->rfm && rfc_ctx->rfm_sparse )
+    {
+        for( i = 0; i < (size_t)rfc_ctx->class_count * rfc_ctx->class_count; i++ )
+        {
+            if( src->rfm[i] )
+            {
+                rfc_counts_t *counts = rfm_sparse_at( rfc_ctx, (unsigned)( i / rfc_ctx->class_count ),
+                                                               (unsigned)( i % rfc_ctx->class_count ), /*insert*/ true );
+
+                if( !counts ) return false;
+
+                COUNTS_INC( rfc_ctx, *counts, src->rfm[i] );
+            }
+        }
+    }
+
+    if( rfc_ctx->rp && src->rp )
+    {
+        for( i = 0; i < (size_t)rfc_ctx->class_count; i++ )
+        {
+            if( src->rp[i] )
+            {
+                COUNTS_INC( rfc_ctx, rfc_ctx->rp[i], src->rp[i] );
+
+                if( rfc_ctx->rp_bin_version )
+                {
+                    rfc_ctx->rp_bin_version[i] = ++rfc_ctx->rp_version;
+                }
+            }
+        }
+    }
+
+    if( rfc_ctx->lc && src->lc )
+    {
+        for( i = 0; i < (size_t)rfc_ctx->class_count; i++ )
+        {
+            if( src->lc[i] )
+            {
+                COUNTS_INC( rfc_ctx, rfc_ctx->lc[i], src->lc[i] );
+
+                if( rfc_ctx->lc_bin_version )
+                {
+                    rfc_ctx->lc_bin_version[i] = ++rfc_ctx->lc_version;
+                }
+            }
+        }
+    }
+
+    rfc_ctx->damage += src->damage;
+
+    flags       = rfc_ctx->internal.flags;
+    pos_end     = rfc_ctx->internal.pos;
+    residue_cnt = src->residue_cnt + ( ( src->state == RFC_STATE_BUSY_INTERIM ) ? 1 : 0 );
+
+    /* Level crossing counting is already considered for both residues, except for the
+       slopes adjoining the seam: from the last confirmed turning point over a pending
+       interim turning point to the first point of the source residue */
+    if( residue_cnt )
+    {
+        rfc_value_tuple_s path[3];
+        int               path_cnt = 0;
+
+        if( rfc_ctx->residue_cnt )
+        {
+            path[path_cnt++] = rfc_ctx->residue[rfc_ctx->residue_cnt - 1];
+        }
+
+        if( rfc_ctx->state == RFC_STATE_BUSY_INTERIM )
+        {
+            path[path_cnt++] = rfc_ctx->residue[rfc_ctx->residue_cnt];
+        }
+
+        path[path_cnt]      = src->residue[0];
+        path[path_cnt].pos += pos_end;
+        path[path_cnt].cls  = QUANTIZE( rfc_ctx, path[path_cnt].value );
+        path_cnt++;
+
+        for( i = 0; i + 1 < (size_t)path_cnt; i++ )
+        {
+            if( path[i+1].value > path[i].value )
+            {
+                cycle_process_counts( rfc_ctx, &path[i], &path[i+1], NULL, flags & (RFC_FLAGS_COUNT_LC_UP | RFC_FLAGS_ENFORCE_MARGIN) );
+            }
+            else
+            {
+                cycle_process_counts( rfc_ctx, &path[i], &path[i+1], NULL, flags & (RFC_FLAGS_COUNT_LC_DN | RFC_FLAGS_ENFORCE_MARGIN) );
+            }
+        }
+    }
+
+    /* Feed the source residue across the seam, include a pending interim turning point */
+    first_tp_pending = ( rfc_ctx->residue_cnt == 0 && rfc_ctx->state != RFC_STATE_BUSY_INTERIM );
+
+    flags &= ~RFC_FLAGS_COUNT_LC;
+
+    for( i = 0; i < residue_cnt; i++ )
+    {
+        rfc_value_tuple_s tp = { src->residue[i].value };  /* All other members are zero-initialized, see ISO/IEC 9899:TC3, 6.7.8 (21) */
+
+        /* Source stream positions trail the destination stream */
+        tp.pos = pos_end + src->residue[i].pos;
+        tp.cls = QUANTIZE( rfc_ctx, tp.value );
+
+        if( !feed_once( rfc_ctx, &tp, flags ) ) return false;
+
+        if( first_tp_pending && rfc_ctx->state == RFC_STATE_BUSY_INTERIM )
+        {
+            /* The first turning point just emerged from the min-max search. If it stems
+               from a destination sample, the slope to the interim point is missing in the
+               source level crossing counting */
+            first_tp_pending = false;
+
+            if( rfc_ctx->residue[0].pos <= pos_end )
+            {
+                int flags_lc = rfc_ctx->internal.flags;
+
+                if( rfc_ctx->residue[1].value > rfc_ctx->residue[0].value )
+                {
+                    cycle_process_counts( rfc_ctx, &rfc_ctx->residue[0], &rfc_ctx->residue[1], NULL, flags_lc & (RFC_FLAGS_COUNT_LC_UP | RFC_FLAGS_ENFORCE_MARGIN) );
+                }
+                else
+                {
+                    cycle_process_counts( rfc_ctx, &rfc_ctx->residue[0], &rfc_ctx->residue[1], NULL, flags_lc & (RFC_FLAGS_COUNT_LC_DN | RFC_FLAGS_ENFORCE_MARGIN) );
+                }
+            }
+        }
+    }
+
+    rfc_ctx->internal.pos = pos_end + src->internal.pos;
+
+    return true;
+}
+
+
+/**
+ * @brief         Attach a follower context, counting the same stream on its own
+ *                class grid (multi-resolution counting). The leader forwards
+ *                each settled turning point to its followers, which quantize it
+ *                on their own grid and run their own counting. Followers should
+ *                use the same hysteresis as the leader and must be attached
+ *                right after RFC_init(), before any data is fed. Finalize the
+ *                leader first (forwards a pending interim point), then each
+ *                follower. The leader does not take ownership, followers must
+ *                be deinitialized by the caller.
+ *
+ * @param         ctx             The rainflow context (leader)
+ * @param         ctx_follower    The rainflow context to attach
+ *
+ * @return        true on success
+ */
+bool RFC_ctx_attach( void *ctx, void *ctx_follower )
+{
+    rfc_ctx_s *follower = (rfc_ctx_s*)ctx_follower;
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state >= RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+    /* Followers must be freshly initialized and may not follow themselves */
+    if( !follower || follower == rfc_ctx || follower->version != sizeof( rfc_ctx_s ) ||
+         follower->state != RFC_STATE_INIT )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( rfc_ctx->follower_cnt >= rfc_ctx->follower_cap )
+    {
+        unsigned    new_cap   = rfc_ctx->follower_cap ? rfc_ctx->follower_cap * 2 : 4;
+        rfc_ctx_s **followers = (rfc_ctx_s**)ctx_mem_alloc( rfc_ctx, rfc_ctx->followers, new_cap,
+                                                            sizeof( rfc_ctx_s* ), RFC_MEM_AIM_TEMP );
+
+        if( !followers )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+        }
+
+        rfc_ctx->followers    = followers;
+        rfc_ctx->follower_cap = new_cap;
+    }
+
+    rfc_ctx->followers[ rfc_ctx->follower_cnt++ ] = follower;
+
+    return true;
+}
+
+
+/**
+ * @brief         Detach a follower context, see RFC_ctx_attach(). The follower
+ *                keeps its counting results and remains usable on its own.
+ *
+ * @param         ctx             The rainflow context (leader)
+ * @param         ctx_follower    The rainflow context to detach
+ *
+ * @return        true on success
+ */
+bool RFC_ctx_detach( void *ctx, void *ctx_follower )
+{
+    unsigned i;
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( rfc_ctx->state < RFC_STATE_INIT )
+    {
+        return false;
+    }
+
+    for( i = 0; i < rfc_ctx->follower_cnt; i++ )
+    {
+        if( rfc_ctx->followers[i] == (rfc_ctx_s*)ctx_follower )
+        {
+            memmove( &rfc_ctx->followers[i], &rfc_ctx->followers[i+1],
+                     ( rfc_ctx->follower_cnt - i - 1 ) * sizeof( rfc_ctx_s* ) );
+            rfc_ctx->follower_cnt--;
+
+            return true;
+        }
+    }
+
+    return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+}
+
+
+/* Snapshot format identification */
+#define RFC_SNAPSHOT_MAGIC                  0x52464353u             /* "RFCS" */
+#define RFC_SNAPSHOT_VERSION                1u
+
+/* Feature set of the writing build, snapshot layouts must match exactly */
+#if RFC_USE_INTEGRAL_COUNTS > 1
+#define RFC_SNAPSHOT_INTEGRAL_COUNTS        1
+#define RFC_SNAPSHOT_COUNTS_32              1
+#elif RFC_USE_INTEGRAL_COUNTS
+#define RFC_SNAPSHOT_INTEGRAL_COUNTS        1
+#define RFC_SNAPSHOT_COUNTS_32              0
+#else
+#define RFC_SNAPSHOT_INTEGRAL_COUNTS        0
+#define RFC_SNAPSHOT_COUNTS_32              0
+#endif /*RFC_USE_INTEGRAL_COUNTS*/
+#define RFC_SNAPSHOT_FEATURES             ( ( RFC_SNAPSHOT_INTEGRAL_COUNTS ? 1u  : 0u ) | \
+                                            ( RFC_TP_SUPPORT          ? 2u  : 0u ) | \
+                                            ( RFC_DH_SUPPORT          ? 4u  : 0u ) | \
+                                            ( RFC_HCM_SUPPORT         ? 8u  : 0u ) | \
+                                            ( RFC_DAMAGE_FAST         ? 16u : 0u ) | \
+                                            ( RFC_AT_SUPPORT          ? 32u : 0u ) | \
+                                            ( RFC_GLOBAL_EXTREMA      ? 64u : 0u ) | \
+                                            ( RFC_SNAPSHOT_COUNTS_32  ? 128u: 0u ) )
+
+/* Sections contained in a snapshot, ordered by bit position */
+#define RFC_SNAPSHOT_SECTION_RESIDUE        (1u << 0)
+#define RFC_SNAPSHOT_SECTION_RFM            (1u << 1)
+#define RFC_SNAPSHOT_SECTION_RFM_SPARSE     (1u << 2)
+#define RFC_SNAPSHOT_SECTION_RP             (1u << 3)
+#define RFC_SNAPSHOT_SECTION_LC             (1u << 4)
+#define RFC_SNAPSHOT_SECTION_DLUT           (1u << 5)
+#define RFC_SNAPSHOT_SECTION_ALUT           (1u << 6)
+#define RFC_SNAPSHOT_SECTION_HCM            (1u << 7)
+#define RFC_SNAPSHOT_SECTION_TP             (1u << 8)
+#define RFC_SNAPSHOT_SECTION_DH             (1u << 9)
+#define RFC_SNAPSHOT_SECTION_AT             (1u << 10)
+#define RFC_SNAPSHOT_SECTION_DH_SPARSE      (1u << 11)
+
+typedef struct ctx_snapshot_header
+{
+    uint32_t                            magic;                      /**< RFC_SNAPSHOT_MAGIC */
+    uint16_t                            version;                    /**< Snapshot layout version, see RFC_SNAPSHOT_VERSION */
+    uint16_t                            features;                   /**< Feature set of the writing build, see RFC_SNAPSHOT_FEATURES */
+    uint8_t                             sizeof_value;               /**< sizeof(rfc_value_t) */
+    uint8_t                             sizeof_counts;              /**< sizeof(rfc_counts_t) */
+    uint8_t                             sizeof_tuple;               /**< sizeof(rfc_value_tuple_s) */
+    uint8_t                             sizeof_size;                /**< sizeof(size_t) */
+    uint32_t                            sections;                   /**< Sections contained, see RFC_SNAPSHOT_SECTION_... */
+    uint32_t                            class_count;                /**< Class count of the serialized context */
+    uint64_t                            total_size;                 /**< Size of the whole snapshot in bytes */
+} ctx_snapshot_header_s;
+
+
+/**
+ * @brief         Serialize the counting state into a single binary snapshot,
+ *                suited for one write() and a later RFC_ctx_deserialize().
+ *                The snapshot covers residue, histograms (rfm, dense or
+ *                sparse, rp, lc), damage and amplitude look-up tables, HCM
+ *                stack, damage history and context owned turning points.
+ *                Externally kept turning points (delegates) are referenced by
+ *                their count only, the external storage persists on its own.
+ *                The layout is host specific (byte order, type sizes) and
+ *                bound to the feature set of the writing build, both are
+ *                checked on restore. Delegates, the memory allocator and
+ *                amplitude transformation tables are no snapshot content.
+ *
+ * @param         ctx          The rainflow context
+ * @param[out]    buffer       The snapshot, allocated with the context's
+ *                             allocator. Release with
+ *                             ctx->mem_alloc( buffer, 0, 0, RFC_MEM_AIM_TEMP )
+ * @param[out]    buffer_size  The snapshot size in bytes
+ *
+ * @return        true on success
+ */
+bool RFC_ctx_serialize( const void *ctx, void **buffer, size_t *buffer_size )
+{
+    ctx_snapshot_header_s   header;
+    unsigned char          *data, *ptr;
+    size_t                  total, scalars_size, residue_depth, i;
+#if RFC_HCM_SUPPORT
+    size_t                  hcm_depth = 0;
+#endif /*RFC_HCM_SUPPORT*/
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !buffer || !buffer_size )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+#if RFC_AT_SUPPORT
+    if( rfc_ctx->at.count > (unsigned)NUMEL( rfc_ctx->internal.at_haigh.Sa ) )
+    {
+        /* Larger external amplitude transformation tables don't fit the
+           internal storage on restore */
+        return error_raise( rfc_ctx, RFC_ERROR_UNSUPPORTED );
+    }
+#endif /*RFC_AT_SUPPORT*/
+
+    memset( &header, 0, sizeof( header ) );
+    header.magic         = RFC_SNAPSHOT_MAGIC;
+    header.version       = RFC_SNAPSHOT_VERSION;
+    header.features      = RFC_SNAPSHOT_FEATURES;
+    header.sizeof_value  = sizeof( rfc_value_t );
+    header.sizeof_counts = sizeof( rfc_counts_t );
+    header.sizeof_tuple  = sizeof( rfc_value_tuple_s );
+    header.sizeof_size   = sizeof( size_t );
+    header.class_count   = rfc_ctx->class_count;
+
+    /* The interim turning point lives one slot behind the residue */
+    residue_depth = rfc_ctx->residue_cnt + ( ( rfc_ctx->state == RFC_STATE_BUSY_INTERIM ) ? 1 : 0 );
+
+    total = sizeof( header ) + ctx_snapshot_scalars( rfc_ctx, NULL, 0, /*do_write*/ true );
+
+    if( rfc_ctx->residue )
+    {
+        header.sections |= RFC_SNAPSHOT_SECTION_RESIDUE;
+        total           += sizeof( size_t ) + residue_depth * sizeof( rfc_value_tuple_s );
+    }
+
+    if( rfc_ctx->rfm )
+    {
+        header.sections |= RFC_SNAPSHOT_SECTION_RFM;
+        total           += (size_t)rfc_ctx->class_count * rfc_ctx->class_count * sizeof( rfc_counts_t );
+    }
+
+    if( rfc_ctx->rfm_sparse )
+    {
+        header.sections |= RFC_SNAPSHOT_SECTION_RFM_SPARSE;
+        total           += sizeof( size_t ) + rfc_ctx->rfm_sparse_cnt * sizeof( rfc_rfm_item_s );
+    }
+
+    if( rfc_ctx->rp )
+    {
+        header.sections |= RFC_SNAPSHOT_SECTION_RP;
+        total           += (size_t)rfc_ctx->class_count * sizeof( rfc_counts_t );
+    }
+
+    if( rfc_ctx->lc )
+    {
+        header.sections |= RFC_SNAPSHOT_SECTION_LC;
+        total           += (size_t)rfc_ctx->class_count * sizeof( rfc_counts_t );
+    }
+
+#if RFC_DAMAGE_FAST
+    if( rfc_ctx->damage_lut )
+    {
+        /* Rows are filled on first access, complete the table before it is streamed */
+        if( !rfc_ctx->damage_lut_inapt && !damage_lut_fill_all( rfc_ctx ) )
+        {
+            return false;
+        }
+
+        header.sections |= RFC_SNAPSHOT_SECTION_DLUT;
+        total           += (size_t)rfc_ctx->class_count * rfc_ctx->class_count * sizeof( double );
+    }
+#if RFC_AT_SUPPORT
+    if( rfc_ctx->amplitude_lut )
+    {
+        header.sections |= RFC_SNAPSHOT_SECTION_ALUT;
+        total           += (size_t)rfc_ctx->class_count * rfc_ctx->class_count * sizeof( double );
+    }
+#endif /*RFC_AT_SUPPORT*/
+#endif /*RFC_DAMAGE_FAST*/
+
+#if RFC_HCM_SUPPORT
+    if( rfc_ctx->internal.hcm.stack )
+    {
+        /* Stack holds hcm.IZ turning points (base 1) */
+        hcm_depth        = ( rfc_ctx->internal.hcm.IZ > 0 ) ? (size_t)rfc_ctx->internal.hcm.IZ : 0;
+        header.sections |= RFC_SNAPSHOT_SECTION_HCM;
+        total           += sizeof( size_t ) + hcm_depth * sizeof( rfc_value_tuple_s );
+    }
+#endif /*RFC_HCM_SUPPORT*/
+
+#if RFC_TP_SUPPORT
+    if( rfc_ctx->tp )
+    {
+        header.sections |= RFC_SNAPSHOT_SECTION_TP;
+        total           += sizeof( size_t ) + rfc_ctx->tp_cnt * sizeof( rfc_value_tuple_s );
+    }
+#endif /*RFC_TP_SUPPORT*/
+
+#if RFC_DH_SUPPORT
+    if( rfc_ctx->dh )
+    {
+        header.sections |= RFC_SNAPSHOT_SECTION_DH;
+        total           += sizeof( size_t ) + rfc_ctx->dh_cnt * sizeof( double );
+    }
+    else if( rfc_ctx->dh_sparse )
+    {
+        header.sections |= RFC_SNAPSHOT_SECTION_DH_SPARSE;
+        total           += 2 * sizeof( size_t ) + rfc_ctx->dh_sparse_cnt * sizeof( rfc_dh_item_s );
+    }
+#endif /*RFC_DH_SUPPORT*/
+
+#if RFC_AT_SUPPORT
+    if( rfc_ctx->at.count )
+    {
+        header.sections |= RFC_SNAPSHOT_SECTION_AT;
+        total           += (size_t)rfc_ctx->at.count * 2 * sizeof( double );
+    }
+#endif /*RFC_AT_SUPPORT*/
+
+    header.total_size = total;
+
+    data = (unsigned char*)ctx_mem_alloc( rfc_ctx, NULL, total, 1, RFC_MEM_AIM_TEMP );
+
+    if( !data )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+    }
+
+#define SNAPSHOT_APPEND( SRC, BYTES )                                               \
+    do                                                                              \
+    {                                                                               \
+        memcpy( ptr, SRC, BYTES );                                                  \
+        ptr += ( BYTES );                                                           \
+    } while(0)
+
+    ptr = data;
+    SNAPSHOT_APPEND( &header, sizeof( header ) );
+
+    scalars_size = ctx_snapshot_scalars( rfc_ctx, ptr, total - ( ptr - data ), /*do_write*/ true );
+    assert( scalars_size > 0 );
+    ptr += scalars_size;
+
+    if( header.sections & RFC_SNAPSHOT_SECTION_RESIDUE )
+    {
+        SNAPSHOT_APPEND( &residue_depth, sizeof( size_t ) );
+        SNAPSHOT_APPEND( rfc_ctx->residue, residue_depth * sizeof( rfc_value_tuple_s ) );
+    }
+
+    if( header.sections & RFC_SNAPSHOT_SECTION_RFM )
+    {
+        SNAPSHOT_APPEND( rfc_ctx->rfm, (size_t)rfc_ctx->class_count * rfc_ctx->class_count * sizeof( rfc_counts_t ) );
+    }
+
+    if( header.sections & RFC_SNAPSHOT_SECTION_RFM_SPARSE )
+    {
+        SNAPSHOT_APPEND( &rfc_ctx->rfm_sparse_cnt, sizeof( size_t ) );
+
+        for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
+        {
+            if( rfc_ctx->rfm_sparse[i].from != (unsigned)-1 )
+            {
+                SNAPSHOT_APPEND( &rfc_ctx->rfm_sparse[i], sizeof( rfc_rfm_item_s ) );
+            }
+        }
+    }
+
+    if( header.sections & RFC_SNAPSHOT_SECTION_RP )
+    {
+        SNAPSHOT_APPEND( rfc_ctx->rp, (size_t)rfc_ctx->class_count * sizeof( rfc_counts_t ) );
+    }
+
+    if( header.sections & RFC_SNAPSHOT_SECTION_LC )
+    {
+        SNAPSHOT_APPEND( rfc_ctx->lc, (size_t)rfc_ctx->class_count * sizeof( rfc_counts_t ) );
+    }
+
+#if RFC_DAMAGE_FAST
+    if( header.sections & RFC_SNAPSHOT_SECTION_DLUT )
+    {
+        SNAPSHOT_APPEND( rfc_ctx->damage_lut, (size_t)rfc_ctx->class_count * rfc_ctx->class_count * sizeof( double ) );
+    }
+#if RFC_AT_SUPPORT
+    if( header.sections & RFC_SNAPSHOT_SECTION_ALUT )
+    {
+        SNAPSHOT_APPEND( rfc_ctx->amplitude_lut, (size_t)rfc_ctx->class_count * rfc_ctx->class_count * sizeof( double ) );
+    }
+#endif /*RFC_AT_SUPPORT*/
+#endif /*RFC_DAMAGE_FAST*/
+
+#if RFC_HCM_SUPPORT
+    if( header.sections & RFC_SNAPSHOT_SECTION_HCM )
+    {
+        SNAPSHOT_APPEND( &hcm_depth, sizeof( size_t ) );
+        SNAPSHOT_APPEND( rfc_ctx->internal.hcm.stack, hcm_depth * sizeof( rfc_value_tuple_s ) );
+    }
+#endif /*RFC_HCM_SUPPORT*/
+
+#if RFC_TP_SUPPORT
+    if( header.sections & RFC_SNAPSHOT_SECTION_TP )
+    {
+        /* A pending incremental prune leaves the turning points split around the
+           removal gap, see tp_prune_inc_start(). The snapshot image is compact. */
+        size_t moved = rfc_ctx->internal.tp_prune_moved;
+
+        if( moved > rfc_ctx->tp_cnt )
+        {
+            moved = rfc_ctx->tp_cnt;
+        }
+
+        SNAPSHOT_APPEND( &rfc_ctx->tp_cnt, sizeof( size_t ) );
+        SNAPSHOT_APPEND( rfc_ctx->tp, moved * sizeof( rfc_value_tuple_s ) );
+        SNAPSHOT_APPEND( rfc_ctx->tp + moved + rfc_ctx->internal.tp_prune_removal,
+                         ( rfc_ctx->tp_cnt - moved ) * sizeof( rfc_value_tuple_s ) );
+    }
+#endif /*RFC_TP_SUPPORT*/
+
+#if RFC_DH_SUPPORT
+    if( header.sections & RFC_SNAPSHOT_SECTION_DH )
+    {
+        SNAPSHOT_APPEND( &rfc_ctx->dh_cnt, sizeof( size_t ) );
+        SNAPSHOT_APPEND( rfc_ctx->dh, rfc_ctx->dh_cnt * sizeof( double ) );
+    }
+
+    if( header.sections & RFC_SNAPSHOT_SECTION_DH_SPARSE )
+    {
+        SNAPSHOT_APPEND( &rfc_ctx->dh_cnt, sizeof( size_t ) );
+        SNAPSHOT_APPEND( &rfc_ctx->dh_sparse_cnt, sizeof( size_t ) );
+        SNAPSHOT_APPEND( rfc_ctx->dh_sparse, rfc_ctx->dh_sparse_cnt * sizeof( rfc_dh_item_s ) );
+    }
+#endif /*RFC_DH_SUPPORT*/
+
+#if RFC_AT_SUPPORT
+    if( header.sections & RFC_SNAPSHOT_SECTION_AT )
+    {
+        SNAPSHOT_APPEND( rfc_ctx->at.Sa, (size_t)rfc_ctx->at.count * sizeof( double ) );
+        SNAPSHOT_APPEND( rfc_ctx->at.Sm, (size_t)rfc_ctx->at.count * sizeof( double ) );
+    }
+#endif /*RFC_AT_SUPPORT*/
+
+#undef SNAPSHOT_APPEND
+
+    assert( (size_t)( ptr - data ) == total );
+
+    *buffer      = data;
+    *buffer_size = total;
+
+    return true;
+}
+
+
+/**
+ * @brief         Restore the counting state from a snapshot taken with
+ *                RFC_ctx_serialize(), e.g. read in one piece or memory
+ *                mapped. The context must be freshly initialized via
+ *                RFC_init() with the same class count, written by a build
+ *                with identical features and type sizes (checked). Externally
+ *                kept storages are no snapshot content and have to be
+ *                attached before restoring: turning point delegates rebind
+ *                their (persistent) storage, amplitude transformation tables
+ *                given to RFC_at_init() with more than five points cannot be
+ *                restored at all (serializing refuses them).
+ *
+ * @param         ctx          The rainflow context (freshly initialized)
+ * @param[in]     buffer       The snapshot
+ * @param[in]     buffer_size  Size of buffer in bytes, may exceed the
+ *                             snapshot size (e.g. page aligned mapping)
+ *
+ * @return        true on success
+ */
+bool RFC_ctx_deserialize( void *ctx, const void *buffer, size_t buffer_size )
+{
+    const ctx_snapshot_header_s *header;
+    const unsigned char         *ptr;
+    size_t                       remaining, scalars_size, depth, cnt, i;
+    rfc_state_e                  stored_state;
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !buffer || buffer_size < sizeof( ctx_snapshot_header_s ) )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( rfc_ctx->state != RFC_STATE_INIT )
+    {
+        return false;
+    }
+
+    header = (const ctx_snapshot_header_s*)buffer;
+
+    if( header->magic      != RFC_SNAPSHOT_MAGIC   ||
+        header->version    != RFC_SNAPSHOT_VERSION ||
+        header->total_size  > buffer_size )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( header->features      != RFC_SNAPSHOT_FEATURES          ||
+        header->sizeof_value  != sizeof( rfc_value_t )          ||
+        header->sizeof_counts != sizeof( rfc_counts_t )         ||
+        header->sizeof_tuple  != sizeof( rfc_value_tuple_s )    ||
+        header->sizeof_size   != sizeof( size_t ) )
+    {
+        /* Snapshot was written by a differently configured build */
+        return error_raise( rfc_ctx, RFC_ERROR_UNSUPPORTED );
+    }
+
+    if( header->class_count != rfc_ctx->class_count )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    ptr       = (const unsigned char*)buffer + sizeof( ctx_snapshot_header_s );
+    remaining = (size_t)header->total_size   - sizeof( ctx_snapshot_header_s );
+
+    /* Casting away const is safe, the helper only reads the buffer on restore */
+    scalars_size = ctx_snapshot_scalars( rfc_ctx, (unsigned char*)ptr, remaining, /*do_write*/ false );
+
+    if( !scalars_size )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    ptr       += scalars_size;
+    remaining -= scalars_size;
+
+    /* Restore the storages in INIT state, assume the counting state afterwards */
+    stored_state   = rfc_ctx->state;
+    rfc_ctx->state = RFC_STATE_INIT;
+
+#define SNAPSHOT_FETCH( DST, BYTES )                                                \
+    do                                                                              \
+    {                                                                               \
+        if( ( BYTES ) > remaining )                                                 \
+        {                                                                           \
+            return error_raise( rfc_ctx, RFC_ERROR_INVARG );                        \
+        }                                                                           \
+        memcpy( DST, ptr, BYTES );                                                  \
+        ptr       += ( BYTES );                                                     \
+        remaining -= ( BYTES );                                                     \
+    } while(0)
+
+#define SNAPSHOT_SKIP( BYTES )                                                      \
+    do                                                                              \
+    {                                                                               \
+        if( ( BYTES ) > remaining )                                                 \
+        {                                                                           \
+            return error_raise( rfc_ctx, RFC_ERROR_INVARG );                        \
+        }                                                                           \
+        ptr       += ( BYTES );                                                     \
+        remaining -= ( BYTES );                                                     \
+    } while(0)
+
+    if( header->sections & RFC_SNAPSHOT_SECTION_RESIDUE )
+    {
+        SNAPSHOT_FETCH( &depth, sizeof( size_t ) );
+
+        if( depth > rfc_ctx->residue_cap )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+        }
+
+        SNAPSHOT_FETCH( rfc_ctx->residue, depth * sizeof( rfc_value_tuple_s ) );
+        rfc_ctx->residue_cnt = depth - ( ( stored_state == RFC_STATE_BUSY_INTERIM ) ? 1 : 0 );
+    }
+
+    if( header->sections & RFC_SNAPSHOT_SECTION_RFM )
+    {
+        size_t rfm_size = (size_t)rfc_ctx->class_count * rfc_ctx->class_count * sizeof( rfc_counts_t );
+
+        if( rfc_ctx->rfm )
+        {
+            SNAPSHOT_FETCH( rfc_ctx->rfm, rfm_size );
+        }
+        else if( rfc_ctx->rfm_sparse )
+        {
+            /* Restore a dense matrix into sparse storage */
+            for( i = 0; i < (size_t)rfc_ctx->class_count * rfc_ctx->class_count; i++ )
+            {
+                rfc_counts_t value;
+
+                SNAPSHOT_FETCH( &value, sizeof( rfc_counts_t ) );
+
+                if( value )
+                {
+                    rfc_counts_t *counts = rfm_sparse_at( rfc_ctx, (unsigned)( i / rfc_ctx->class_count ),
+                                                                   (unsigned)( i % rfc_ctx->class_count ), /*insert*/ true );
+                    if( !counts )
+                    {
+                        return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+                    }
+                    *counts = value;
+                }
+            }
+        }
+        else
+        {
+            SNAPSHOT_SKIP( rfm_size );
+        }
+    }
+
+    if( header->sections & RFC_SNAPSHOT_SECTION_RFM_SPARSE )
+    {
+        SNAPSHOT_FETCH( &cnt, sizeof( size_t ) );
+
+        if( rfc_ctx->rfm || rfc_ctx->rfm_sparse )
+        {
+            if( !rfc_ctx->rfm_sparse )
+            {
+                /* The writer counted sparsely, mirror that */
+                if( !RFC_rfm_init_sparse( rfc_ctx, cnt * 2 ) )
+                {
+                    return false;
+                }
+            }
+
+            for( i = 0; i < cnt; i++ )
+            {
+                rfc_rfm_item_s  item;
+                rfc_counts_t   *counts;
+
+                SNAPSHOT_FETCH( &item, sizeof( rfc_rfm_item_s ) );
+
+                counts = rfm_sparse_at( rfc_ctx, item.from, item.to, /*insert*/ true );
+
+                if( !counts )
+                {
+                    return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+                }
+                *counts = item.counts;
+            }
+        }
+        else
+        {
+            SNAPSHOT_SKIP( cnt * sizeof( rfc_rfm_item_s ) );
+        }
+    }
+
+    if( header->sections & RFC_SNAPSHOT_SECTION_RP )
+    {
+        if( rfc_ctx->rp )
+        {
+            SNAPSHOT_FETCH( rfc_ctx->rp, (size_t)rfc_ctx->class_count * sizeof( rfc_counts_t ) );
+
+            /* Restoring rewrites every bin, delta readers resync completely */
+            if( rfc_ctx->rp_bin_version )
+            {
+                unsigned i;
+
+                rfc_ctx->rp_version++;
+                for( i = 0; i < rfc_ctx->class_count; i++ )
+                {
+                    rfc_ctx->rp_bin_version[i] = rfc_ctx->rp_version;
+                }
+            }
+        }
+        else
+        {
+            SNAPSHOT_SKIP( (size_t)rfc_ctx->class_count * sizeof( rfc_counts_t ) );
+        }
+    }
+
+    if( header->sections & RFC_SNAPSHOT_SECTION_LC )
+    {
+        if( rfc_ctx->lc )
+        {
+            SNAPSHOT_FETCH( rfc_ctx->lc, (size_t)rfc_ctx->class_count * sizeof( rfc_counts_t ) );
+
+            if( rfc_ctx->lc_bin_version )
+            {
+                unsigned i;
+
+                rfc_ctx->lc_version++;
+                for( i = 0; i < rfc_ctx->class_count; i++ )
+                {
+                    rfc_ctx->lc_bin_version[i] = rfc_ctx->lc_version;
+                }
+            }
+        }
+        else
+        {
+            SNAPSHOT_SKIP( (size_t)rfc_ctx->class_count * sizeof( rfc_counts_t ) );
+        }
+    }
+
+#if RFC_DAMAGE_FAST
+    if( header->sections & RFC_SNAPSHOT_SECTION_DLUT )
+    {
+        size_t lut_size = (size_t)rfc_ctx->class_count * rfc_ctx->class_count * sizeof( double );
+
+        if( rfc_ctx->damage_lut )
+        {
+            /* A shared table must not be overwritten, recede to an exclusive one first */
+            if( !damage_lut_detach( rfc_ctx ) )
+            {
+                return false;
+            }
+
+            SNAPSHOT_FETCH( rfc_ctx->damage_lut, lut_size );
+
+            if( rfc_ctx->damage_lut_row_valid )
+            {
+                memset( rfc_ctx->damage_lut_row_valid, 1, rfc_ctx->class_count );
+            }
+        }
+        else
+        {
+            SNAPSHOT_SKIP( lut_size );
+        }
+    }
+#if RFC_AT_SUPPORT
+    if( header->sections & RFC_SNAPSHOT_SECTION_ALUT )
+    {
+        size_t lut_size = (size_t)rfc_ctx->class_count * rfc_ctx->class_count * sizeof( double );
+
+        if( rfc_ctx->amplitude_lut )
+        {
+            if( !damage_lut_detach( rfc_ctx ) )
+            {
+                return false;
+            }
+
+            SNAPSHOT_FETCH( rfc_ctx->amplitude_lut, lut_size );
+        }
+        else
+        {
+            SNAPSHOT_SKIP( lut_size );
+        }
+    }
+#endif /*RFC_AT_SUPPORT*/
+#endif /*RFC_DAMAGE_FAST*/
+
+#if RFC_HCM_SUPPORT
+    if( header->sections & RFC_SNAPSHOT_SECTION_HCM )
+    {
+        SNAPSHOT_FETCH( &depth, sizeof( size_t ) );
+
+        if( rfc_ctx->internal.hcm.stack )
+        {
+            if( depth > rfc_ctx->internal.hcm.stack_cap )
+            {
+                return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+            }
+            SNAPSHOT_FETCH( rfc_ctx->internal.hcm.stack, depth * sizeof( rfc_value_tuple_s ) );
+        }
+        else
+        {
+            SNAPSHOT_SKIP( depth * sizeof( rfc_value_tuple_s ) );
+        }
+    }
+#endif /*RFC_HCM_SUPPORT*/
+
+#if RFC_TP_SUPPORT
+    if( header->sections & RFC_SNAPSHOT_SECTION_TP )
+    {
+        SNAPSHOT_FETCH( &cnt, sizeof( size_t ) );
+
+        if( rfc_ctx->tp )
+        {
+            if( cnt > rfc_ctx->tp_cap )
+            {
+                rfc_value_tuple_s *tp;
+
+                if( rfc_ctx->internal.tp_static )
+                {
+                    return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+                }
+
+                tp = (rfc_value_tuple_s*)ctx_mem_alloc( rfc_ctx, rfc_ctx->tp, cnt, sizeof( rfc_value_tuple_s ), RFC_MEM_AIM_TP );
+
+                if( !tp )
+                {
+                    return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+                }
+
+                rfc_ctx->tp     = tp;
+                rfc_ctx->tp_cap = cnt;
+            }
+
+            SNAPSHOT_FETCH( rfc_ctx->tp, cnt * sizeof( rfc_value_tuple_s ) );
+            rfc_ctx->tp_cnt = cnt;
+        }
+#if RFC_USE_DELEGATES
+        else if( rfc_ctx->tp_set_fcn )
+        {
+            /* Forward the content into the attached storage */
+            rfc_ctx->tp_cnt = 0;
+
+            for( i = 0; i < cnt; i++ )
+            {
+                rfc_value_tuple_s tp;
+
+                SNAPSHOT_FETCH( &tp, sizeof( rfc_value_tuple_s ) );
+
+                if( !tp_set( rfc_ctx, 0, &tp ) )
+                {
+                    return error_raise( rfc_ctx, RFC_ERROR_TP );
+                }
+            }
+        }
+#endif /*RFC_USE_DELEGATES*/
+        else
+        {
+            SNAPSHOT_SKIP( cnt * sizeof( rfc_value_tuple_s ) );
+            rfc_ctx->tp_cnt = 0;
+        }
+    }
+    else if( !rfc_ctx->tp
+#if RFC_USE_DELEGATES
+             && !rfc_ctx->tp_get_fcn
+#endif /*RFC_USE_DELEGATES*/
+           )
+    {
+        /* Writer kept its turning points externally, nothing attached here */
+        rfc_ctx->tp_cnt = 0;
+    }
+#endif /*RFC_TP_SUPPORT*/
+
+#if RFC_DH_SUPPORT
+    if( header->sections & RFC_SNAPSHOT_SECTION_DH )
+    {
+        SNAPSHOT_FETCH( &cnt, sizeof( size_t ) );
+
+        if( rfc_ctx->dh_sparse )
+        {
+            /* The writer counted densely, restore into sparse storage */
+            rfc_ctx->dh_sparse_cnt = 0;
+
+            for( i = 0; i < cnt; i++ )
+            {
+                double value;
+
+                SNAPSHOT_FETCH( &value, sizeof( double ) );
+
+                if( value != 0.0 && !dh_add( rfc_ctx, i, value ) )
+                {
+                    return false;
+                }
+            }
+
+            rfc_ctx->dh_cnt = cnt;
+        }
+        else
+        {
+            if( cnt > rfc_ctx->dh_cap )
+            {
+                double *dh;
+
+                if( rfc_ctx->internal.dh_static )
+                {
+                    return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+                }
+
+                dh = (double*)ctx_mem_alloc( rfc_ctx, rfc_ctx->dh, cnt, sizeof( double ), RFC_MEM_AIM_DH );
+
+                if( !dh )
+                {
+                    return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+                }
+
+                rfc_ctx->dh     = dh;
+                rfc_ctx->dh_cap = cnt;
+            }
+
+            SNAPSHOT_FETCH( rfc_ctx->dh, cnt * sizeof( double ) );
+            rfc_ctx->dh_cnt = cnt;
+        }
+    }
+
+    if( header->sections & RFC_SNAPSHOT_SECTION_DH_SPARSE )
+    {
+        size_t item_cnt;
+
+        SNAPSHOT_FETCH( &cnt, sizeof( size_t ) );
+        SNAPSHOT_FETCH( &item_cnt, sizeof( size_t ) );
+
+        if( rfc_ctx->dh_sparse )
+        {
+            if( item_cnt > rfc_ctx->dh_sparse_cap )
+            {
+                rfc_dh_item_s *items = (rfc_dh_item_s*)ctx_mem_alloc( rfc_ctx, rfc_ctx->dh_sparse, item_cnt,
+                                                                           sizeof( rfc_dh_item_s ), RFC_MEM_AIM_DH );
+                if( !items )
+                {
+                    return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+                }
+
+                rfc_ctx->dh_sparse     = items;
+                rfc_ctx->dh_sparse_cap = item_cnt;
+            }
+
+            SNAPSHOT_FETCH( rfc_ctx->dh_sparse, item_cnt * sizeof( rfc_dh_item_s ) );
+            rfc_ctx->dh_sparse_cnt = item_cnt;
+            rfc_ctx->dh_cnt        = cnt;
+        }
+        else if( rfc_ctx->dh )
+        {
+            /* The writer counted sparsely, scatter into dense storage */
+            if( cnt > rfc_ctx->dh_cap )
+            {
+                double *dh;
+
+                if( rfc_ctx->internal.dh_static )
+                {
+                    return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+                }
+
+                dh = (double*)ctx_mem_alloc( rfc_ctx, rfc_ctx->dh, cnt, sizeof( double ), RFC_MEM_AIM_DH );
+
+                if( !dh )
+                {
+                    return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+                }
+
+                rfc_ctx->dh     = dh;
+                rfc_ctx->dh_cap = cnt;
+            }
+
+            memset( rfc_ctx->dh, 0, cnt * sizeof( double ) );
+
+            for( i = 0; i < item_cnt; i++ )
+            {
+                rfc_dh_item_s item;
+
+                SNAPSHOT_FETCH( &item, sizeof( rfc_dh_item_s ) );
+
+                if( item.pos >= cnt )
+                {
+                    return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+                }
+
+                rfc_ctx->dh[item.pos] += item.damage;
+            }
+
+            rfc_ctx->dh_cnt = cnt;
+        }
+        else
+        {
+            SNAPSHOT_SKIP( item_cnt * sizeof( rfc_dh_item_s ) );
+        }
+    }
+    rfc_ctx->dh_istream = NULL;
+#endif /*RFC_DH_SUPPORT*/
+
+#if RFC_AT_SUPPORT
+    if( header->sections & RFC_SNAPSHOT_SECTION_AT )
+    {
+        if( rfc_ctx->at.count > (unsigned)NUMEL( rfc_ctx->internal.at_haigh.Sa ) )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+        }
+
+        SNAPSHOT_FETCH( rfc_ctx->internal.at_haigh.Sa, (size_t)rfc_ctx->at.count * sizeof( double ) );
+        SNAPSHOT_FETCH( rfc_ctx->internal.at_haigh.Sm, (size_t)rfc_ctx->at.count * sizeof( double ) );
+
+        rfc_ctx->internal.at_haigh.count = rfc_ctx->at.count;
+        rfc_ctx->at.Sa                   = rfc_ctx->internal.at_haigh.Sa;
+        rfc_ctx->at.Sm                   = rfc_ctx->internal.at_haigh.Sm;
+    }
+    else
+    {
+        rfc_ctx->at.Sa = NULL;
+        rfc_ctx->at.Sm = NULL;
+    }
+#endif /*RFC_AT_SUPPORT*/
+
+#undef SNAPSHOT_FETCH
+#undef SNAPSHOT_SKIP
+
+    rfc_ctx->state = stored_state;
+
+    return true;
+}
+
+
+#if RFC_FILE_SUPPORT
+/* Chunk size in samples for ingest paths that convert or de-interleave */
+#define FEED_FILE_CHUNK 1024
+
+/**
+ * @brief      Feed raw binary64 records from a file view
+ *
+ * @param      rfc_ctx        The rainflow context
+ * @param[in]  data           The first record
+ * @param[in]  count          The number of complete records
+ * @param[in]  channel_count  Values per record
+ * @param[in]  channel        Channel to feed (0-based)
+ *
+ * @return     true on success
+ */
+static
+bool feed_file_f64( rfc_ctx_s *rfc_ctx, const double *data, size_t count, unsigned channel_count, unsigned channel )
+{
+    if( channel_count == 1 && sizeof( rfc_value_t ) == sizeof( double ) )
+    {
+        /* Value type matches the record layout, feed straight from the view */
+        return RFC_feed( rfc_ctx, (const rfc_value_t*)(const void*)data, count );
+    }
+    else
+    {
+        rfc_value_t chunk[FEED_FILE_CHUNK];
+        size_t      n = 0, i;
+
+        data += channel;
+
+        for( i = 0; i < count; i++, data += channel_count )
+        {
+            chunk[n++] = (rfc_value_t)*data;
+
+            if( n == FEED_FILE_CHUNK )
+            {
+                if( !RFC_feed( rfc_ctx, chunk, n ) ) return false;
+                n = 0;
+            }
+        }
+
+        return n ? RFC_feed( rfc_ctx, chunk, n ) : true;
+    }
+}
+
+
+/**
+ * @brief      Feed raw binary32 records from a file view
+ *
+ * @param      rfc_ctx        The rainflow context
+ * @param[in]  data           The first record
+ * @param[in]  count          The number of complete records
+ * @param[in]  channel_count  Values per record
+ * @param[in]  channel        Channel to feed (0-based)
+ *
+ * @return     true on success
+ */
+static
+bool feed_file_f32( rfc_ctx_s *rfc_ctx, const float *data, size_t count, unsigned channel_count, unsigned channel )
+{
+    if( channel_count == 1 && sizeof( rfc_value_t ) == sizeof( float ) )
+    {
+        return RFC_feed( rfc_ctx, (const rfc_value_t*)(const void*)data, count );
+    }
+    else
+    {
+        rfc_value_t chunk[FEED_FILE_CHUNK];
+        size_t      n = 0, i;
+
+        data += channel;
+
+        for( i = 0; i < count; i++, data += channel_count )
+        {
+            chunk[n++] = (rfc_value_t)*data;
+
+            if( n == FEED_FILE_CHUNK )
+            {
+                if( !RFC_feed( rfc_ctx, chunk, n ) ) return false;
+                n = 0;
+            }
+        }
+
+        return n ? RFC_feed( rfc_ctx, chunk, n ) : true;
+    }
+}
+
+
+/**
+ * @brief      Parse one decimal number, fast path without strtod()
+ *
+ *             Up to 18 significant digits are accumulated in an integer
+ *             mantissa; the result is exact whenever mantissa and scaled
+ *             exponent stay inside the double fast path (mantissa < 2^53,
+ *             |exponent| <= 22).  Anything else (long mantissas, huge
+ *             exponents, inf/nan) falls back to strtod() on a bounded copy.
+ *
+ * @param[in]  p      Parse position
+ * @param[in]  end    End of the buffer (not null terminated)
+ * @param[out] value  The parsed value
+ * @param[out] valid  true, if a number was parsed
+ *
+ * @return     New parse position
+ */
+static
+const char * feed_file_csv_number( const char *p, const char *end, double *value, bool *valid )
+{
+    static const double pow10_tab[] =
+    {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char *begin   = p;
+    uint64_t    mant    = 0;
+    int         digits  = 0;
+    int         frac    = 0;
+    int         exp10   = 0;
+    bool        neg     = false;
+    bool        any     = false;
+    bool        precise = true;
+
+    *valid = false;
+
+    if( p < end && ( *p == '+' || *p == '-' ) )
+    {
+        neg = ( *p == '-' );
+        p++;
+    }
+
+    while( p < end && *p >= '0' && *p <= '9' )
+    {
+        if( digits < 18 )
+        {
+            mant = mant * 10 + (uint64_t)( *p - '0' );
+            if( mant ) digits++;
+        }
+        else
+        {
+            /* Excess integral digits shift the exponent */
+            exp10++;
+            precise = false;
+        }
+        any = true;
+        p++;
+    }
+
+    if( p < end && *p == '.' )
+    {
+        p++;
+        while( p < end && *p >= '0' && *p <= '9' )
+        {
+            if( digits < 18 )
+            {
+                mant = mant * 10 + (uint64_t)( *p - '0' );
+                if( mant ) digits++;
+                frac++;
+            }
+            else
+            {
+                precise = false;
+            }
+            any = true;
+            p++;
+        }
+    }
+
+    if( !any )
+    {
+        /* No number at this position (inf/nan take the strtod path below) */
+        char c = ( p < end ) ? *p : 0;
+
+        if( c != 'i' && c != 'I' && c != 'n' && c != 'N' )
+        {
+            return begin;
+        }
+        precise = false;
+    }
+
+    if( p < end && ( *p == 'e' || *p == 'E' ) )
+    {
+        const char *ep   = p + 1;
+        bool        eneg = false;
+        int         e    = 0;
+
+        if( ep < end && ( *ep == '+' || *ep == '-' ) )
+        {
+            eneg = ( *ep == '-' );
+            ep++;
+        }
+
+        if( ep < end && *ep >= '0' && *ep <= '9' )
+        {
+            while( ep < end && *ep >= '0' && *ep <= '9' )
+            {
+                if( e < 10000 ) e = e * 10 + ( *ep - '0' );
+                ep++;
+            }
+            exp10 += eneg ? -e : e;
+            p = ep;
+        }
+    }
+
+    exp10 -= frac;
+
+    if( precise && mant < ( (uint64_t)1 << 53 ) && exp10 >= -22 && exp10 <= 22 )
+    {
+        double v = ( exp10 >= 0 ) ? (double)mant * pow10_tab[exp10]
+                                  : (double)mant / pow10_tab[-exp10];
+        *value = neg ? -v : v;
+        *valid = true;
+        return p;
+    }
+    else
+    {
+        /* Slow but exact path */
+        char   buf[64];
+        char  *tail;
+        size_t len;
+
+        /* Re-scan from begin, strtod() needs a terminated copy */
+        while( p < end && ( ( *p >= '0' && *p <= '9' ) || *p == '.' || *p == '+' || *p == '-' ||
+                            *p == 'e' || *p == 'E' || *p == 'i' || *p == 'I' || *p == 'n' || *p == 'N' ||
+                            *p == 'f' || *p == 'F' || *p == 'a' || *p == 'A' ) )
+        {
+            p++;
+        }
+
+        len = (size_t)( p - begin );
+        if( len >= sizeof( buf ) ) len = sizeof( buf ) - 1;
+        memcpy( buf, begin, len );
+        buf[len] = 0;
+
+        *value = strtod( buf, &tail );
+        *valid = ( tail != buf );
+
+        return begin + ( tail - buf );
+    }
+}
+
+
+/**
+ * @brief      Feed one CSV column from a file view
+ *
+ *             One record per line, fields split at ',', ';' or blanks.
+ *             Lines without a parsable number in the selected column are
+ *             ignored (headers, blank and comment lines).
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param[in]  text     The file content (not null terminated)
+ * @param[in]  size     The content size in bytes
+ * @param[in]  channel  Column to feed (0-based)
+ *
+ * @return     true on success
+ */
+static
+bool feed_file_csv( rfc_ctx_s *rfc_ctx, const char *text, size_t size, unsigned channel )
+{
+    rfc_value_t  chunk[FEED_FILE_CHUNK];
+    size_t       n   = 0;
+    const char  *p   = text;
+    const char  *end = text + size;
+
+    while( p < end )
+    {
+        const char *eol   = p;
+        unsigned    field;
+        double      value;
+        bool        valid = false;
+
+        while( eol < end && *eol != '\n' ) eol++;
+
+        for( field = 0; field <= channel; field++ )
+        {
+            while( p < eol && ( *p == ' ' || *p == '\t' || *p == '\r' ) ) p++;
+
+            if( field == channel )
+            {
+                p = feed_file_csv_number( p, eol, &value, &valid );
+            }
+            else
+            {
+                while( p < eol && *p != ',' && *p != ';' && *p != ' ' && *p != '\t' ) p++;
+            }
+
+            while( p < eol && ( *p == ' ' || *p == '\t' || *p == '\r' ) ) p++;
+            if( p < eol && ( *p == ',' || *p == ';' ) ) p++;
+        }
+
+        if( valid )
+        {
+            chunk[n++] = (rfc_value_t)value;
+
+            if( n == FEED_FILE_CHUNK )
+            {
+                if( !RFC_feed( rfc_ctx, chunk, n ) ) return false;
+                n = 0;
+            }
+        }
+
+        p = ( eol < end ) ? eol + 1 : end;
+    }
+
+    return n ? RFC_feed( rfc_ctx, chunk, n ) : true;
+}
+
+
+/**
+ * @brief      Feed counting directly from a file
+ *
+ *             Binary formats are memory mapped on POSIX systems and fed to
+ *             the counting core without an intermediate copy where record
+ *             layout and value type permit; other platforms fall back to
+ *             reading the file into a temporary buffer.  Interleaved
+ *             multichannel records are de-interleaved chunk-wise, a trailing
+ *             partial record is ignored.  State handling is as with
+ *             RFC_feed(), counting stays open for further feeds.
+ *
+ * @param      ctx            The rainflow context
+ * @param[in]  path           The file to ingest
+ * @param[in]  format         The file format (RFC_FILE_FORMAT_...)
+ * @param[in]  channel_count  Values per record (1 for plain series)
+ * @param[in]  channel        Channel resp. CSV column to feed (0-based)
+ *
+ * @return     true on success
+ */
+bool RFC_feed_file( void *ctx, const char *path, rfc_file_format_e format, unsigned channel_count, unsigned channel )
+{
+    void   *view      = NULL;
+    size_t  view_size = 0;
+    bool    ok        = false;
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !path || !channel_count || channel >= channel_count ||
+        (int)format < 0 || (int)format >= (int)RFC_FILE_FORMAT_COUNT )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+#if RFC_FEED_FILE_USE_MMAP
+    {
+        int         fd = open( path, O_RDONLY );
+        struct stat st;
+
+        if( fd < 0 || fstat( fd, &st ) != 0 )
+        {
+            if( fd >= 0 ) close( fd );
+            return error_raise( rfc_ctx, RFC_ERROR_FILE );
+        }
+
+        view_size = (size_t)st.st_size;
+
+        if( view_size )
+        {
+            view = mmap( NULL, view_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+            if( view == MAP_FAILED )
+            {
+                close( fd );
+                return error_raise( rfc_ctx, RFC_ERROR_FILE );
+            }
+#if defined(POSIX_MADV_SEQUENTIAL)
+            (void)posix_madvise( view, view_size, POSIX_MADV_SEQUENTIAL );
+#endif /*POSIX_MADV_SEQUENTIAL*/
+        }
+
+        close( fd );
+    }
+#else /*!RFC_FEED_FILE_USE_MMAP*/
+    {
+        FILE *file = fopen( path, "rb" );
+        long  file_size;
+
+        if( !file )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_FILE );
+        }
+
+        if( fseek( file, 0L, SEEK_END ) != 0 || ( file_size = ftell( file ) ) < 0 )
+        {
+            fclose( file );
+            return error_raise( rfc_ctx, RFC_ERROR_FILE );
+        }
+        rewind( file );
+
+        view_size = (size_t)file_size;
+
+        if( view_size )
+        {
+            view = ctx_mem_alloc( rfc_ctx, NULL, view_size, 1, RFC_MEM_AIM_TEMP );
+
+            if( !view )
+            {
+                fclose( file );
+                return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+            }
+
+            if( fread( view, 1, view_size, file ) != view_size )
+            {
+                (void)ctx_mem_alloc( rfc_ctx, view, 0, 0, RFC_MEM_AIM_TEMP );
+                fclose( file );
+                return error_raise( rfc_ctx, RFC_ERROR_FILE );
+            }
+        }
+
+        fclose( file );
+    }
+#endif /*RFC_FEED_FILE_USE_MMAP*/
+
+    if( !view_size )
+    {
+        /* Empty file, nothing to feed */
+        return true;
+    }
+
+    switch( format )
+    {
+        case RFC_FILE_FORMAT_F64:
+            ok = feed_file_f64( rfc_ctx, (const double*)view,
+                                view_size / sizeof( double ) / channel_count,
+                                channel_count, channel );
+            break;
+
+        case RFC_FILE_FORMAT_F32:
+            ok = feed_file_f32( rfc_ctx, (const float*)view,
+                                view_size / sizeof( float ) / channel_count,
+                                channel_count, channel );
+            break;
+
+        case RFC_FILE_FORMAT_CSV:
+            ok = feed_file_csv( rfc_ctx, (const char*)view, view_size, channel );
+            break;
+
+        default:
+            ok = error_raise( rfc_ctx, RFC_ERROR_INVARG );
+            break;
+    }
+
+#if RFC_FEED_FILE_USE_MMAP
+    (void)munmap( view, view_size );
+#else /*!RFC_FEED_FILE_USE_MMAP*/
+    (void)ctx_mem_alloc( rfc_ctx, view, 0, 0, RFC_MEM_AIM_TEMP );
+#endif /*RFC_FEED_FILE_USE_MMAP*/
+
+    return ok;
+}
+
+
+/* Turning point archive ("RFTP", version 1):
+ *
+ *   Header:  'R' 'F' 'T' 'P', version (u8), value format (u8, 0=binary64
+ *            1=binary32), two reserved bytes (0). Values are host byte order,
+ *            like the raw RFC_feed_file() formats.
+ *   Blocks until end of file, each opened by one tag byte:
+ *     'T'    Turning points: count (varint), then per point the position
+ *            delta to the previous point (varint, positions are strictly
+ *            increasing, base 1) and the value (binary64/32).
+ *     'R'    Results: class count (varint), class width and offset
+ *            (binary64), non-zero rainflow matrix elements (count as varint,
+ *            then from/to as varints and counts as binary64 each), range pair
+ *            and level crossing histograms (presence flag as u8, then class
+ *            count values as binary64).
+ *
+ *   Varints are unsigned LEB128: 7 value bits per byte, high bit flags a
+ *   continuation byte. */
+#define TP_EXPORT_VERSION        1
+#define TP_EXPORT_BLOCK_TP      'T'
+#define TP_EXPORT_BLOCK_RESULTS 'R'
+
+/**
+ * @brief      Flush the write buffer to the output stream
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param      writer   The writer
+ *
+ * @return     true on success
+ */
+static
+bool tp_export_flush( rfc_ctx_s *rfc_ctx, rfc_tp_export_s *writer )
+{
+    if( writer->buffer_cnt )
+    {
+        if( fwrite( writer->buffer, 1, writer->buffer_cnt, (FILE*)writer->file ) != writer->buffer_cnt )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_FILE );
+        }
+        writer->buffer_cnt = 0;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Put raw bytes into the write buffer, flushing as needed
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param      writer   The writer
+ * @param[in]  data     The bytes
+ * @param[in]  size     The number of bytes
+ *
+ * @return     true on success
+ */
+static
+bool tp_export_put( rfc_ctx_s *rfc_ctx, rfc_tp_export_s *writer, const void *data, size_t size )
+{
+    if( writer->buffer_cnt + size > sizeof( writer->buffer ) )
+    {
+        if( !tp_export_flush( rfc_ctx, writer ) )
+        {
+            return false;
+        }
+    }
+
+    memcpy( writer->buffer + writer->buffer_cnt, data, size );
+    writer->buffer_cnt += size;
+
+    return true;
+}
+
+
+/**
+ * @brief      Put one unsigned LEB128 varint into the write buffer
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param      writer   The writer
+ * @param[in]  value    The value
+ *
+ * @return     true on success
+ */
+static
+bool tp_export_put_varint( rfc_ctx_s *rfc_ctx, rfc_tp_export_s *writer, uint64_t value )
+{
+    unsigned char bytes[10];
+    size_t        n = 0;
+
+    do
+    {
+        unsigned char byte = (unsigned char)( value & 0x7f );
+
+        value >>= 7;
+        if( value )
+        {
+            byte |= 0x80;
+        }
+        bytes[n++] = byte;
+    } while( value );
+
+    return tp_export_put( rfc_ctx, writer, bytes, n );
+}
+
+
+/**
+ * @brief      Put one value in the format chosen on open into the write buffer
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param      writer   The writer
+ * @param[in]  value    The value
+ *
+ * @return     true on success
+ */
+static
+bool tp_export_put_value( rfc_ctx_s *rfc_ctx, rfc_tp_export_s *writer, double value )
+{
+    if( writer->value_format == (int)RFC_FILE_FORMAT_F32 )
+    {
+        float f32 = (float)value;
+
+        return tp_export_put( rfc_ctx, writer, &f32, sizeof( f32 ) );
+    }
+
+    return tp_export_put( rfc_ctx, writer, &value, sizeof( value ) );
+}
+
+
+/**
+ * @brief      Open a streaming turning point archive for writing. Points are
+ *             appended with RFC_tp_export_append(), results records with
+ *             RFC_tp_export_results(), RFC_tp_export_close() completes the
+ *             file. RFC_tp_import() feeds an archive back into a context.
+ *             Positions are delta encoded, values optionally stored as
+ *             binary32 to halve the archive size.
+ *
+ * @param      ctx           The rainflow context
+ * @param      writer        The writer, maintained by the export functions
+ * @param[in]  path          The file path
+ * @param[in]  value_format  RFC_FILE_FORMAT_F64 or RFC_FILE_FORMAT_F32
+ *
+ * @return     true on success
+ */
+bool RFC_tp_export_open( void *ctx, rfc_tp_export_s *writer, const char *path, rfc_file_format_e value_format )
+{
+    static const unsigned char magic[4] = { 'R', 'F', 'T', 'P' };
+    unsigned char              header[4];
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !writer || !path ||
+        ( value_format != RFC_FILE_FORMAT_F64 && value_format != RFC_FILE_FORMAT_F32 ) )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    memset( writer, 0, sizeof( *writer ) );
+
+    writer->file         = fopen( path, "wb" );
+    writer->value_format = (int)value_format;
+
+    if( !writer->file )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_FILE );
+    }
+
+    header[0] = TP_EXPORT_VERSION;
+    header[1] = (unsigned char)value_format;
+    header[2] = 0;
+    header[3] = 0;
+
+    return tp_export_put( rfc_ctx, writer, magic,  sizeof( magic ) ) &&
+           tp_export_put( rfc_ctx, writer, header, sizeof( header ) );
+}
+
+
+/**
+ * @brief      Append turning points to an archive, e.g. a slice of the tp
+ *             storage or the residue. Stream positions must increase strictly
+ *             over the lifetime of the archive (base 1)
+ *
+ * @param      ctx     The rainflow context
+ * @param      writer  The writer
+ * @param[in]  tp      The turning points
+ * @param[in]  count   The number of turning points
+ *
+ * @return     true on success
+ */
+bool RFC_tp_export_append( void *ctx, rfc_tp_export_s *writer, const rfc_value_tuple_s *tp, size_t count )
+{
+    unsigned char tag = TP_EXPORT_BLOCK_TP;
+    size_t        i;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !writer || !writer->file || ( !tp && count ) )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( !count )
+    {
+        return true;
+    }
+
+    if( !tp_export_put( rfc_ctx, writer, &tag, 1 ) ||
+        !tp_export_put_varint( rfc_ctx, writer, (uint64_t)count ) )
+    {
+        return false;
+    }
+
+    for( i = 0; i < count; i++ )
+    {
+        if( tp[i].pos <= writer->pos_prev )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_DATA_INCONSISTENT );
+        }
+
+        if( !tp_export_put_varint( rfc_ctx, writer, (uint64_t)( tp[i].pos - writer->pos_prev ) ) ||
+            !tp_export_put_value( rfc_ctx, writer, (double)tp[i].value ) )
+        {
+            return false;
+        }
+
+        writer->pos_prev = tp[i].pos;
+        writer->tp_cnt++;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Append a results record (rainflow matrix, range pair and level
+ *             crossing histograms with class parameters) to an archive
+ *
+ * @param      ctx     The rainflow context
+ * @param      writer  The writer
+ *
+ * @return     true on success
+ */
+bool RFC_tp_export_results( void *ctx, rfc_tp_export_s *writer )
+{
+    rfc_rfm_item_s *items    = NULL;
+    unsigned        item_cnt = 0;
+    unsigned        i;
+    unsigned char   tag      = TP_EXPORT_BLOCK_RESULTS;
+    unsigned char   flag;
+    bool            ok;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !writer || !writer->file )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+    if( ( rfc_ctx->rfm || rfc_ctx->rfm_sparse ) && !RFC_rfm_get( rfc_ctx, &items, &item_cnt ) )
+    {
+        return false;
+    }
+
+    ok = tp_export_put( rfc_ctx, writer, &tag, 1 ) &&
+         tp_export_put_varint( rfc_ctx, writer, (uint64_t)rfc_ctx->class_count );
+
+    {
+        double width  = (double)rfc_ctx->class_width;
+        double offset = (double)rfc_ctx->class_offset;
+
+        ok = ok && tp_export_put( rfc_ctx, writer, &width,  sizeof( width ) )
+                && tp_export_put( rfc_ctx, writer, &offset, sizeof( offset ) );
+    }
+
+    ok = ok && tp_export_put_varint( rfc_ctx, writer, (uint64_t)item_cnt );
+
+    for( i = 0; ok && i < item_cnt; i++ )
+    {
+        double counts = (double)items[i].counts;
+
+        ok = tp_export_put_varint( rfc_ctx, writer, (uint64_t)items[i].from ) &&
+             tp_export_put_varint( rfc_ctx, writer, (uint64_t)items[i].to )   &&
+             tp_export_put( rfc_ctx, writer, &counts, sizeof( counts ) );
+    }
+
+    if( items )
+    {
+        ctx_mem_alloc( rfc_ctx, items, 0, 0, RFC_MEM_AIM_RFM_ELEMENTS );
+    }
+
+    flag = rfc_ctx->rp ? 1 : 0;
+    ok   = ok && tp_export_put( rfc_ctx, writer, &flag, 1 );
+    for( i = 0; ok && flag && i < rfc_ctx->class_count; i++ )
+    {
+        double counts = (double)rfc_ctx->rp[i];
+
+        ok = tp_export_put( rfc_ctx, writer, &counts, sizeof( counts ) );
+    }
+
+    flag = rfc_ctx->lc ? 1 : 0;
+    ok   = ok && tp_export_put( rfc_ctx, writer, &flag, 1 );
+    for( i = 0; ok && flag && i < rfc_ctx->class_count; i++ )
+    {
+        double counts = (double)rfc_ctx->lc[i];
+
+        ok = tp_export_put( rfc_ctx, writer, &counts, sizeof( counts ) );
+    }
+
+    return ok;
+}
+
+
+/**
+ * @brief      Flush pending bytes and close an archive
+ *
+ * @param      ctx     The rainflow context
+ * @param      writer  The writer
+ *
+ * @return     true on success
+ */
+bool RFC_tp_export_close( void *ctx, rfc_tp_export_s *writer )
+{
+    bool ok;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !writer || !writer->file )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    ok = tp_export_flush( rfc_ctx, writer );
+
+    if( fclose( (FILE*)writer->file ) != 0 )
+    {
+        ok = error_raise( rfc_ctx, RFC_ERROR_FILE );
+    }
+
+    writer->file = NULL;
+
+    return ok;
+}
+
+
+/**
+ * @brief      Read one unsigned LEB128 varint
+ *
+ * @param[in]  p      Parse position
+ * @param[in]  end    End of the buffer
+ * @param[out] value  The value
+ *
+ * @return     New parse position or NULL, if truncated or overlong
+ */
+static
+const unsigned char * tp_import_varint( const unsigned char *p, const unsigned char *end, uint64_t *value )
+{
+    uint64_t result = 0;
+    int      shift  = 0;
+
+    while( p < end && shift < 64 )
+    {
+        unsigned char byte = *p++;
+
+        result |= (uint64_t)( byte & 0x7f ) << shift;
+
+        if( !( byte & 0x80 ) )
+        {
+            *value = result;
+            return p;
+        }
+
+        shift += 7;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief      Feed a turning point archive written by the RFC_tp_export
+ *             functions back into a context via RFC_feed_tuple(), preserving
+ *             the original stream positions. Results records are skipped
+ *
+ * @param      ctx   The rainflow context
+ * @param[in]  path  The file path
+ *
+ * @return     true on success
+ */
+bool RFC_tp_import( void *ctx, const char *path )
+{
+    unsigned char       *view;
+    const unsigned char *p, *end;
+    size_t               view_size;
+    size_t               value_size;
+    size_t               pos = 0;
+    bool                 f32;
+    bool                 ok  = true;
+    FILE                *file;
+    long                 file_size;
+    rfc_value_tuple_s    chunk[FEED_FILE_CHUNK];
+    size_t               n   = 0;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !path )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    file = fopen( path, "rb" );
+
+    if( !file )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_FILE );
+    }
+
+    if( fseek( file, 0L, SEEK_END ) != 0 || ( file_size = ftell( file ) ) < 0 )
+    {
+        fclose( file );
+        return error_raise( rfc_ctx, RFC_ERROR_FILE );
+    }
+    rewind( file );
+
+    if( file_size < 8 )
+    {
+        fclose( file );
+        return error_raise( rfc_ctx, RFC_ERROR_DATA_INCONSISTENT );
+    }
+
+    view_size = (size_t)file_size;
+    view      = (unsigned char*)ctx_mem_alloc( rfc_ctx, NULL, view_size, 1, RFC_MEM_AIM_TEMP );
+
+    if( !view )
+    {
+        fclose( file );
+        return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+    }
+
+    if( fread( view, 1, view_size, file ) != view_size )
+    {
+        (void)ctx_mem_alloc( rfc_ctx, view, 0, 0, RFC_MEM_AIM_TEMP );
+        fclose( file );
+        return error_raise( rfc_ctx, RFC_ERROR_FILE );
+    }
+
+    fclose( file );
+
+    p   = view;
+    end = view + view_size;
+
+    if( view_size < 8 || memcmp( p, "RFTP", 4 ) != 0 || p[4] != TP_EXPORT_VERSION ||
+        ( p[5] != (unsigned char)RFC_FILE_FORMAT_F64 && p[5] != (unsigned char)RFC_FILE_FORMAT_F32 ) )
+    {
+        (void)ctx_mem_alloc( rfc_ctx, view, 0, 0, RFC_MEM_AIM_TEMP );
+        return error_raise( rfc_ctx, RFC_ERROR_DATA_INCONSISTENT );
+    }
+
+    f32        = ( p[5] == (unsigned char)RFC_FILE_FORMAT_F32 );
+    value_size = f32 ? sizeof( float ) : sizeof( double );
+    p         += 8;
+
+    while( ok && p < end )
+    {
+        unsigned char tag = *p++;
+
+        if( tag == TP_EXPORT_BLOCK_TP )
+        {
+            uint64_t count, i;
+
+            p = tp_import_varint( p, end, &count );
+
+            for( i = 0; ok && p && i < count; i++ )
+            {
+                uint64_t delta;
+                double   value;
+
+                p = tp_import_varint( p, end, &delta );
+
+                if( !p || !delta || (size_t)( end - p ) < value_size )
+                {
+                    p = NULL;
+                    break;
+                }
+
+                if( f32 )
+                {
+                    float value_f32;
+
+                    memcpy( &value_f32, p, sizeof( value_f32 ) );
+                    value = (double)value_f32;
+                }
+                else
+                {
+                    memcpy( &value, p, sizeof( value ) );
+                }
+                p   += value_size;
+                pos += (size_t)delta;
+
+                memset( &chunk[n], 0, sizeof( chunk[n] ) );
+                chunk[n].value = (rfc_value_t)value;
+                chunk[n].pos   = pos;
+                chunk[n].cls   = ( (rfc_value_t)value >= rfc_ctx->class_offset ) ? QUANTIZE( rfc_ctx, (rfc_value_t)value ) : 0;
+
+                if( ++n == FEED_FILE_CHUNK )
+                {
+                    ok = RFC_feed_tuple( rfc_ctx, chunk, n );
+                    n  = 0;
+                }
+            }
+        }
+        else if( tag == TP_EXPORT_BLOCK_RESULTS )
+        {
+            /* Results records don't feed back, parse over them */
+            uint64_t class_count, item_cnt, i;
+            int      hist;
+
+            p = tp_import_varint( p, end, &class_count );
+
+            if( p && (size_t)( end - p ) >= 2 * sizeof( double ) )
+            {
+                p += 2 * sizeof( double );
+                p  = tp_import_varint( p, end, &item_cnt );
+            }
+            else
+            {
+                p = NULL;
+            }
+
+            for( i = 0; p && i < item_cnt; i++ )
+            {
+                uint64_t from, to;
+
+                p = tp_import_varint( p, end, &from );
+                if( p )
+                {
+                    p = tp_import_varint( p, end, &to );
+                }
+                if( p && (size_t)( end - p ) >= sizeof( double ) )
+                {
+                    p += sizeof( double );
+                }
+                else
+                {
+                    p = NULL;
+                }
+            }
+
+            for( hist = 0; p && hist < 2; hist++ )
+            {
+                if( p < end )
+                {
+                    unsigned char flag = *p++;
+
+                    if( flag && (size_t)( end - p ) >= class_count * sizeof( double ) )
+                    {
+                        p += (size_t)class_count * sizeof( double );
+                    }
+                    else if( flag )
+                    {
+                        p = NULL;
+                    }
+                }
+                else
+                {
+                    p = NULL;
+                }
+            }
+        }
+        else
+        {
+            p = NULL;
+        }
+
+        if( !p )
+        {
+            ok = error_raise( rfc_ctx, RFC_ERROR_DATA_INCONSISTENT );
+        }
+    }
+
+    if( ok && n )
+    {
+        ok = RFC_feed_tuple( rfc_ctx, chunk, n );
+    }
+
+    (void)ctx_mem_alloc( rfc_ctx, view, 0, 0, RFC_MEM_AIM_TEMP );
+
+    return ok;
+}
+#endif /*RFC_FILE_SUPPORT*/
+#endif /*!RFC_MINIMAL*/
+
+
+/**
+ * @brief      Finalize pending counts and turning point storage.
+ *
+ * @param      ctx              The rainflow context
+ * @param      residual_method  The residual method (RFC_RES_...)
+ *
+ * @return     true on success
+ */
+bool RFC_finalize( void *ctx, rfc_res_method_e residual_method )
+{
+    double damage;
+    bool ok;
+    RFC_CTX_CHECK_AND_ASSIGN
+    
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state >= RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+#if _DEBUG
+    rfc_ctx->internal.finalizing = true;
+#endif /*_DEBUG*/
+
+#if !RFC_MINIMAL
+    /* Forward a pending interim turning point to attached follower contexts,
+       so they can be finalized by the caller afterwards */
+    if( rfc_ctx->follower_cnt && rfc_ctx->state == RFC_STATE_BUSY_INTERIM )
+    {
+        if( !feed_once_followers( rfc_ctx, &rfc_ctx->residue[rfc_ctx->residue_cnt] ) )
+        {
+            return false;
+        }
+    }
+#endif /*!RFC_MINIMAL*/
+
+    damage = rfc_ctx->damage;
+
+#if RFC_USE_DELEGATES
+    if( rfc_ctx->finalize_fcn )
+    {
+        ok = rfc_ctx->finalize_fcn( rfc_ctx, residual_method );
+    }
+    else
+#endif /*RFC_USE_DELEGATES*/
+    {
+        int flags = rfc_ctx->internal.flags;
+
+#if !RFC_MINIMAL
+        /* Level crossing counting is already considered for residue */
+        flags &= ~RFC_FLAGS_COUNT_LC;
+#endif /*!RFC_MINIMAL*/
+
+        switch( residual_method )
+        {
+            case RFC_RES_NONE:
+                /* FALLTHROUGH */
+            case RFC_RES_IGNORE:
+                ok = finalize_res_ignore( rfc_ctx, flags );
+                break;
+            case RFC_RES_NO_FINALIZE:
+                ok = finalize_res_no_finalize( rfc_ctx, flags );
+                break;
+#if !RFC_MINIMAL
+            case RFC_RES_DISCARD:
+                ok = finalize_res_discard( rfc_ctx, flags );
+                break;
+            case RFC_RES_HALFCYCLES:
+                ok = finalize_res_weight_cycles( rfc_ctx, rfc_ctx->half_inc, flags );
+                break;
+            case RFC_RES_FULLCYCLES:
+                ok = finalize_res_weight_cycles( rfc_ctx, rfc_ctx->full_inc, flags );
+                break;
+            case RFC_RES_CLORMANN_SEEGER:
+                ok = finalize_res_clormann_seeger( rfc_ctx, flags );
+                break;
+            case RFC_RES_REPEATED:
+                ok = finalize_res_repeated( rfc_ctx, flags );
+                break;
+            case RFC_RES_RP_DIN45667:
+                ok = finalize_res_rp_DIN45667( rfc_ctx, flags );
+                break;
+#endif /*!RFC_MINIMAL*/
+            default:
+                assert( false );
+                ok = error_raise( rfc_ctx, RFC_ERROR_INVARG );
+        }
+        assert( rfc_ctx->state == RFC_STATE_FINALIZE );
+    }
+
+#if !RFC_MINIMAL
+    if( rfc_ctx->counting_method == RFC_COUNTING_METHOD_NONE || !rfc_ctx->class_count )
+    {
+#else /*RFC_MINIMAL*/
+    if( !rfc_ctx->class_count )
+    {
+#endif /*!RFC_MINIMAL*/
+        rfc_ctx->residue_cnt = 0;
+    }
+
+    rfc_ctx->damage_residue = rfc_ctx->damage - damage;
+    rfc_ctx->state          = ok ? RFC_STATE_FINISHED : RFC_STATE_ERROR;
+
+#if _DEBUG
+    rfc_ctx->internal.finalizing = false;
+#endif /*_DEBUG*/
+
+#if RFC_DH_SUPPORT
+    if( ok )
+    {
+        ok = spread_damage_map_tp( rfc_ctx );
+    }
+#endif /*RFC_DH_SUPPORT*/
+
+    return ok;
+}
+
+
+#if !RFC_MINIMAL
+/**
+ * @brief         Preview finalizing without ending the counting
+ *
+ *                Runs the given residual method on a shadow of the context:
+ *                the residue (and the HCM stack, where applicable) is copied,
+ *                cycle deltas are counted into the caller provided buffers of
+ *                *result only, and the context itself keeps streaming. This
+ *                avoids cloning the class counting storages when residual
+ *                methods are compared every reporting interval.
+ *
+ * @param         ctx              The rainflow context
+ * @param[in]     residual_method  The method for handling the residue
+ * @param[in,out] result           The result. The buffers .rfm and .rp are
+ *                                 optional and receive the cycle count deltas
+ *                                 the residue adds, if given
+ *
+ * @return        true on success
+ */
+bool RFC_finalize_preview( const void *ctx, rfc_res_method_e residual_method, rfc_result_s *result )
+{
+    rfc_ctx_s          preview;
+    rfc_value_tuple_s *residue;
+    size_t             residue_cnt;
+    bool               ok;
+#if RFC_HCM_SUPPORT
+    rfc_value_tuple_s *hcm_stack = NULL;
+#endif /*RFC_HCM_SUPPORT*/
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state >= RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+    if( !result )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    /* Shadow the context, all mutable storages are detached below */
+    preview = *rfc_ctx;
+
+    /* Cycle deltas go into the caller buffers only */
+    preview.rfm            = result->rfm;
+    preview.rp             = result->rp;
+    preview.lc             = NULL;
+    preview.rfm_sparse     = NULL;
+    preview.rfm_sparse_cap = 0;
+    preview.rfm_sparse_cnt = 0;
+
+    /* Histogram versions track the streaming context only */
+    preview.rp_bin_version = NULL;
+    preview.lc_bin_version = NULL;
+
+    /* Follower contexts see the real stream only, not the preview */
+    preview.followers      = NULL;
+    preview.follower_cnt   = 0;
+    preview.follower_cap   = 0;
+
+    if( result->rfm )
+    {
+        memset( result->rfm, 0, (size_t)rfc_ctx->class_count * rfc_ctx->class_count * sizeof( rfc_counts_t ) );
+    }
+
+    if( result->rp )
+    {
+        memset( result->rp, 0, (size_t)rfc_ctx->class_count * sizeof( rfc_counts_t ) );
+    }
+
+#if RFC_TP_SUPPORT
+    /* Turning points belong to the stream and remain untouched */
+    preview.tp        = NULL;
+    preview.tp_cap    = 0;
+    preview.tp_cnt    = 0;
+#if RFC_USE_DELEGATES
+    preview.tp_set_fcn        = NULL;
+    preview.tp_get_fcn        = NULL;
+    preview.tp_inc_damage_fcn = NULL;
+#endif /*RFC_USE_DELEGATES*/
+#endif /*RFC_TP_SUPPORT*/
+
+#if RFC_DH_SUPPORT
+    /* Likewise the damage history */
+    preview.spread_damage_method = RFC_SD_NONE;
+    preview.dh_istream           = NULL;
+    preview.dh                   = NULL;
+    preview.dh_cap               = 0;
+    preview.dh_cnt               = 0;
+    preview.dh_sparse            = NULL;
+    preview.dh_sparse_cap        = 0;
+    preview.dh_sparse_cnt        = 0;
+#endif /*RFC_DH_SUPPORT*/
+
+    /* Finalizing consumes the residue, work on a copy */
+    residue_cnt = rfc_ctx->residue_cnt;
+
+    if( rfc_ctx->state == RFC_STATE_BUSY_INTERIM )
+    {
+        /* Take the interim point along */
+        residue_cnt++;
+    }
+
+    residue = (rfc_value_tuple_s*)ctx_mem_alloc( rfc_ctx, NULL, rfc_ctx->residue_cap,
+                                                      sizeof(rfc_value_tuple_s), RFC_MEM_AIM_RESIDUE );
+
+    if( !residue )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+    }
+
+    memcpy( residue, rfc_ctx->residue, residue_cnt * sizeof( rfc_value_tuple_s ) );
+
+    preview.residue             = residue;
+    preview.internal.res_static = false;
+
+#if RFC_HCM_SUPPORT
+    if( rfc_ctx->counting_method == RFC_COUNTING_METHOD_HCM && rfc_ctx->internal.hcm.stack )
+    {
+        /* The HCM stack is consumed likewise */
+        hcm_stack = (rfc_value_tuple_s*)ctx_mem_alloc( rfc_ctx, NULL, rfc_ctx->internal.hcm.stack_cap,
+                                                            sizeof(rfc_value_tuple_s), RFC_MEM_AIM_HCM );
+
+        if( !hcm_stack )
+        {
+            ctx_mem_alloc( rfc_ctx, residue, 0, 0, RFC_MEM_AIM_RESIDUE );
+            return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+        }
+
+        memcpy( hcm_stack, rfc_ctx->internal.hcm.stack, (size_t)rfc_ctx->internal.hcm.IZ * sizeof( rfc_value_tuple_s ) );
+
+        preview.internal.hcm.stack = hcm_stack;
+    }
+#endif /*RFC_HCM_SUPPORT*/
+
+    ok = RFC_finalize( &preview, residual_method );
+
+    if( ok )
+    {
+        result->damage         = preview.damage;
+        result->damage_residue = preview.damage_residue;
+        result->residue_cnt    = preview.residue_cnt;
+    }
+
+    /* Dispose the shadow copies, finalizing may have reallocated the residue */
+    ctx_mem_alloc( rfc_ctx, preview.residue, 0, 0, RFC_MEM_AIM_RESIDUE );
+#if RFC_HCM_SUPPORT
+    if( hcm_stack )
+    {
+        ctx_mem_alloc( rfc_ctx, preview.internal.hcm.stack, 0, 0, RFC_MEM_AIM_HCM );
+    }
+#endif /*RFC_HCM_SUPPORT*/
+
+    if( !ok )
+    {
+        return error_raise( rfc_ctx, preview.error );
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Initialize sparse rainflow matrix storage
+ *
+ *             Replaces the dense rainflow matrix with a hash based sparse
+ *             storage, whose footprint scales with the number of distinct
+ *             cycles counted rather than with the square of the class count.
+ *             Intended for high class counts, where the dense matrix becomes
+ *             prohibitive. To avoid the transient dense allocation, initialize
+ *             the context without RFC_FLAGS_COUNT_RFM beforehand.
+ *
+ * @param      ctx   The rainflow context
+ * @param      cap   The initial table capacity in elements, rounded up to a
+ *                   power of two, 0 for default
+ *
+ * @return     true on success
+ */
+bool RFC_rfm_init_sparse( void *ctx, size_t cap )
+{
+    size_t cap_pow2, i;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( rfc_ctx->state != RFC_STATE_INIT )
+    {
+        return false;
+    }
+
+    if( !rfc_ctx->class_count || rfc_ctx->rfm_sparse )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    for( cap_pow2 = 64; cap_pow2 < cap; cap_pow2 *= 2 );
+
+    rfc_ctx->rfm_sparse = (rfc_rfm_item_s*)ctx_mem_alloc( rfc_ctx, NULL, cap_pow2, sizeof(rfc_rfm_item_s), RFC_MEM_AIM_RFM_ELEMENTS );
+
+    if( !rfc_ctx->rfm_sparse )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+    }
+
+    for( i = 0; i < cap_pow2; i++ )
+    {
+        rfc_ctx->rfm_sparse[i].from = (unsigned)-1;
+    }
+
+    rfc_ctx->rfm_sparse_cap = cap_pow2;
+    rfc_ctx->rfm_sparse_cnt = 0;
+
+    /* The sparse storage supersedes the dense matrix */
+    if( rfc_ctx->rfm )
+    {
+        ctx_mem_alloc( rfc_ctx, rfc_ctx->rfm, /*num*/ 0, /*size*/ 0, RFC_MEM_AIM_MATRIX );
+        rfc_ctx->rfm = NULL;
+    }
+
+    rfc_ctx->internal.flags |= RFC_FLAGS_COUNT_RFM;
+
+    return true;
+}
+
+
+/**
+ * @brief      Make rainflow matrix symmetrical
+ *
+ * @param      ctx   The rainflow context
+ *
+ * @return     true on success
+ */
+bool RFC_rfm_make_symmetric( void *ctx )
+{
+    unsigned       class_count;
+    unsigned       from, to;
+    rfc_counts_t  *rfm;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+    
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+    if( rfc_ctx->rfm_sparse )
+    {
+        rfc_rfm_item_s *table;
+        size_t          i, cap_req;
+
+        /* Reserve in advance, insertions below must not rehash while iterating */
+        for( cap_req = rfc_ctx->rfm_sparse_cap; rfc_ctx->rfm_sparse_cnt * 2 >= cap_req - cap_req / 4; cap_req *= 2 );
+
+        if( cap_req > rfc_ctx->rfm_sparse_cap && !rfm_sparse_rehash( rfc_ctx, cap_req ) )
+        {
+            return false;
+        }
+
+        table = rfc_ctx->rfm_sparse;
+
+        /* Cumulate entries symmetric by major diagonal */
+        for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
+        {
+            if( table[i].from != (unsigned)-1 && table[i].from > table[i].to && table[i].counts )
+            {
+                rfc_counts_t *counts = rfm_sparse_at( rfc_ctx, table[i].to, table[i].from, /*insert*/ true );
+
+                if( !counts )
+                {
+                    return false;
+                }
+
+                *counts         += table[i].counts;
+                table[i].counts  = 0;
+            }
+        }
+
+        return true;
+    }
+
+    rfm = rfc_ctx->rfm;
+
+    if( !rfm )
+    {
+        return false;
+    }
+
+    class_count = rfc_ctx->class_count;
+
+    /* Cumulate entries symmetric by major diagonal */
+    for( from = 0; from < class_count; from++ )
+    {
+        for( to = from + 1; to < class_count; to++ )
+        {
+            /* to > from, always */
+            rfm[ MAT_OFFS( from, to ) ] += rfm[ MAT_OFFS( to, from ) ];
+            rfm[ MAT_OFFS( to, from ) ]  = 0;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Returns the number of non zero entries in rainflow matrix
+ *
+ * @param[in]  ctx   The rainflow context
+ *
+ * @return     true on success
+ */
+bool RFC_rfm_non_zeros( const void *ctx, unsigned *count )
+{
+    unsigned            class_count;
+    unsigned            from, to;
+    rfc_counts_t       *rfm_it;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !count )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+    
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+    class_count = rfc_ctx->class_count;
+
+    if( rfc_ctx->rfm_sparse )
+    {
+        size_t i;
+
+        *count = 0;
+        for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
+        {
+            if( rfc_ctx->rfm_sparse[i].from != (unsigned)-1 && rfc_ctx->rfm_sparse[i].counts )
+            {
+                (*count)++;
+            }
+        }
+
+        return true;
+    }
+
+    rfm_it = rfc_ctx->rfm;
+
+    if( !rfm_it || !class_count )
+    {
+        return false;
+    }
+
+    *count = 0;
+    for( from = 0; from < class_count; from++ )
+    {
+        for( to = 0; to < class_count; to++ )
+        {
+            if( *rfm_it++ ) (*count)++;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Get the rainflow matrix as sparse elements
+ *
+ * @param      ctx     The rainflow context
+ * @param[out] buffer  The elements buffer, if NULL memory will be allocated
+ * @param[out] count   The number of elements in buffer
+ *
+ * @return     true on success
+ * @note       The counts are natively returned, regardless of .full_inc!
+*/
+bool RFC_rfm_get( const void *ctx, rfc_rfm_item_s **buffer, unsigned *count )
+{
+    unsigned            class_count;
+    unsigned            from, to;
+    unsigned            count_old;
+    rfc_counts_t       *rfm_it;
+    rfc_rfm_item_s     *item;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !buffer || !count )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+    
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+    class_count = rfc_ctx->class_count;
+
+    if( rfc_ctx->rfm_sparse )
+    {
+        size_t i;
+
+        count_old = *count;
+        *count    = 0;
+        for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
+        {
+            if( rfc_ctx->rfm_sparse[i].from != (unsigned)-1 && rfc_ctx->rfm_sparse[i].counts )
+            {
+                (*count)++;
+            }
+        }
+
+        if( *count > count_old )
+        {
+            *buffer = ctx_mem_alloc( rfc_ctx, *buffer, *count, sizeof(rfc_rfm_item_s), RFC_MEM_AIM_RFM_ELEMENTS );
+
+            if( !*buffer )
+            {
+                error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+                return false;
+            }
+        }
+
+        item = *buffer;
+        for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
+        {
+            if( rfc_ctx->rfm_sparse[i].from != (unsigned)-1 && rfc_ctx->rfm_sparse[i].counts )
+            {
+                *item++ = rfc_ctx->rfm_sparse[i];
+            }
+        }
+
+        /* Deliver in row-major order, like the dense matrix does */
+        qsort( *buffer, *count, sizeof(rfc_rfm_item_s), rfm_sparse_item_compare );
+
+        return true;
+    }
+
+    rfm_it = rfc_ctx->rfm;
 
     if( !rfm_it || !class_count )
     {
@@ -1911,7 +5267,7 @@ bool RFC_rfm_get( const void *ctx, rfc_rfm_item_s **buffer, unsigned *count )
 
     if( *count > count_old )
     {
-        *buffer = rfc_ctx->mem_alloc( *buffer, *count, sizeof(rfc_rfm_item_s), RFC_MEM_AIM_RFM_ELEMENTS );
+        *buffer = ctx_mem_alloc( rfc_ctx, *buffer, *count, sizeof(rfc_rfm_item_s), RFC_MEM_AIM_RFM_ELEMENTS );
 
         if( !*buffer )
         {
@@ -1970,7 +5326,44 @@ bool RFC_rfm_set( void *ctx, const rfc_rfm_item_s *buffer, unsigned count, bool
         return false;
     }
 
-    class_count = rfc_ctx->class_count;
+    class_count = rfc_ctx->class_count;
+
+    if( rfc_ctx->rfm_sparse && class_count )
+    {
+        size_t j;
+
+        if( !add_only )
+        {
+            /* Initialize with free slots */
+            for( j = 0; j < rfc_ctx->rfm_sparse_cap; j++ )
+            {
+                rfc_ctx->rfm_sparse[j].from = (unsigned)-1;
+            }
+            rfc_ctx->rfm_sparse_cnt = 0;
+        }
+
+        item = buffer;
+        for( i = 0; i < count; i++, item++ )
+        {
+            unsigned      from = item->from;
+            unsigned      to   = item->to;
+            rfc_counts_t *counts;
+
+            if( from >= class_count ) from = class_count - 1;
+            if( to   >= class_count ) to   = class_count - 1;
+
+            counts = rfm_sparse_at( rfc_ctx, from, to, /*insert*/ true );
+
+            if( !counts )
+            {
+                return false;
+            }
+
+            COUNTS_INC( rfc_ctx, *counts, item->counts );
+        }
+
+        return true;
+    }
 
     rfm = rfc_ctx->rfm;
 
@@ -1998,7 +5391,7 @@ bool RFC_rfm_set( void *ctx, const rfc_rfm_item_s *buffer, unsigned count, bool
 
         if( from > 0 && to > 0 )
         {
-            rfm[ MAT_OFFS( from-1, to-1 ) ] += item->counts;
+            COUNTS_INC( rfc_ctx, rfm[ MAT_OFFS( from-1, to-1 ) ], item->counts );
         }
     }
 
@@ -2031,9 +5424,7 @@ bool RFC_rfm_peek( const void *ctx, rfc_value_t from_val, rfc_value_t to_val, rf
 
     class_count = rfc_ctx->class_count;
 
-    rfm = rfc_ctx->rfm;
-
-    if( !rfm || !class_count )
+    if( ( !rfc_ctx->rfm && !rfc_ctx->rfm_sparse ) || !class_count )
     {
         return false;
     }
@@ -2049,7 +5440,17 @@ bool RFC_rfm_peek( const void *ctx, rfc_value_t from_val, rfc_value_t to_val, rf
 
     if( counts )
     {
-        *counts = rfm[ MAT_OFFS( from, to ) ];
+        if( rfc_ctx->rfm_sparse )
+        {
+            rfc_counts_t *counts_at = rfm_sparse_at( rfc_ctx, from, to, /*insert*/ false );
+
+            *counts = counts_at ? *counts_at : 0;
+        }
+        else
+        {
+            rfm     = rfc_ctx->rfm;
+            *counts = rfm[ MAT_OFFS( from, to ) ];
+        }
     }
 
     return true;
@@ -2082,9 +5483,7 @@ bool RFC_rfm_poke( void *ctx, rfc_value_t from_val, rfc_value_t to_val, rfc_coun
 
     class_count = rfc_ctx->class_count;
 
-    rfm = rfc_ctx->rfm;
-
-    if( !rfm || !class_count )
+    if( ( !rfc_ctx->rfm && !rfc_ctx->rfm_sparse ) || !class_count )
     {
         return false;
     }
@@ -2098,9 +5497,32 @@ bool RFC_rfm_poke( void *ctx, rfc_value_t from_val, rfc_value_t to_val, rfc_coun
     if( from > class_count ) from = class_count;
     if( to   > class_count ) to   = class_count;
 
+    if( rfc_ctx->rfm_sparse )
+    {
+        rfc_counts_t *counts_at = rfm_sparse_at( rfc_ctx, from, to, /*insert*/ true );
+
+        if( !counts_at )
+        {
+            return false;
+        }
+
+        if( add_only )
+        {
+            COUNTS_INC( rfc_ctx, *counts_at, counts );
+        }
+        else
+        {
+            *counts_at = counts;
+        }
+
+        return true;
+    }
+
+    rfm = rfc_ctx->rfm;
+
     if( add_only )
     {
-        rfm[ MAT_OFFS( from, to ) ] += counts;
+        COUNTS_INC( rfc_ctx, rfm[ MAT_OFFS( from, to ) ], counts );
     }
     else
     {
@@ -2139,9 +5561,7 @@ bool RFC_rfm_sum( const void *ctx, unsigned from_first, unsigned from_last, unsi
 
     class_count = rfc_ctx->class_count;
 
-    rfm = rfc_ctx->rfm;
-
-    if( !rfm || !class_count )
+    if( ( !rfc_ctx->rfm && !rfc_ctx->rfm_sparse ) || !class_count )
     {
         return false;
     }
@@ -2157,11 +5577,32 @@ bool RFC_rfm_sum( const void *ctx, unsigned from_first, unsigned from_last, unsi
     {
         rfc_counts_t sum = 0;
 
-        for( from = from_first; from <= from_last; from++ )
+        if( rfc_ctx->rfm_sparse )
+        {
+            size_t i;
+
+            for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
+            {
+                const rfc_rfm_item_s *item = &rfc_ctx->rfm_sparse[i];
+
+                if( item->from != (unsigned)-1                         &&
+                    item->from >= from_first && item->from <= from_last &&
+                    item->to   >= to_first   && item->to   <  to_last )
+                {
+                    sum += item->counts;
+                }
+            }
+        }
+        else
         {
-            for( to = to_first; to < to_last; to++ )
+            rfm = rfc_ctx->rfm;
+
+            for( from = from_first; from <= from_last; from++ )
             {
-                sum += rfm[ MAT_OFFS( from, to ) ];
+                for( to = to_first; to < to_last; to++ )
+                {
+                    sum += rfm[ MAT_OFFS( from, to ) ];
+                }
             }
         }
 
@@ -2200,9 +5641,7 @@ bool RFC_rfm_damage( const void *ctx, unsigned from_first, unsigned from_last, u
 
     class_count = rfc_ctx->class_count;
 
-    rfm = rfc_ctx->rfm;
-
-    if( !rfm || !class_count )
+    if( ( !rfc_ctx->rfm && !rfc_ctx->rfm_sparse ) || !class_count )
     {
         return false;
     }
@@ -2217,19 +5656,47 @@ bool RFC_rfm_damage( const void *ctx, unsigned from_first, unsigned from_last, u
     if( damage )
     {
         double sum = 0.0;
-        for( from = from_first; from <= from_last; from++ )
+
+        if( rfc_ctx->rfm_sparse )
         {
-            for( to = to_first; to < to_last; to++ )
+            size_t i;
+
+            for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
             {
-                rfc_counts_t count = rfm[ MAT_OFFS( from, to ) ];
+                const rfc_rfm_item_s *item = &rfc_ctx->rfm_sparse[i];
                 double damage_i;
-                
-                if( !damage_calc( rfc_ctx, from, to, &damage_i, NULL /*Sa_ret*/ ) )
+
+                if( item->from != (unsigned)-1 && item->counts           &&
+                    item->from >= from_first && item->from <= from_last &&
+                    item->to   >= to_first   && item->to   <  to_last )
                 {
-                    return false;
+                    if( !damage_calc( rfc_ctx, item->from, item->to, &damage_i, NULL /*Sa_ret*/ ) )
+                    {
+                        return false;
+                    }
+
+                    sum += damage_i * item->counts;
                 }
+            }
+        }
+        else
+        {
+            rfm = rfc_ctx->rfm;
+
+            for( from = from_first; from <= from_last; from++ )
+            {
+                for( to = to_first; to < to_last; to++ )
+                {
+                    rfc_counts_t count = rfm[ MAT_OFFS( from, to ) ];
+                    double damage_i;
+
+                    if( !damage_calc( rfc_ctx, from, to, &damage_i, NULL /*Sa_ret*/ ) )
+                    {
+                        return false;
+                    }
 
-                sum += damage_i * count;
+                    sum += damage_i * count;
+                }
             }
         }
 
@@ -2261,6 +5728,24 @@ bool RFC_rfm_check( const void *ctx )
 
     class_count = rfc_ctx->class_count;
 
+    if( rfc_ctx->rfm_sparse )
+    {
+        size_t i;
+
+        for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
+        {
+            /* Matrix diagonal must be all zero */
+            if( rfc_ctx->rfm_sparse[i].from != (unsigned)-1      &&
+                rfc_ctx->rfm_sparse[i].from == rfc_ctx->rfm_sparse[i].to &&
+                rfc_ctx->rfm_sparse[i].counts != 0 )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     rfm = rfc_ctx->rfm;
 
     if( !rfm || !class_count )
@@ -2309,7 +5794,7 @@ bool RFC_rfm_refeed( void *ctx, rfc_value_t new_hysteresis, const rfc_class_para
         return false;
     }
 
-    if( !rfc_ctx->rfm || !rfc_ctx->class_count )
+    if( ( !rfc_ctx->rfm && !rfc_ctx->rfm_sparse ) || !rfc_ctx->class_count )
     {
         return RFC_clear_counts( rfc_ctx );
     }
@@ -2407,6 +5892,109 @@ bool RFC_lc_get( const void *ctx, rfc_counts_t *lc, rfc_value_t *level )
 }
 
 
+/**
+ * @brief      Get a zero-copy view on the level crossing histogram.
+ *
+ *             The returned pointer refers the live histogram, valid until
+ *             RFC_deinit(). Bins change while data is fed, single-threaded
+ *             consumers only!
+ *
+ * @param      ctx      The rainflow context
+ * @param[out] lc       Receives the histogram base address
+ * @param[out] version  Receives the current histogram version (dropped if NULL),
+ *                      see RFC_lc_get_delta()
+ *
+ * @return     true on success
+ */
+bool RFC_lc_view( const void *ctx, const rfc_counts_t **lc, size_t *version )
+{
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !lc )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+    if( !rfc_ctx->lc || !rfc_ctx->class_count )
+    {
+        return false;
+    }
+
+    *lc = rfc_ctx->lc;
+
+    if( version )
+    {
+        *version = rfc_ctx->lc_version;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Get the level crossing bins changed since a version, avoiding
+ *             a full histogram copy on each poll.
+ *
+ *             Every modification bumps the histogram version and stamps the
+ *             bin changed. Pass the version returned by the previous call
+ *             (or 0 for an initial full readout); only bins stamped later
+ *             are copied out as index/counts pairs.
+ *
+ * @param         ctx      The rainflow context
+ * @param[in,out] version  In: last version seen. Out: current version, input
+ *                         for the next poll
+ * @param[out]    index    The buffer for changed bin indices, space for
+ *                         1..class_count values must be preserved!
+ * @param[out]    counts   The buffer for the changed bins' counts, space for
+ *                         1..class_count values must be preserved!
+ * @param[out]    count    Receives the number of changed bins returned
+ *
+ * @return     true on success
+ */
+bool RFC_lc_get_delta( const void *ctx, size_t *version, unsigned *index, rfc_counts_t *counts, unsigned *count )
+{
+    unsigned i, n;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !version || !index || !counts || !count )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+    if( !rfc_ctx->lc || !rfc_ctx->lc_bin_version || !rfc_ctx->class_count )
+    {
+        return false;
+    }
+
+    n = 0;
+    for( i = 0; i < rfc_ctx->class_count; i++ )
+    {
+        if( rfc_ctx->lc_bin_version[i] > *version )
+        {
+            index[n]  = i;
+            counts[n] = rfc_ctx->lc[i];
+            n++;
+        }
+    }
+
+    *count   = n;
+    *version = rfc_ctx->lc_version;
+
+    return true;
+}
+
+
 /**
  * @brief      Create level crossing histogram from rainflow matrix
  *
@@ -2444,7 +6032,43 @@ bool RFC_lc_from_rfm( const void *ctx, rfc_counts_t *lc, rfc_value_t *level, con
     }
 
     class_count = rfc_ctx->class_count;
-    
+
+    if( !rfm && rfc_ctx->rfm_sparse && class_count )
+    {
+        rfc_counts_t factor = ( up ? 1 : 0 ) + ( dn ? 1 : 0 );
+        size_t       j;
+
+        memset( lc, 0, sizeof(rfc_counts_t) * class_count );
+
+        if( level )
+        {
+            /* First index (0) counts crossings of upper class limit of the first class */
+            for( i = 0; i < class_count; i++ )
+            {
+                level[i] = CLASS_UPPER( rfc_ctx, i );
+            }
+        }
+
+        for( j = 0; j < rfc_ctx->rfm_sparse_cap; j++ )
+        {
+            const rfc_rfm_item_s *item  = &rfc_ctx->rfm_sparse[j];
+            unsigned              lower = ( item->from < item->to ) ? item->from : item->to;
+            unsigned              upper = ( item->from > item->to ) ? item->from : item->to;
+
+            if( item->from != (unsigned)-1 && item->counts )
+            {
+                /* One closed cycle has always a rising and a falling slope */
+                for( i = lower; i < upper; i++ )
+                {
+                    assert( lc[i] < RFC_COUNTS_LIMIT - factor * item->counts );
+                    lc[i] += factor * item->counts;
+                }
+            }
+        }
+
+        return true;
+    }
+
     if( !rfm || !class_count )
     {
         return false;
@@ -2452,7 +6076,7 @@ bool RFC_lc_from_rfm( const void *ctx, rfc_counts_t *lc, rfc_value_t *level, con
 
     memset( lc, 0, sizeof(rfc_counts_t) * class_count );
 
-    for( i = 0; i < class_count; i++ ) 
+    for( i = 0; i < class_count; i++ )
     {
         rfc_counts_t sum = 0;
 
@@ -2641,50 +6265,148 @@ bool RFC_lc_from_residue_tuples( const void *ctx, rfc_counts_t* lc, rfc_value_t
 
 
 /**
- * @brief      Get range pair histogram
- *
- * @param      ctx          The rainflow context
- * @param[out] rp           The histogram (counts), .full_inc represent one "cycle", space for 1..class_count values must be preserved!
- * @param[out] Sa           The amplitudes (dropped if NULL, otherwise space for 1..class_count values must be preserved!)
+ * @brief      Get range pair histogram
+ *
+ * @param      ctx          The rainflow context
+ * @param[out] rp           The histogram (counts), .full_inc represent one "cycle", space for 1..class_count values must be preserved!
+ * @param[out] Sa           The amplitudes (dropped if NULL, otherwise space for 1..class_count values must be preserved!)
+ *
+ * @return     true on success
+ */
+bool RFC_rp_get( const void *ctx, rfc_counts_t *rp, rfc_value_t *Sa )
+{
+    unsigned i;
+    unsigned class_count;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !rp )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+    
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+    class_count = rfc_ctx->class_count;
+
+    if( !rfc_ctx->rp || !rp || !class_count )
+    {
+        return false;
+    }
+
+    memset( rp, 0, sizeof(rfc_counts_t) * class_count );
+
+    for( i = 0; i < class_count; i++ )
+    {
+        rp[i] = rfc_ctx->rp[i];
+
+        if( Sa )
+        {
+            Sa[i] = rfc_ctx->class_width * i / 2;  /* range / 2 */
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Get a zero-copy view on the range pair histogram.
+ *
+ *             The returned pointer refers the live histogram, valid until
+ *             RFC_deinit(). Bins change while data is fed, single-threaded
+ *             consumers only!
+ *
+ * @param      ctx      The rainflow context
+ * @param[out] rp       Receives the histogram base address
+ * @param[out] version  Receives the current histogram version (dropped if NULL),
+ *                      see RFC_rp_get_delta()
+ *
+ * @return     true on success
+ */
+bool RFC_rp_view( const void *ctx, const rfc_counts_t **rp, size_t *version )
+{
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !rp )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+    if( !rfc_ctx->rp || !rfc_ctx->class_count )
+    {
+        return false;
+    }
+
+    *rp = rfc_ctx->rp;
+
+    if( version )
+    {
+        *version = rfc_ctx->rp_version;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Get the range pair bins changed since a version, avoiding a
+ *             full histogram copy on each poll, see RFC_lc_get_delta().
+ *
+ * @param         ctx      The rainflow context
+ * @param[in,out] version  In: last version seen (0 for a full readout).
+ *                         Out: current version, input for the next poll
+ * @param[out]    index    The buffer for changed bin indices, space for
+ *                         1..class_count values must be preserved!
+ * @param[out]    counts   The buffer for the changed bins' counts, space for
+ *                         1..class_count values must be preserved!
+ * @param[out]    count    Receives the number of changed bins returned
  *
  * @return     true on success
  */
-bool RFC_rp_get( const void *ctx, rfc_counts_t *rp, rfc_value_t *Sa )
+bool RFC_rp_get_delta( const void *ctx, size_t *version, unsigned *index, rfc_counts_t *counts, unsigned *count )
 {
-    unsigned i;
-    unsigned class_count;
+    unsigned i, n;
 
     RFC_CTX_CHECK_AND_ASSIGN
 
-    if( !rp )
+    if( !version || !index || !counts || !count )
     {
         return error_raise( rfc_ctx, RFC_ERROR_INVARG );
     }
-    
+
     if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
     {
         return false;
     }
 
-    class_count = rfc_ctx->class_count;
-
-    if( !rfc_ctx->rp || !rp || !class_count )
+    if( !rfc_ctx->rp || !rfc_ctx->rp_bin_version || !rfc_ctx->class_count )
     {
         return false;
     }
 
-    memset( rp, 0, sizeof(rfc_counts_t) * class_count );
-
-    for( i = 0; i < class_count; i++ )
+    n = 0;
+    for( i = 0; i < rfc_ctx->class_count; i++ )
     {
-        rp[i] = rfc_ctx->rp[i];
-
-        if( Sa )
+        if( rfc_ctx->rp_bin_version[i] > *version )
         {
-            Sa[i] = rfc_ctx->class_width * i / 2;  /* range / 2 */
+            index[n]  = i;
+            counts[n] = rfc_ctx->rp[i];
+            n++;
         }
     }
 
+    *count   = n;
+    *version = rfc_ctx->rp_version;
+
     return true;
 }
 
@@ -2723,6 +6445,37 @@ bool RFC_rp_from_rfm( const void *ctx, rfc_counts_t *rp, rfc_value_t *Sa, const
 
     class_count = rfc_ctx->class_count;
 
+    if( !rfm && rfc_ctx->rfm_sparse && class_count )
+    {
+        size_t j;
+
+        memset( rp, 0, sizeof(rfc_counts_t) * class_count );
+
+        if( Sa )
+        {
+            for( i = 0; i < class_count; i++ )
+            {
+                Sa[i] = rfc_ctx->class_width * i / 2;  /* range / 2 */
+            }
+        }
+
+        for( j = 0; j < rfc_ctx->rfm_sparse_cap; j++ )
+        {
+            const rfc_rfm_item_s *item = &rfc_ctx->rfm_sparse[j];
+
+            if( item->from != (unsigned)-1 && item->counts )
+            {
+                unsigned range = ( item->from > item->to ) ? ( item->from - item->to ) : ( item->to - item->from );
+
+                /* Count rising and falling slopes */
+                assert( rp[range] < RFC_COUNTS_LIMIT - item->counts );
+                rp[range] += item->counts;
+            }
+        }
+
+        return true;
+    }
+
     if( !rfm || !class_count )
     {
         return false;
@@ -2730,7 +6483,7 @@ bool RFC_rp_from_rfm( const void *ctx, rfc_counts_t *rp, rfc_value_t *Sa, const
 
     memset( rp, 0, sizeof(rfc_counts_t) * class_count );
 
-    for( i = 0; i < class_count; i++ ) 
+    for( i = 0; i < class_count; i++ )
     {
         rfc_counts_t sum = (rfc_counts_t)0;
 
@@ -2922,7 +6675,7 @@ bool RFC_damage_from_rp( const void *ctx, double *damage, const rfc_counts_t *rp
         }
 
         /* Restore WL parameters */
-        RFC_wl_param_set( rfc_ctx, &wl );
+        wl_param_assign( rfc_ctx, &wl );
 
         if( !ok ) return false;
 
@@ -2951,7 +6704,7 @@ bool RFC_damage_from_rp( const void *ctx, double *damage, const rfc_counts_t *rp
         ok = RFC_damage_from_rp( rfc_ctx, damage, rp, Sa, RFC_RP_DAMAGE_CALC_METHOD_DEFAULT );
 #endif /*RFC_DAMAGE_FAST*/
 
-        (void)RFC_wl_param_set( rfc_ctx, &wl );
+        wl_param_assign( rfc_ctx, &wl );
 
         return ok;
     }
@@ -2975,7 +6728,7 @@ bool RFC_damage_from_rp( const void *ctx, double *damage, const rfc_counts_t *rp
         ok = RFC_damage_from_rp( rfc_ctx, damage, rp, Sa, RFC_RP_DAMAGE_CALC_METHOD_DEFAULT );
 #endif /*RFC_DAMAGE_FAST*/
 
-        (void)RFC_wl_param_set( rfc_ctx, &wl );
+        wl_param_assign( rfc_ctx, &wl );
 
         return ok;
     }
@@ -3047,6 +6800,31 @@ bool RFC_damage_from_rfm( const void *ctx, double *damage, const rfc_counts_t *r
 
     class_count = rfc_ctx->class_count;
 
+    if( !rfm && rfc_ctx->rfm_sparse && class_count )
+    {
+        size_t i;
+
+        D = 0.0;
+        for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
+        {
+            const rfc_rfm_item_s *item = &rfc_ctx->rfm_sparse[i];
+
+            if( item->from != (unsigned)-1 && item->counts )
+            {
+                double D_i;
+
+                if( !damage_calc( rfc_ctx, item->from, item->to, &D_i, NULL /*Sa_ret*/ ) )
+                {
+                    return false;
+                }
+                D += D_i * item->counts;
+            }
+        }
+
+        *damage = D / rfc_ctx->full_inc;
+        return true;
+    }
+
     if( !rfm || !class_count )
     {
         return false;
@@ -3075,6 +6853,227 @@ bool RFC_damage_from_rfm( const void *ctx, double *damage, const rfc_counts_t *r
 }
 
 
+/**
+ * @brief      Calculate the damage from a rainflow matrix for a batch of
+ *             Woehler parameter sets. The matrix is collapsed into
+ *             (amplitude, weight) pairs once, zero cells are skipped, then
+ *             each parameter set only pays the pow() bound part on the
+ *             remaining pairs. Without mean load influence all cells
+ *             sharing a range fold into one pair, so a parameter sweep
+ *             costs class_count instead of class_count^2 damage terms.
+ *
+ * @param      ctx             The rainflow context
+ * @param[out] damage          The buffer for cumulated damages, one per parameter set
+ * @param[in]  rfm             The input rainflow matrix to use instead of ctx rfm (may be NULL), .full_inc represents one "cycle"!
+ * @param[in]  wl_param        The Woehler parameter sets
+ * @param      wl_param_count  The number of Woehler parameter sets
+ *
+ * @return     true on success
+ */
+bool RFC_damage_from_rfm_wl( const void *ctx, double *damage, const rfc_counts_t *rfm, const rfc_wl_param_s *wl_param, unsigned wl_param_count )
+{
+    rfc_wl_param_s  wl_shelved;
+    double         *sa_list        = NULL,
+                   *weight_list    = NULL;
+    size_t          entry_cap,
+                    entry_cnt      = 0,
+                    i;
+    unsigned        class_count,
+                    from, to,
+                    wl_i;
+    bool            mean_dependent = false;
+    bool            ok             = true;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !damage || !wl_param || !wl_param_count )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( rfc_ctx->state < RFC_STATE_INIT || rfc_ctx->state > RFC_STATE_FINISHED )
+    {
+        return false;
+    }
+
+    if( !rfm )
+    {
+        rfm = rfc_ctx->rfm;
+    }
+
+    class_count = rfc_ctx->class_count;
+
+    if( ( !rfm && !rfc_ctx->rfm_sparse ) || !class_count )
+    {
+        return false;
+    }
+
+#if RFC_AT_SUPPORT
+    /* With mean load influence cells with equal ranges no longer share
+       their transformed amplitude, keep one pair per non-zero cell then */
+    mean_dependent = rfc_ctx->at.count > 0;
+#if RFC_USE_DELEGATES
+    mean_dependent = mean_dependent || rfc_ctx->at_transform_fcn != NULL;
+#endif /*RFC_USE_DELEGATES*/
+#endif /*RFC_AT_SUPPORT*/
+
+    if( mean_dependent )
+    {
+        entry_cap = 0;
+
+        if( rfm )
+        {
+            for( i = 0; i < (size_t)class_count * class_count; i++ )
+            {
+                if( rfm[i] ) entry_cap++;
+            }
+        }
+        else
+        {
+            for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
+            {
+                const rfc_rfm_item_s *item = &rfc_ctx->rfm_sparse[i];
+
+                if( item->from != (unsigned)-1 && item->counts ) entry_cap++;
+            }
+        }
+
+        if( !entry_cap ) entry_cap = 1;
+    }
+    else
+    {
+        entry_cap = class_count;
+    }
+
+    sa_list = (double*)ctx_mem_alloc( rfc_ctx, NULL, entry_cap * 2, sizeof(double), RFC_MEM_AIM_TEMP );
+
+    if( !sa_list )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+    }
+
+    weight_list = sa_list + entry_cap;
+
+    /* Collapse the matrix, one traversal for the whole parameter sweep */
+    if( !mean_dependent )
+    {
+        /* weight_list is indexed by range here, entries condense below */
+        if( rfm )
+        {
+            for( from = 0; ok && from < class_count; from++ )
+            {
+                for( to = 0; to < class_count; to++ )
+                {
+                    rfc_counts_t counts = rfm[ MAT_OFFS( from, to ) ];
+
+                    if( counts && from != to )
+                    {
+                        weight_list[ abs( (int)from - (int)to ) ] += (double)counts;
+                    }
+                }
+            }
+        }
+        else
+        {
+            for( i = 0; i < rfc_ctx->rfm_sparse_cap; i++ )
+            {
+                const rfc_rfm_item_s *item = &rfc_ctx->rfm_sparse[i];
+
+                if( item->from != (unsigned)-1 && item->counts && item->from != item->to )
+                {
+                    weight_list[ abs( (int)item->from - (int)item->to ) ] += (double)item->counts;
+                }
+            }
+        }
+
+        for( i = 1; i < class_count; i++ )
+        {
+            if( weight_list[i] > 0.0 )
+            {
+                sa_list[entry_cnt]     = (double)i / 2.0 * rfc_ctx->class_width;
+                weight_list[entry_cnt] = weight_list[i];
+                entry_cnt++;
+            }
+        }
+    }
+#if RFC_AT_SUPPORT
+    else
+    {
+        if( rfm )
+        {
+            for( from = 0; ok && from < class_count; from++ )
+            {
+                for( to = 0; ok && to < class_count; to++ )
+                {
+                    rfc_counts_t counts = rfm[ MAT_OFFS( from, to ) ];
+
+                    if( counts && from != to )
+                    {
+                        double Sa_i = fabs( (int)from - (int)to ) / 2.0 * rfc_ctx->class_width;
+                        double Sm_i =     ( (int)from + (int)to ) / 2.0 * rfc_ctx->class_width + rfc_ctx->class_offset;
+                        double Sa;
+
+                        ok = RFC_at_transform( rfc_ctx, Sa_i, Sm_i, &Sa );
+
+                        sa_list[entry_cnt]     = Sa;
+                        weight_list[entry_cnt] = (double)counts;
+                        entry_cnt++;
+                    }
+                }
+            }
+        }
+        else
+        {
+            for( i = 0; ok && i < rfc_ctx->rfm_sparse_cap; i++ )
+            {
+                const rfc_rfm_item_s *item = &rfc_ctx->rfm_sparse[i];
+
+                if( item->from != (unsigned)-1 && item->counts && item->from != item->to )
+                {
+                    double Sa_i = fabs( (int)item->from - (int)item->to ) / 2.0 * rfc_ctx->class_width;
+                    double Sm_i =     ( (int)item->from + (int)item->to ) / 2.0 * rfc_ctx->class_width + rfc_ctx->class_offset;
+                    double Sa;
+
+                    ok = RFC_at_transform( rfc_ctx, Sa_i, Sm_i, &Sa );
+
+                    sa_list[entry_cnt]     = Sa;
+                    weight_list[entry_cnt] = (double)item->counts;
+                    entry_cnt++;
+                }
+            }
+        }
+    }
+#endif /*RFC_AT_SUPPORT*/
+
+    /* Rate the condensed pairs per parameter set; the look-up table is
+       left alone, damage_calc_amplitude() works on the curve directly */
+    (void)RFC_wl_param_get( rfc_ctx, &wl_shelved );
+
+    for( wl_i = 0; ok && wl_i < wl_param_count; wl_i++ )
+    {
+        double D = 0.0;
+
+        wl_param_assign( rfc_ctx, &wl_param[wl_i] );
+
+        for( i = 0; ok && i < entry_cnt; i++ )
+        {
+            double D_i;
+
+            ok = damage_calc_amplitude( rfc_ctx, sa_list[i], &D_i );
+            D += D_i * weight_list[i];
+        }
+
+        damage[wl_i] = D / rfc_ctx->full_inc;
+    }
+
+    wl_param_assign( rfc_ctx, &wl_shelved );
+
+    ctx_mem_alloc( rfc_ctx, sa_list, 0, 0, RFC_MEM_AIM_TEMP );
+
+    return ok;
+}
+
+
 /**
  * @brief      Calculate junction point between k and k2 for a Woehler curve
  *
@@ -3215,49 +7214,206 @@ bool RFC_wl_calc_sa( const void *ctx, double s0, double n0, double k, double n,
     /* (s0/Sa)^-k = n0/n */
     /* (Sa/s0)^k  = n0/n */
 
-    k  = fabs(k);
+    k  = fabs(k);
+
+    if(    s0 <= 0.0    ||    n0 <= 0.0    ||
+           n  <= 0.0    ||   !sa           )
+    {
+        return false;
+    }
+
+    *sa = pow( n0 / n, 1.0 / k ) * s0;
+
+    return true;
+}
+
+
+/**
+ * @brief      Calculate a point on a Woehler slope
+ *
+ * @param      ctx   The rainflow context
+ * @param      s0    Any point on the slope, Sa
+ * @param      n0    Any point on the slope, N
+ * @param      k     The Woehler slope
+ * @param      sa    Given amplitude Sa for required N
+ * @param[out] n     The buffer for N(Sa)
+ *
+ * @return     true on success
+ */
+bool RFC_wl_calc_n( const void *ctx, double s0, double n0, double k, double sa, double *n )
+{
+    /* (Sa/s0)^-k = n/n0 */
+    /* (s0/Sa)^k  = n/n0 */
+
+    k  = fabs(k);
+
+    if(    s0 <= 0.0    ||    n0 <= 0.0    ||
+           sa <= 0.0    ||   !n            )
+    {
+        return false;
+    }
+
+    *n = pow( s0 / sa, k ) * n0;
+
+    return true;
+}
+
+
+#if RFC_DAMAGE_FAST
+/**
+ * @brief      Share the damage look-up table of a given source context.
+ *             Both contexts must agree in class parameters, Woehler curve and
+ *             amplitude transformation, then their tables were element-wise
+ *             identical anyway and calculating them once suffices. The source
+ *             table is completed first, shared tables are immutable from then
+ *             on and ownership is tracked by reference counting. Changing any
+ *             defining parameter on either context detaches it from the
+ *             shared table beforehand.
+ *
+ * @param      ctx      The rainflow context adopting the table, in state RFC_STATE_INIT
+ * @param      ctx_src  The rainflow context donating its table
+ *
+ * @return     true on success
+ */
+bool RFC_damage_lut_share( void *ctx, void *ctx_src )
+{
+    rfc_ctx_s *rfc_ctx_src = (rfc_ctx_s*)ctx_src;
+
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !rfc_ctx_src || rfc_ctx_src->version != sizeof(rfc_ctx_s) || rfc_ctx_src == rfc_ctx )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( rfc_ctx->state != RFC_STATE_INIT ||
+        rfc_ctx_src->state < RFC_STATE_INIT || rfc_ctx_src->state > RFC_STATE_FINISHED )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+    if( !rfc_ctx_src->damage_lut || !rfc_ctx_src->damage_lut_row_valid || rfc_ctx_src->damage_lut_inapt )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_LUT );
+    }
+
+    /* Table memory must be interchangeable between both contexts */
+    if( rfc_ctx->mem_alloc != rfc_ctx_src->mem_alloc )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+#if !RFC_MINIMAL
+    if( rfc_ctx->internal.arena || rfc_ctx_src->internal.arena )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+#endif /*!RFC_MINIMAL*/
+
+    /* Tables agree only for identical class parameters... */
+    if( rfc_ctx->class_count  != rfc_ctx_src->class_count  ||
+        rfc_ctx->class_width  != rfc_ctx_src->class_width  ||
+        rfc_ctx->class_offset != rfc_ctx_src->class_offset )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
 
-    if(    s0 <= 0.0    ||    n0 <= 0.0    ||
-           n  <= 0.0    ||   !sa           )
+    /* ...Woehler curves... */
+    if( rfc_ctx->wl_sx       != rfc_ctx_src->wl_sx ||
+        rfc_ctx->wl_nx       != rfc_ctx_src->wl_nx ||
+        rfc_ctx->wl_k        != rfc_ctx_src->wl_k  )
     {
-        return false;
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+#if !RFC_MINIMAL
+    if( rfc_ctx->wl_q        != rfc_ctx_src->wl_q  ||
+        rfc_ctx->wl_sd       != rfc_ctx_src->wl_sd ||
+        rfc_ctx->wl_nd       != rfc_ctx_src->wl_nd ||
+        rfc_ctx->wl_k2       != rfc_ctx_src->wl_k2 ||
+        rfc_ctx->wl_q2       != rfc_ctx_src->wl_q2 ||
+        rfc_ctx->wl_omission != rfc_ctx_src->wl_omission )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
     }
+#endif /*!RFC_MINIMAL*/
 
-    *sa = pow( n0 / n, 1.0 / k ) * s0;
+#if RFC_AT_SUPPORT
+    /* ...and amplitude transformation */
+    if( rfc_ctx->at.count    != rfc_ctx_src->at.count  ||
+        rfc_ctx->at.M        != rfc_ctx_src->at.M      ||
+        rfc_ctx->at.Sm_rig   != rfc_ctx_src->at.Sm_rig ||
+        rfc_ctx->at.R_rig    != rfc_ctx_src->at.R_rig  ||
+        rfc_ctx->at.R_pinned != rfc_ctx_src->at.R_pinned )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+    else
+    {
+        unsigned i;
 
-    return true;
-}
+        for( i = 0; i < rfc_ctx->at.count; i++ )
+        {
+            if( rfc_ctx->at.Sa[i] != rfc_ctx_src->at.Sa[i] ||
+                rfc_ctx->at.Sm[i] != rfc_ctx_src->at.Sm[i] )
+            {
+                return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+            }
+        }
+    }
+#endif /*RFC_AT_SUPPORT*/
 
+#if RFC_USE_DELEGATES
+    if( rfc_ctx->damage_calc_fcn  != rfc_ctx_src->damage_calc_fcn
+#if RFC_AT_SUPPORT
+     || rfc_ctx->at_transform_fcn != rfc_ctx_src->at_transform_fcn
+#endif /*RFC_AT_SUPPORT*/
+      )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+#endif /*RFC_USE_DELEGATES*/
 
-/**
- * @brief      Calculate a point on a Woehler slope
- *
- * @param      ctx   The rainflow context
- * @param      s0    Any point on the slope, Sa
- * @param      n0    Any point on the slope, N
- * @param      k     The Woehler slope
- * @param      sa    Given amplitude Sa for required N
- * @param[out] n     The buffer for N(Sa)
- *
- * @return     true on success
- */
-bool RFC_wl_calc_n( const void *ctx, double s0, double n0, double k, double sa, double *n )
-{
-    /* (Sa/s0)^-k = n/n0 */
-    /* (s0/Sa)^k  = n/n0 */
+    /* Shared tables are immutable, complete the source table beforehand */
+    if( !damage_lut_fill_all( rfc_ctx_src ) )
+    {
+        return error_raise( rfc_ctx, ( rfc_ctx_src->error != RFC_ERROR_NOERROR ) ? rfc_ctx_src->error : RFC_ERROR_UNEXP );
+    }
 
-    k  = fabs(k);
+    if( !rfc_ctx_src->damage_lut_refcnt )
+    {
+        rfc_ctx_src->damage_lut_refcnt = (size_t*)ctx_mem_alloc( rfc_ctx_src, NULL, 1, sizeof(size_t), RFC_MEM_AIM_DLUT );
 
-    if(    s0 <= 0.0    ||    n0 <= 0.0    ||
-           sa <= 0.0    ||   !n            )
+        if( !rfc_ctx_src->damage_lut_refcnt )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+        }
+        *rfc_ctx_src->damage_lut_refcnt = 1;
+    }
+
+    /* Release own tables... */
+    if( !damage_lut_detach( rfc_ctx ) )
     {
         return false;
     }
+    if( rfc_ctx->damage_lut )           ctx_mem_alloc( rfc_ctx, rfc_ctx->damage_lut,           0, 0, RFC_MEM_AIM_DLUT );
+    if( rfc_ctx->damage_lut_row_valid ) ctx_mem_alloc( rfc_ctx, rfc_ctx->damage_lut_row_valid, 0, 0, RFC_MEM_AIM_DLUT );
+#if RFC_AT_SUPPORT
+    if( rfc_ctx->amplitude_lut )        ctx_mem_alloc( rfc_ctx, rfc_ctx->amplitude_lut,        0, 0, RFC_MEM_AIM_ALUT );
+#endif /*RFC_AT_SUPPORT*/
 
-    *n = pow( s0 / sa, k ) * n0;
+    /* ...and adopt the shared ones */
+    rfc_ctx->damage_lut           = rfc_ctx_src->damage_lut;
+    rfc_ctx->damage_lut_row_valid = rfc_ctx_src->damage_lut_row_valid;
+#if RFC_AT_SUPPORT
+    rfc_ctx->amplitude_lut        = rfc_ctx_src->amplitude_lut;
+#endif /*RFC_AT_SUPPORT*/
+    rfc_ctx->damage_lut_inapt     = 0;
+    rfc_ctx->damage_lut_refcnt    = rfc_ctx_src->damage_lut_refcnt;
+
+    (*rfc_ctx->damage_lut_refcnt)++;
 
     return true;
 }
+#endif /*RFC_DAMAGE_FAST*/
 
 
 /**
@@ -3267,7 +7423,7 @@ bool RFC_wl_calc_n( const void *ctx, double s0, double n0, double k, double sa,
  * @param[in]  class_param  The new class parameter
  *
  * @return     true on success
- * 
+ *
  * @note       Changing class parameters invalidate look-up tables!
  */
 bool RFC_class_param_set( void *ctx, const rfc_class_param_s *class_param )
@@ -3657,15 +7813,40 @@ bool RFC_wl_param_set( void *ctx, const rfc_wl_param_s *wl_param )
         return error_raise( rfc_ctx, RFC_ERROR_INVARG );
     }
 
-    rfc_ctx->wl_sx          = wl_param->sx;
-    rfc_ctx->wl_nx          = wl_param->nx;
-    rfc_ctx->wl_k           = wl_param->k;
-    rfc_ctx->wl_q           = wl_param->q;
-    rfc_ctx->wl_sd          = wl_param->sd;
-    rfc_ctx->wl_nd          = wl_param->nd;
-    rfc_ctx->wl_k2          = wl_param->k2;
-    rfc_ctx->wl_q2          = wl_param->q2;
-    rfc_ctx->wl_omission    = wl_param->omission;
+#if RFC_DAMAGE_FAST
+    /* The damage look-up table bases on the Woehler curve and must follow
+       suit, so cycles closing after the change keep accruing .damage
+       incrementally at look-up speed instead of using a stale table.
+       Rebuild only, if the parameters really change. */
+    if( rfc_ctx->damage_lut           &&
+        ( rfc_ctx->wl_sx       != wl_param->sx ||
+          rfc_ctx->wl_nx       != wl_param->nx ||
+          rfc_ctx->wl_k        != wl_param->k  ||
+          rfc_ctx->wl_q        != wl_param->q  ||
+          rfc_ctx->wl_sd       != wl_param->sd ||
+          rfc_ctx->wl_nd       != wl_param->nd ||
+          rfc_ctx->wl_k2       != wl_param->k2 ||
+          rfc_ctx->wl_q2       != wl_param->q2 ||
+          rfc_ctx->wl_omission != wl_param->omission ) )
+    {
+        rfc_state_e old_state = rfc_ctx->state;
+
+        wl_param_assign( rfc_ctx, wl_param );
+
+        rfc_ctx->damage_lut_inapt++;
+        rfc_ctx->state = RFC_STATE_INIT;
+        if( !damage_lut_init( rfc_ctx ) )
+        {
+            rfc_ctx->state = old_state;
+            return false;
+        }
+        rfc_ctx->state = old_state;
+
+        return true;
+    }
+#endif /*RFC_DAMAGE_FAST*/
+
+    wl_param_assign( rfc_ctx, wl_param );
 
     return true;
 }
@@ -3725,15 +7906,13 @@ bool RFC_wl_param_get( const void *ctx, rfc_wl_param_s *wl_param )
  */
 bool RFC_at_transform( const void *ctx, double Sa, double Sm, double *Sa_transformed )
 {
-    double Sa_transform = Sa;
-
     RFC_CTX_CHECK_AND_ASSIGN
 
     if( !Sa_transformed )
     {
         return error_raise( rfc_ctx, RFC_ERROR_INVARG );
     }
-    
+
     /* Amplitude is always positive */
     Sa = fabs( Sa );
 
@@ -3751,6 +7930,105 @@ bool RFC_at_transform( const void *ctx, double Sa, double Sm, double *Sa_transfo
         return true;
     }
 
+    if( rfc_ctx->at_lut.grid && at_lut_interpolate( rfc_ctx, Sa, Sm, Sa_transformed ) )
+    {
+        return true;
+    }
+
+    return at_transform_exact( rfc_ctx, Sa, Sm, Sa_transformed );
+}
+
+
+/**
+ * @brief      Amplitude transformation for a batch of cycles, e.g. a whole
+ *             residue or rainflow matrix readout. Equivalent to calling
+ *             RFC_at_transform() per element, but resolves the reference
+ *             curve only once and keeps the grid look-up (see
+ *             RFC_at_lut_init()) in a tight, vectorizable loop.
+ *
+ * @param      ctx             The rainflow context
+ * @param      Sa              Amplitudes, count elements
+ * @param      Sm              Mean loads, count elements
+ * @param[out] Sa_transformed  Transformed amplitudes, count elements
+ * @param      count           Number of elements
+ *
+ * @return     true on success
+ */
+bool RFC_at_transform_batch( const void *ctx, const double *Sa, const double *Sm, double *Sa_transformed, size_t count )
+{
+    size_t i;
+    RFC_CTX_CHECK_AND_ASSIGN
+
+    if( !Sa || !Sm || !Sa_transformed )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+    }
+
+#if RFC_USE_DELEGATES
+    if( rfc_ctx->at_transform_fcn )
+    {
+        for( i = 0; i < count; i++ )
+        {
+            if( !rfc_ctx->at_transform_fcn( rfc_ctx, fabs( Sa[i] ), Sm[i], &Sa_transformed[i] ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+#endif /*RFC_USE_DELEGATES*/
+
+    if( !rfc_ctx->at.count )
+    {
+        /* No reference curve given, return original amplitudes */
+        for( i = 0; i < count; i++ )
+        {
+            Sa_transformed[i] = fabs( Sa[i] );
+        }
+
+        return true;
+    }
+
+    for( i = 0; i < count; i++ )
+    {
+        double Sa_i = fabs( Sa[i] );
+
+        if( rfc_ctx->at_lut.grid && at_lut_interpolate( rfc_ctx, Sa_i, Sm[i], &Sa_transformed[i] ) )
+        {
+            continue;
+        }
+
+        if( !at_transform_exact( rfc_ctx, Sa_i, Sm[i], &Sa_transformed[i] ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif /*RFC_AT_SUPPORT*/
+
+#if RFC_AT_SUPPORT
+/**
+ * @brief      Exact amplitude transformation, piecewise interpolation over
+ *             the Haigh diagram reference curve. Only called with a reference
+ *             curve in place (at.count > 0) and Sa >= 0.
+ *
+ * @param      rfc_ctx         The rainflow context
+ * @param      Sa              Amplitude (absolute value)
+ * @param      Sm              Mean load
+ * @param[out] Sa_transformed  Transformed amplitude Sa
+ *
+ * @return     true on success
+ */
+static
+bool at_transform_exact( rfc_ctx_s *rfc_ctx, double Sa, double Sm, double *Sa_transformed )
+{
+    double Sa_transform = Sa;
+
+    assert( rfc_ctx && Sa_transformed && rfc_ctx->at.count );
+
     if( Sa == 0.0 )
     {
         /* Zero amplitude */
@@ -3932,18 +8210,26 @@ void clear_lut( rfc_ctx_s *rfc_ctx )
 {
     assert( rfc_ctx && rfc_ctx->state >= RFC_STATE_INIT );
 
-    if( rfc_ctx->damage_lut )
+    /* Shared tables (see RFC_damage_lut_share()) are immutable, .damage_lut_inapt
+       alone pulls this context off the table then */
+    if( !rfc_ctx->damage_lut_refcnt )
     {
-        memset( rfc_ctx->damage_lut, 0, sizeof(double) * rfc_ctx->class_count * rfc_ctx->class_count );
-    }
-    rfc_ctx->damage_lut_inapt = 1;
-
+        if( rfc_ctx->damage_lut )
+        {
+            memset( rfc_ctx->damage_lut, 0, sizeof(double) * rfc_ctx->class_count * rfc_ctx->class_count );
+        }
+        if( rfc_ctx->damage_lut_row_valid )
+        {
+            memset( rfc_ctx->damage_lut_row_valid, 0, rfc_ctx->class_count );
+        }
 #if RFC_AT_SUPPORT
-    if( rfc_ctx->amplitude_lut )
-    {
-        memset( rfc_ctx->amplitude_lut, 0, sizeof(double) * rfc_ctx->class_count * rfc_ctx->class_count );
-    }
+        if( rfc_ctx->amplitude_lut )
+        {
+            memset( rfc_ctx->amplitude_lut, 0, sizeof(double) * rfc_ctx->class_count * rfc_ctx->class_count );
+        }
 #endif /*RFC_AT_SUPPORT*/
+    }
+    rfc_ctx->damage_lut_inapt = 1;
 }
 #endif /*RFC_DH_SUPPORT*/
 
@@ -3989,9 +8275,15 @@ bool autoresize( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s* pt )
     {
         rfc_state_e old_state = rfc_ctx->state;
 
+        /* A shared table must not be resized in place, recede to an exclusive one first */
+        if( !damage_lut_detach( rfc_ctx ) )
+        {
+            return false;
+        }
+
         if( rfc_ctx->damage_lut )
         {
-            ptr = rfc_ctx->mem_alloc( rfc_ctx->damage_lut, class_count * class_count, 
+            ptr = ctx_mem_alloc( rfc_ctx, rfc_ctx->damage_lut, class_count * class_count,
                                       sizeof(double), RFC_MEM_AIM_DLUT );
             if( !ptr )
             {
@@ -4005,10 +8297,25 @@ bool autoresize( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s* pt )
             }
         }
 
+        if( rfc_ctx->damage_lut_row_valid )
+        {
+            ptr = ctx_mem_alloc( rfc_ctx, rfc_ctx->damage_lut_row_valid, class_count,
+                                      sizeof(unsigned char), RFC_MEM_AIM_DLUT );
+            if( !ptr )
+            {
+                rfc_ctx->state = old_state;
+                return false;
+            }
+            else
+            {
+                rfc_ctx->damage_lut_row_valid = (unsigned char*)ptr;
+            }
+        }
+
 #if RFC_AT_SUPPORT
         if( rfc_ctx->amplitude_lut )
         {
-            ptr = rfc_ctx->mem_alloc( rfc_ctx->amplitude_lut, class_count * class_count, 
+            ptr = ctx_mem_alloc( rfc_ctx, rfc_ctx->amplitude_lut, class_count * class_count, 
                                       sizeof(double), RFC_MEM_AIM_ALUT );
             if( !ptr )
             {
@@ -4032,7 +8339,7 @@ bool autoresize( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s* pt )
     {
         size_t residue_cap = 2 * class_count + 1;
 
-        ptr = rfc_ctx->mem_alloc( rfc_ctx->residue, residue_cap, 
+        ptr = ctx_mem_alloc( rfc_ctx, rfc_ctx->residue, residue_cap, 
                                   sizeof( rfc_value_tuple_s ), RFC_MEM_AIM_RESIDUE );
 
         if( !ptr )
@@ -4058,7 +8365,7 @@ bool autoresize( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s* pt )
     /* RFM */
     if( rfc_ctx->rfm )
     {
-        ptr = rfc_ctx->mem_alloc( NULL, class_count * class_count, 
+        ptr = ctx_mem_alloc( rfc_ctx, NULL, class_count * class_count, 
                                   sizeof(rfc_counts_t), RFC_MEM_AIM_MATRIX );    
         if( !ptr )
         {
@@ -4078,15 +8385,55 @@ bool autoresize( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s* pt )
 
             ptr = rfc_ctx->rfm;
             rfc_ctx->rfm = rfm;
-            rfc_ctx->mem_alloc( ptr, 0, 0, RFC_MEM_AIM_MATRIX );
+            ctx_mem_alloc( rfc_ctx, ptr, 0, 0, RFC_MEM_AIM_MATRIX );
+        }
+    }
+
+#if !RFC_MINIMAL
+    /* Sparse RFM, class keys shift along with the class offset, the table must be rebuilt */
+    if( rfc_ctx->rfm_sparse && class_shift )
+    {
+        rfc_rfm_item_s *table_old = rfc_ctx->rfm_sparse;
+        size_t          cap_old   = rfc_ctx->rfm_sparse_cap;
+
+        ptr = ctx_mem_alloc( rfc_ctx, NULL, cap_old, sizeof(rfc_rfm_item_s), RFC_MEM_AIM_RFM_ELEMENTS );
+
+        if( !ptr )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+        }
+        else
+        {
+            rfc_ctx->rfm_sparse     = (rfc_rfm_item_s*)ptr;
+            rfc_ctx->rfm_sparse_cnt = 0;
+
+            for( i = 0; i < cap_old; i++ )
+            {
+                rfc_ctx->rfm_sparse[i].from = (unsigned)-1;
+            }
+
+            for( i = 0; i < cap_old; i++ )
+            {
+                if( table_old[i].from != (unsigned)-1 )
+                {
+                    rfc_counts_t *counts = rfm_sparse_at( rfc_ctx, table_old[i].from + class_shift,
+                                                                   table_old[i].to   + class_shift, /*insert*/ true );
+
+                    assert( counts );
+                    *counts = table_old[i].counts;
+                }
+            }
+
+            ctx_mem_alloc( rfc_ctx, table_old, 0, 0, RFC_MEM_AIM_RFM_ELEMENTS );
         }
     }
+#endif /*!RFC_MINIMAL*/
 
 #if !RFC_MINIMAL
     /* LC */
     if( rfc_ctx->lc )
     {
-        ptr = rfc_ctx->mem_alloc( NULL, class_count,
+        ptr = ctx_mem_alloc( rfc_ctx, NULL, class_count,
                                   sizeof(rfc_counts_t), RFC_MEM_AIM_LC );
         if( !ptr )
         {
@@ -4103,11 +8450,11 @@ bool autoresize( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s* pt )
 
             ptr = rfc_ctx->lc;
             rfc_ctx->lc = lc;
-            rfc_ctx->mem_alloc( ptr, 0, 0, RFC_MEM_AIM_LC );
+            ctx_mem_alloc( rfc_ctx, ptr, 0, 0, RFC_MEM_AIM_LC );
         }
 
         /* RP */
-        ptr = rfc_ctx->mem_alloc( NULL, class_count,
+        ptr = ctx_mem_alloc( rfc_ctx, NULL, class_count,
                                   sizeof(rfc_counts_t), RFC_MEM_AIM_RP );
         if( !ptr )
         {
@@ -4115,21 +8462,62 @@ bool autoresize( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s* pt )
         }
         else
         {
-            rfc_counts_t* rp = (rfc_counts_t*)ptr;
+            rfc_counts_t* rp = (rfc_counts_t*)ptr;
+
+            for( i = 0; i < class_count_old; i++ )
+            {
+                rp[i] = rfc_ctx->rp[i];
+            }
+
+            ptr = rfc_ctx->rp;
+            rfc_ctx->rp = rp;
+            ctx_mem_alloc( rfc_ctx, ptr, 0, 0, RFC_MEM_AIM_RP );
+        }
+
+        /* The class grid changed, all bins are new to delta readers */
+        if( rfc_ctx->lc_bin_version )
+        {
+            ptr = ctx_mem_alloc( rfc_ctx, rfc_ctx->lc_bin_version, class_count, sizeof(size_t), RFC_MEM_AIM_LC );
+
+            if( !ptr )
+            {
+                return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+            }
+
+            rfc_ctx->lc_bin_version = (size_t*)ptr;
+            rfc_ctx->lc_version++;
+            for( i = 0; i < class_count; i++ )
+            {
+                rfc_ctx->lc_bin_version[i] = rfc_ctx->lc_version;
+            }
+        }
+
+        if( rfc_ctx->rp_bin_version )
+        {
+            ptr = ctx_mem_alloc( rfc_ctx, rfc_ctx->rp_bin_version, class_count, sizeof(size_t), RFC_MEM_AIM_RP );
 
-            for( i = 0; i < class_count_old; i++ )
+            if( !ptr )
             {
-                rp[i] = rfc_ctx->rp[i];
+                return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
             }
 
-            ptr = rfc_ctx->rp;
-            rfc_ctx->rp = rp;
-            rfc_ctx->mem_alloc( ptr, 0, 0, RFC_MEM_AIM_RP );
+            rfc_ctx->rp_bin_version = (size_t*)ptr;
+            rfc_ctx->rp_version++;
+            for( i = 0; i < class_count; i++ )
+            {
+                rfc_ctx->rp_bin_version[i] = rfc_ctx->rp_version;
+            }
         }
     }
 #endif /*!RFC_MINIMAL*/
 
 #if RFC_TP_SUPPORT
+    /* Settle a pending incremental compaction, turning points are requantized in storage order */
+    if( rfc_ctx->internal.tp_prune_removal )
+    {
+        tp_prune_inc_step( rfc_ctx, (size_t)-1 );
+    }
+
     for( i = 0; i < rfc_ctx->tp_cnt + ( rfc_ctx->state == RFC_STATE_BUSY_INTERIM ); i++ )
     {
 #if RFC_USE_DELEGATES
@@ -4157,9 +8545,34 @@ bool autoresize( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s* pt )
 #endif /*RFC_GLOBAL_EXTREMA*/
 
 #if RFC_HCM_SUPPORT
-    for( i = 0; i < rfc_ctx->internal.hcm.stack_cap; i++ )
+    if( rfc_ctx->internal.hcm.stack )
     {
-        rfc_ctx->internal.hcm.stack[i].cls = QUANTIZE( rfc_ctx, rfc_ctx->internal.hcm.stack[i].value );
+        size_t stack_cap = 2 * (size_t)class_count + 1;
+
+        if( rfc_ctx->internal.hcm.stack_cap < stack_cap )
+        {
+            /* A static stack cannot grow, see RFC_hcm_init() */
+            if( rfc_ctx->internal.hcm.stack_static )
+            {
+                return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+            }
+
+            ptr = ctx_mem_alloc( rfc_ctx, rfc_ctx->internal.hcm.stack, stack_cap,
+                                      sizeof(rfc_value_tuple_s), RFC_MEM_AIM_HCM );
+            if( !ptr )
+            {
+                return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+            }
+
+            rfc_ctx->internal.hcm.stack     = (rfc_value_tuple_s*)ptr;
+            rfc_ctx->internal.hcm.stack_cap = stack_cap;
+        }
+
+        /* Stack holds hcm.IZ turning points (base 1) */
+        for( i = 0; i < (size_t)rfc_ctx->internal.hcm.IZ; i++ )
+        {
+            rfc_ctx->internal.hcm.stack[i].cls = QUANTIZE( rfc_ctx, rfc_ctx->internal.hcm.stack[i].value );
+        }
     }
 #endif /*RFC_HCM_SUPPORT*/
 
@@ -4187,6 +8600,10 @@ bool feed_once( rfc_ctx_s *rfc_ctx, const rfc_value_tuple_s* pt, rfc_flags_e fla
     assert( rfc_ctx && pt );
     assert( rfc_ctx->state >= RFC_STATE_INIT && rfc_ctx->state < RFC_STATE_FINISHED );
 
+#if RFC_STATS_SUPPORT
+    rfc_ctx->internal.stats.samples_fed++;
+#endif /*RFC_STATS_SUPPORT*/
+
 #if RFC_DH_SUPPORT
     /* Resize damage history if necessary */
     if( !feed_once_dh( rfc_ctx, pt ) )
@@ -4207,11 +8624,32 @@ bool feed_once( rfc_ctx_s *rfc_ctx, const rfc_value_tuple_s* pt, rfc_flags_e fla
     }
 #endif /*RFC_TP_SUPPORT*/
 
+#if !RFC_MINIMAL
+    /* Forward the settled turning point to attached follower contexts */
+    if( tp_residue && rfc_ctx->follower_cnt )
+    {
+        /* cycle_find() modifies the residue, forward a copy */
+        rfc_value_tuple_s pt_follow = *tp_residue;
+
+        if( !feed_once_followers( rfc_ctx, &pt_follow ) )
+        {
+            return false;
+        }
+    }
+#endif /*!RFC_MINIMAL*/
+
     /* Countings */
 
     /* Add turning point and check for closed cycles */
     if( tp_residue )
     {
+#if RFC_STATS_SUPPORT
+        rfc_ctx->internal.stats.tp_emitted++;
+        if( rfc_ctx->residue_cnt > rfc_ctx->internal.stats.residue_depth_max )
+        {
+            rfc_ctx->internal.stats.residue_depth_max = rfc_ctx->residue_cnt;
+        }
+#endif /*RFC_STATS_SUPPORT*/
 #if RFC_TP_SUPPORT
         /* Add a copy of tp_residue to rfc_ctx->tp and alter tp_residue->tp_pos to its position in rfc_ctx->tp */
         if( !tp_set( rfc_ctx, 0, tp_residue ) )
@@ -4244,6 +8682,71 @@ bool feed_once( rfc_ctx_s *rfc_ctx, const rfc_value_tuple_s* pt, rfc_flags_e fla
 }
 
 
+#if !RFC_MINIMAL
+/**
+ * @brief      Forward a settled turning point to the attached follower
+ *             contexts, see RFC_ctx_attach(). Each follower quantizes the
+ *             point on its own class grid and runs its own counting.
+ *
+ * @param      rfc_ctx  The rainflow context (leader)
+ * @param[in]  pt       The data tuple
+ *
+ * @return     true on success
+ */
+static
+bool feed_once_followers( rfc_ctx_s *rfc_ctx, const rfc_value_tuple_s* pt )
+{
+    unsigned i;
+
+    assert( rfc_ctx );
+    assert( pt );
+
+    for( i = 0; i < rfc_ctx->follower_cnt; i++ )
+    {
+        rfc_ctx_s        *follower = rfc_ctx->followers[i];
+        rfc_value_tuple_s tp       = { pt->value };  /* All other members are zero-initialized, see ISO/IEC 9899:TC3, 6.7.8 (21) */
+
+        if( follower->state < RFC_STATE_INIT || follower->state >= RFC_STATE_FINISHED )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_INVARG );
+        }
+
+        /* Requantize on the follower grid, stream positions follow the leader */
+        tp.pos = pt->pos;
+        tp.cls = QUANTIZE( follower, tp.value );
+
+        if( follower->class_count && ( tp.cls >= follower->class_count || tp.value < follower->class_offset ) )
+        {
+#if !RFC_AR_SUPPORT
+            (void)error_raise( follower, RFC_ERROR_DATA_OUT_OF_RANGE );
+            return error_raise( rfc_ctx, RFC_ERROR_DATA_OUT_OF_RANGE );
+#else
+            if( !RFC_flags_check( follower, RFC_FLAGS_AUTORESIZE, 0 ) )
+            {
+                (void)error_raise( follower, RFC_ERROR_DATA_OUT_OF_RANGE );
+                return error_raise( rfc_ctx, RFC_ERROR_DATA_OUT_OF_RANGE );
+            }
+
+            if( !autoresize( follower, &tp ) )
+            {
+                return error_raise( rfc_ctx, ( follower->error != RFC_ERROR_NOERROR ) ? follower->error : RFC_ERROR_UNEXP );
+            }
+#endif /*RFC_AR_SUPPORT*/
+        }
+
+        follower->internal.pos = tp.pos;
+
+        if( !feed_once( follower, &tp, follower->internal.flags ) )
+        {
+            return error_raise( rfc_ctx, ( follower->error != RFC_ERROR_NOERROR ) ? follower->error : RFC_ERROR_UNEXP );
+        }
+    }
+
+    return true;
+}
+#endif /*!RFC_MINIMAL*/
+
+
 #if RFC_DH_SUPPORT
 /**
  * @brief      Resize damage history if necessary.
@@ -4266,7 +8769,7 @@ bool feed_once_dh( rfc_ctx_s *rfc_ctx, const rfc_value_tuple_s* pt )
         {
             size_t new_cap = (size_t)1024 * ( pt->pos / 640 + 1 ); /* + 60% + 1024 */
 
-            rfc_ctx->dh = (double*)rfc_ctx->mem_alloc( rfc_ctx->dh, new_cap, 
+            rfc_ctx->dh = (double*)ctx_mem_alloc( rfc_ctx, rfc_ctx->dh, new_cap, 
                                                        sizeof(rfc_value_t), RFC_MEM_AIM_DH );
 
             if( !rfc_ctx->dh )
@@ -4280,6 +8783,103 @@ bool feed_once_dh( rfc_ctx_s *rfc_ctx, const rfc_value_tuple_s* pt )
 
         rfc_ctx->dh_cnt = pt->pos;
     }
+    else if( rfc_ctx->dh_sparse )
+    {
+        /* Sparse storage grows on damage accrual only, just track the stream length */
+        rfc_ctx->dh_cnt = pt->pos;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Account a damage portion to one position of the damage history
+ *
+ *             Dense storage adds in place, sparse storage merges the portion
+ *             into its position ordered item list. Without damage history
+ *             storage attached the portion is dropped.
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param[in]  pos_0    Stream position, base 0
+ * @param[in]  damage   Damage portion to add
+ *
+ * @return     true on success
+ */
+static
+bool dh_add( rfc_ctx_s *rfc_ctx, size_t pos_0, double damage )
+{
+    rfc_dh_item_s *item;
+    size_t         lo;
+
+    assert( rfc_ctx );
+
+    if( rfc_ctx->dh )
+    {
+        rfc_ctx->dh[ pos_0 ] += damage;
+        return true;
+    }
+
+    if( !rfc_ctx->dh_sparse )
+    {
+        return true;
+    }
+
+    /* Fast path: cycles close in stream order, so appending dominates */
+    lo = rfc_ctx->dh_sparse_cnt;
+
+    if( lo && rfc_ctx->dh_sparse[lo - 1].pos >= pos_0 )
+    {
+        /* Find the leftmost item with .pos >= pos_0 */
+        size_t hi = lo;
+
+        lo = 0;
+
+        while( lo < hi )
+        {
+            size_t mid = lo + ( hi - lo ) / 2;
+
+            if( rfc_ctx->dh_sparse[mid].pos < pos_0 )
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+
+        if( rfc_ctx->dh_sparse[lo].pos == pos_0 )
+        {
+            rfc_ctx->dh_sparse[lo].damage += damage;
+            return true;
+        }
+    }
+
+    if( rfc_ctx->dh_sparse_cnt == rfc_ctx->dh_sparse_cap )
+    {
+        size_t         new_cap = rfc_ctx->dh_sparse_cap * 2;
+        rfc_dh_item_s *new_ptr = (rfc_dh_item_s*)ctx_mem_alloc( rfc_ctx, rfc_ctx->dh_sparse, new_cap,
+                                                                     sizeof(rfc_dh_item_s), RFC_MEM_AIM_DH );
+        if( !new_ptr )
+        {
+            return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+        }
+
+        rfc_ctx->dh_sparse     = new_ptr;
+        rfc_ctx->dh_sparse_cap = new_cap;
+    }
+
+    item = &rfc_ctx->dh_sparse[lo];
+
+    if( lo < rfc_ctx->dh_sparse_cnt )
+    {
+        memmove( item + 1, item, ( rfc_ctx->dh_sparse_cnt - lo ) * sizeof(rfc_dh_item_s) );
+    }
+
+    item->pos    = pos_0;
+    item->damage = damage;
+    rfc_ctx->dh_sparse_cnt++;
 
     return true;
 }
@@ -4451,7 +9051,13 @@ bool feed_finalize_tp( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s *tp_interim, rfc_fl
 
     assert( rfc_ctx );
     assert( rfc_ctx->state >= RFC_STATE_INIT && rfc_ctx->state < RFC_STATE_FINISHED );
-    
+
+    /* Storage must be compact before it gets locked, see tp_prune_inc_start() */
+    if( rfc_ctx->internal.tp_prune_removal )
+    {
+        tp_prune_inc_step( rfc_ctx, (size_t)-1 );
+    }
+
     /* Finalize turning points storage */
     do_margin = rfc_ctx->internal.flags & RFC_FLAGS_ENFORCE_MARGIN;
     if( do_margin && !rfc_ctx->tp_locked )
@@ -4511,7 +9117,7 @@ bool feed_finalize_hcm( rfc_ctx_s *rfc_ctx, rfc_flags_e flags )
         if( stack_cnt )
         {
             /* Reallocate residue */
-            rfc_ctx->residue = (rfc_value_tuple_s*)rfc_ctx->mem_alloc( rfc_ctx->residue, (size_t)stack_cnt, 
+            rfc_ctx->residue = (rfc_value_tuple_s*)ctx_mem_alloc( rfc_ctx, rfc_ctx->residue, (size_t)stack_cnt, 
                                                                        sizeof(rfc_value_tuple_s), RFC_MEM_AIM_RESIDUE );
 
             if( !rfc_ctx->residue )
@@ -4742,7 +9348,7 @@ bool finalize_res_rp_DIN45667( rfc_ctx_s *rfc_ctx, rfc_flags_e flags )
             rfc_value_tuple_s *rhs;
         } *slopes, tmp;
 
-        slopes = (struct slopes*)rfc_ctx->mem_alloc( NULL, slopes_cnt, sizeof( slopes[0] ), RFC_MEM_AIM_TEMP );
+        slopes = (struct slopes*)ctx_mem_alloc( rfc_ctx, NULL, slopes_cnt, sizeof( slopes[0] ), RFC_MEM_AIM_TEMP );
 
         if( !slopes )
         {
@@ -4807,7 +9413,7 @@ bool finalize_res_rp_DIN45667( rfc_ctx_s *rfc_ctx, rfc_flags_e flags )
             cycle_process_counts( rfc_ctx, slopes[j].lhs, slopes[j].rhs, NULL, flags );
         }
 
-        rfc_ctx->mem_alloc( slopes, 0, 0, RFC_MEM_AIM_TEMP );
+        ctx_mem_alloc( rfc_ctx, slopes, 0, 0, RFC_MEM_AIM_TEMP );
     }
 
     /* Empty residue */
@@ -4836,7 +9442,7 @@ bool finalize_res_repeated( rfc_ctx_s *rfc_ctx, rfc_flags_e flags )
     {
         /* Feed again with the content of the residue itself */
         size_t              cnt     = rfc_ctx->residue_cnt;
-        rfc_value_tuple_s  *residue = (rfc_value_tuple_s*)rfc_ctx->mem_alloc( NULL, cnt + 1, 
+        rfc_value_tuple_s  *residue = (rfc_value_tuple_s*)ctx_mem_alloc( rfc_ctx, NULL, cnt + 1, 
                                                                               sizeof(rfc_value_tuple_s), RFC_MEM_AIM_TEMP );
 
         if( rfc_ctx->state == RFC_STATE_BUSY_INTERIM )
@@ -4928,7 +9534,7 @@ bool finalize_res_repeated( rfc_ctx_s *rfc_ctx, rfc_flags_e flags )
             rfc_ctx->internal.flags = old_flags;
 
             /* Free temporary residue */
-            rfc_ctx->mem_alloc( residue, 0, 0, RFC_MEM_AIM_TEMP );
+            ctx_mem_alloc( rfc_ctx, residue, 0, 0, RFC_MEM_AIM_TEMP );
 
             if( !ok )
             {
@@ -4974,7 +9580,7 @@ bool residue_exchange( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s **residue, size_t *
         /* Backup */
         *residue_cap = rfc_ctx->residue_cap;
         *residue_cnt = rfc_ctx->residue_cnt;
-        *residue     = (rfc_value_tuple_s*)rfc_ctx->mem_alloc( NULL, *residue_cap, 
+        *residue     = (rfc_value_tuple_s*)ctx_mem_alloc( rfc_ctx, NULL, *residue_cap, 
                                                                sizeof(rfc_value_tuple_s), RFC_MEM_AIM_TEMP );
 
         if( !*residue )
@@ -4989,7 +9595,7 @@ bool residue_exchange( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s **residue, size_t *
         /* Restore */
 
         /* Release residue */
-        (rfc_value_tuple_s*)rfc_ctx->mem_alloc( rfc_ctx->residue, /*num*/ 0, /*size*/ 0, RFC_MEM_AIM_TEMP );
+        (rfc_value_tuple_s*)ctx_mem_alloc( rfc_ctx, rfc_ctx->residue, /*num*/ 0, /*size*/ 0, RFC_MEM_AIM_TEMP );
 
         /* Assign backup */
         rfc_ctx->residue_cap = *residue_cap;
@@ -4999,53 +9605,300 @@ bool residue_exchange( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s **residue, size_t *
 
     return true;
 }
-#endif /*!RFC_MINIMAL*/
+#endif /*!RFC_MINIMAL*/
+
+
+/**
+ * @brief      Remove items (points) from the residue
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param      index    The item position in residue, base 0
+ * @param      count    The number of elements to remove
+ */
+static
+void residue_remove_item( rfc_ctx_s *rfc_ctx, size_t index, size_t count )
+{
+    size_t  from = index + count,
+            to   = index, 
+            end;
+
+    assert( rfc_ctx );
+    assert( rfc_ctx->state >= RFC_STATE_INIT && rfc_ctx->state < RFC_STATE_FINISHED );
+    assert( rfc_ctx->residue && index + count <= rfc_ctx->residue_cnt );
+
+    end = (int)rfc_ctx->residue_cnt;
+
+    /* Example
+                         |cnt(5)
+                         v
+               |O|O|X|O|O|
+                   ^
+                   |index(2)
+
+        elements = 2    (5-2-1+0 = 2, no interim turning point)
+    */
+
+    if( rfc_ctx->state == RFC_STATE_BUSY_INTERIM )
+    {
+        /* Include interim turning point */
+        end++;
+    }
+
+    /* Shift points */
+    while( from < end )
+    {
+        rfc_ctx->residue[to++] = rfc_ctx->residue[from++];
+    }
+
+    rfc_ctx->residue_cnt -= count;
+}
+
+
+#if !RFC_MINIMAL
+/**
+ * @brief      Access one element of the sparse rainflow matrix
+ *
+ *             The table uses open addressing with linear probing,
+ *             .from == (unsigned)-1 denotes a free slot.
+ *
+ * @param      rfc_ctx     The rainflow context
+ * @param      class_from  The start class of the element
+ * @param      class_to    The target class of the element
+ * @param      insert      If true, a missing element is inserted (counts zero)
+ *
+ * @return     Pointer to the element counts, NULL if not found (or on
+ *             allocation error while inserting)
+ */
+static
+rfc_counts_t * rfm_sparse_at( rfc_ctx_s *rfc_ctx, unsigned class_from, unsigned class_to, bool insert )
+{
+    rfc_rfm_item_s *table;
+    size_t          mask, i;
+
+    assert( rfc_ctx );
+    assert( rfc_ctx->rfm_sparse && rfc_ctx->rfm_sparse_cap );
+
+    /* Grow at 75% load to keep probe sequences short */
+    if( insert && rfc_ctx->rfm_sparse_cnt >= rfc_ctx->rfm_sparse_cap - rfc_ctx->rfm_sparse_cap / 4 )
+    {
+        if( !rfm_sparse_rehash( rfc_ctx, rfc_ctx->rfm_sparse_cap * 2 ) )
+        {
+            return NULL;
+        }
+    }
+
+    table = rfc_ctx->rfm_sparse;
+    mask  = rfc_ctx->rfm_sparse_cap - 1;
+    i     = ( (size_t)class_from * 2654435761u ^ (size_t)class_to * 2246822519u ) & mask;
+
+    while( table[i].from != (unsigned)-1 )
+    {
+        if( table[i].from == class_from && table[i].to == class_to )
+        {
+            return &table[i].counts;
+        }
+        i = ( i + 1 ) & mask;
+    }
+
+    if( !insert )
+    {
+        return NULL;
+    }
+
+    table[i].from   = class_from;
+    table[i].to     = class_to;
+    table[i].counts = 0;
+    rfc_ctx->rfm_sparse_cnt++;
+
+    return &table[i].counts;
+}
+
+
+/**
+ * @brief      Grow the sparse rainflow matrix table and reinsert all elements
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param      new_cap  The new table capacity, a power of two
+ *
+ * @return     true on success
+ */
+static
+bool rfm_sparse_rehash( rfc_ctx_s *rfc_ctx, size_t new_cap )
+{
+    rfc_rfm_item_s *table_old;
+    size_t          cap_old, i;
+
+    assert( rfc_ctx );
+    assert( new_cap > rfc_ctx->rfm_sparse_cap );
+    assert( ( new_cap & ( new_cap - 1 ) ) == 0 );
+
+    table_old = rfc_ctx->rfm_sparse;
+    cap_old   = rfc_ctx->rfm_sparse_cap;
+
+    rfc_ctx->rfm_sparse = (rfc_rfm_item_s*)ctx_mem_alloc( rfc_ctx, NULL, new_cap, sizeof(rfc_rfm_item_s), RFC_MEM_AIM_RFM_ELEMENTS );
+
+    if( !rfc_ctx->rfm_sparse )
+    {
+        rfc_ctx->rfm_sparse = table_old;
+        return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+    }
+
+    for( i = 0; i < new_cap; i++ )
+    {
+        rfc_ctx->rfm_sparse[i].from = (unsigned)-1;
+    }
+
+    rfc_ctx->rfm_sparse_cap = new_cap;
+    rfc_ctx->rfm_sparse_cnt = 0;
+
+    for( i = 0; i < cap_old; i++ )
+    {
+        if( table_old[i].from != (unsigned)-1 )
+        {
+            rfc_counts_t *counts = rfm_sparse_at( rfc_ctx, table_old[i].from, table_old[i].to, /*insert*/ true );
+
+            assert( counts );
+            *counts = table_old[i].counts;
+        }
+    }
+
+    ctx_mem_alloc( rfc_ctx, table_old, /*num*/ 0, /*size*/ 0, RFC_MEM_AIM_RFM_ELEMENTS );
+
+    return true;
+}
 
 
 /**
- * @brief      Remove items (points) from the residue
+ * @brief      Comparison function for sorting sparse rainflow matrix elements
+ *             in row-major order
  *
- * @param      rfc_ctx  The rainflow context
- * @param      index    The item position in residue, base 0
- * @param      count    The number of elements to remove
+ * @param      lhs   The left hand side element
+ * @param      rhs   The right hand side element
+ *
+ * @return     <0, 0 or >0 like strcmp()
  */
 static
-void residue_remove_item( rfc_ctx_s *rfc_ctx, size_t index, size_t count )
+int rfm_sparse_item_compare( const void *lhs, const void *rhs )
 {
-    size_t  from = index + count,
-            to   = index, 
-            end;
-
-    assert( rfc_ctx );
-    assert( rfc_ctx->state >= RFC_STATE_INIT && rfc_ctx->state < RFC_STATE_FINISHED );
-    assert( rfc_ctx->residue && index + count <= rfc_ctx->residue_cnt );
-
-    end = (int)rfc_ctx->residue_cnt;
+    const rfc_rfm_item_s *item_l = (const rfc_rfm_item_s*)lhs;
+    const rfc_rfm_item_s *item_r = (const rfc_rfm_item_s*)rhs;
 
-    /* Example
-                         |cnt(5)
-                         v
-               |O|O|X|O|O|
-                   ^
-                   |index(2)
-
-        elements = 2    (5-2-1+0 = 2, no interim turning point)
-    */
-
-    if( rfc_ctx->state == RFC_STATE_BUSY_INTERIM )
+    if( item_l->from != item_r->from )
     {
-        /* Include interim turning point */
-        end++;
+        return ( item_l->from < item_r->from ) ? -1 : 1;
     }
 
-    /* Shift points */
-    while( from < end )
+    if( item_l->to != item_r->to )
     {
-        rfc_ctx->residue[to++] = rfc_ctx->residue[from++];
+        return ( item_l->to < item_r->to ) ? -1 : 1;
     }
 
-    rfc_ctx->residue_cnt -= count;
+    return 0;
+}
+
+
+/**
+ * @brief      Copy the plain value part of a context to or from a snapshot
+ *             buffer. Pointers, capacities and delegates are left untouched,
+ *             they belong to the context. The field order defines the layout
+ *             of the scalar block in a snapshot, see RFC_ctx_serialize()
+ *
+ * @param      rfc_ctx      The rainflow context
+ * @param      buffer       Position in the snapshot buffer, NULL queries the block size
+ * @param      buffer_size  Remaining buffer size in bytes
+ * @param      do_write     true writes the context to buffer, false restores the context from buffer
+ *
+ * @return     Number of bytes processed, 0 on buffer overrun
+ */
+static
+size_t ctx_snapshot_scalars( rfc_ctx_s *rfc_ctx, unsigned char *buffer, size_t buffer_size, bool do_write )
+{
+    size_t pos = 0;
+
+    assert( rfc_ctx );
+
+#define SNAPSHOT_SCALAR( FIELD )                                                        \
+    do                                                                                  \
+    {                                                                                   \
+        if( buffer )                                                                    \
+        {                                                                               \
+            if( pos + sizeof( rfc_ctx->FIELD ) > buffer_size ) return 0;                \
+            if( do_write )                                                              \
+            {                                                                           \
+                memcpy( buffer + pos, &rfc_ctx->FIELD, sizeof( rfc_ctx->FIELD ) );      \
+            }                                                                           \
+            else                                                                        \
+            {                                                                           \
+                memcpy( &rfc_ctx->FIELD, buffer + pos, sizeof( rfc_ctx->FIELD ) );      \
+            }                                                                           \
+        }                                                                               \
+        pos += sizeof( rfc_ctx->FIELD );                                                \
+    } while(0)
+
+    SNAPSHOT_SCALAR( state );
+    SNAPSHOT_SCALAR( error );
+    SNAPSHOT_SCALAR( counting_method );
+    SNAPSHOT_SCALAR( residual_method );
+#if RFC_DH_SUPPORT
+    SNAPSHOT_SCALAR( spread_damage_method );
+#endif /*RFC_DH_SUPPORT*/
+    SNAPSHOT_SCALAR( full_inc );
+    SNAPSHOT_SCALAR( half_inc );
+    SNAPSHOT_SCALAR( curr_inc );
+    SNAPSHOT_SCALAR( class_width );
+    SNAPSHOT_SCALAR( class_offset );
+    SNAPSHOT_SCALAR( hysteresis );
+    SNAPSHOT_SCALAR( wl_sx );
+    SNAPSHOT_SCALAR( wl_nx );
+    SNAPSHOT_SCALAR( wl_k );
+    SNAPSHOT_SCALAR( wl_sd );
+    SNAPSHOT_SCALAR( wl_nd );
+    SNAPSHOT_SCALAR( wl_k2 );
+    SNAPSHOT_SCALAR( wl_omission );
+    SNAPSHOT_SCALAR( wl_q );
+    SNAPSHOT_SCALAR( wl_q2 );
+    SNAPSHOT_SCALAR( damage );
+    SNAPSHOT_SCALAR( damage_residue );
+#if RFC_TP_SUPPORT
+    SNAPSHOT_SCALAR( tp_cnt );
+    SNAPSHOT_SCALAR( tp_locked );
+    SNAPSHOT_SCALAR( tp_prune_size );
+    SNAPSHOT_SCALAR( tp_prune_threshold );
+#endif /*RFC_TP_SUPPORT*/
+#if RFC_DAMAGE_FAST
+    SNAPSHOT_SCALAR( damage_lut_inapt );
+#endif /*RFC_DAMAGE_FAST*/
+#if RFC_AT_SUPPORT
+    SNAPSHOT_SCALAR( at.count );
+    SNAPSHOT_SCALAR( at.M );
+    SNAPSHOT_SCALAR( at.Sm_rig );
+    SNAPSHOT_SCALAR( at.R_rig );
+    SNAPSHOT_SCALAR( at.R_pinned );
+    SNAPSHOT_SCALAR( internal.at_haigh );
+#endif /*RFC_AT_SUPPORT*/
+    SNAPSHOT_SCALAR( internal.flags );
+    SNAPSHOT_SCALAR( internal.slope );
+    SNAPSHOT_SCALAR( internal.extrema );
+#if RFC_GLOBAL_EXTREMA
+    SNAPSHOT_SCALAR( internal.extrema_changed );
+#endif /*RFC_GLOBAL_EXTREMA*/
+    SNAPSHOT_SCALAR( internal.pos );
+    SNAPSHOT_SCALAR( internal.pos_offset );
+    SNAPSHOT_SCALAR( internal.wl );
+#if RFC_TP_SUPPORT
+    SNAPSHOT_SCALAR( internal.margin );
+    SNAPSHOT_SCALAR( internal.margin_stage );
+#endif /*RFC_TP_SUPPORT*/
+#if RFC_HCM_SUPPORT
+    SNAPSHOT_SCALAR( internal.hcm.IR );
+    SNAPSHOT_SCALAR( internal.hcm.IZ );
+#endif /*RFC_HCM_SUPPORT*/
+
+#undef SNAPSHOT_SCALAR
+
+    return pos;
 }
+#endif /*!RFC_MINIMAL*/
 
 
 /**
@@ -5234,6 +10087,94 @@ bool at_alleviation( rfc_ctx_s *rfc_ctx, double Sm_norm, double *alleviation )
 
     return true;
 }
+
+
+/**
+ * @brief      Fill the dense transform grid from the current reference curve,
+ *             one exact transformation per node. See RFC_at_lut_init() for
+ *             the grid layout.
+ *
+ * @param      rfc_ctx  The rainflow context
+ *
+ * @return     true on success
+ */
+static
+bool at_lut_build( rfc_ctx_s *rfc_ctx )
+{
+    double   *node    = rfc_ctx->at_lut.grid;
+    double    sa_step = rfc_ctx->at_lut.sa_max / rfc_ctx->at_lut.sa_divisions;
+    double    sm_step = ( rfc_ctx->at_lut.sm_max - rfc_ctx->at_lut.sm_min ) / rfc_ctx->at_lut.sm_divisions;
+    unsigned  i, j;
+
+    assert( rfc_ctx && node );
+
+    for( i = 0; i <= rfc_ctx->at_lut.sa_divisions; i++ )
+    {
+        double Sa = sa_step * i;
+
+        for( j = 0; j <= rfc_ctx->at_lut.sm_divisions; j++, node++ )
+        {
+            double Sm = rfc_ctx->at_lut.sm_min + sm_step * j;
+
+            if( !at_transform_exact( rfc_ctx, Sa, Sm, node ) )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Bilinear look-up on the dense transform grid.
+ *
+ * @param      rfc_ctx         The rainflow context, grid must be attached
+ * @param      Sa              Amplitude (absolute value)
+ * @param      Sm              Mean load
+ * @param[out] Sa_transformed  Transformed amplitude Sa
+ *
+ * @return     true if the grid covers (Sa,Sm), false to fall back to the
+ *             exact calculation
+ */
+static
+bool at_lut_interpolate( const rfc_ctx_s *rfc_ctx, double Sa, double Sm, double *Sa_transformed )
+{
+    const double *node = rfc_ctx->at_lut.grid;
+    double        x, y, fx, fy;
+    unsigned      i, j, stride;
+
+    assert( rfc_ctx && node && Sa_transformed );
+
+    if( Sa > rfc_ctx->at_lut.sa_max ||
+        Sm < rfc_ctx->at_lut.sm_min ||
+        Sm > rfc_ctx->at_lut.sm_max )
+    {
+        return false;
+    }
+
+    x = Sa * rfc_ctx->at_lut.sa_scale;
+    y = ( Sm - rfc_ctx->at_lut.sm_min ) * rfc_ctx->at_lut.sm_scale;
+
+    i = (unsigned)x;
+    j = (unsigned)y;
+
+    /* Clamp upper bounds, so both neighbor nodes stay on the grid */
+    if( i >= rfc_ctx->at_lut.sa_divisions ) i = rfc_ctx->at_lut.sa_divisions - 1;
+    if( j >= rfc_ctx->at_lut.sm_divisions ) j = rfc_ctx->at_lut.sm_divisions - 1;
+
+    fx = x - i;
+    fy = y - j;
+
+    stride = rfc_ctx->at_lut.sm_divisions + 1;
+    node  += (size_t)i * stride + j;
+
+    *Sa_transformed = ( node[0]      * ( 1.0 - fy ) + node[1]        * fy ) * ( 1.0 - fx )
+                    + ( node[stride] * ( 1.0 - fy ) + node[stride+1] * fy ) *         fx;
+
+    return true;
+}
 #endif /*RFC_AT_SUPPORT*/
 
 
@@ -5325,56 +10266,222 @@ bool damage_calc( rfc_ctx_s *rfc_ctx, unsigned class_from, unsigned class_to, do
 }
 
 
+#if !RFC_MINIMAL
+/**
+ * @brief      Assign Woehler curve parameters without any side effects.
+ *             Used internally to shelve and restore parameters, where the
+ *             damage look-up table must be left alone, see RFC_wl_param_set()
+ *
+ * @param      rfc_ctx   The rainflow context
+ * @param[in]  wl_param  The Woehler curve parameters
+ */
+static
+void wl_param_assign( rfc_ctx_s *rfc_ctx, const rfc_wl_param_s *wl_param )
+{
+    assert( rfc_ctx && wl_param );
+
+    rfc_ctx->wl_sx          = wl_param->sx;
+    rfc_ctx->wl_nx          = wl_param->nx;
+    rfc_ctx->wl_k           = wl_param->k;
+    rfc_ctx->wl_q           = wl_param->q;
+    rfc_ctx->wl_sd          = wl_param->sd;
+    rfc_ctx->wl_nd          = wl_param->nd;
+    rfc_ctx->wl_k2          = wl_param->k2;
+    rfc_ctx->wl_q2          = wl_param->q2;
+    rfc_ctx->wl_omission    = wl_param->omission;
+}
+#endif /*!RFC_MINIMAL*/
+
+
 #if RFC_DAMAGE_FAST
 /**
  * @brief      Initialize a look-up table of damages for closed cycles. In this
- *             implementation the midrange doesn't matter!
+ *             implementation the midrange doesn't matter! The table is not
+ *             calculated in advance, rows are filled on first access instead,
+ *             see damage_lut_fill_row(). So contexts with large class counts,
+ *             that visit only a fraction of the value range, skip most of the
+ *             costly Woehler evaluations.
  *
  * @param      rfc_ctx  The rainflow context
  *
  * @returns    true on success
  */
-static 
+static
 bool damage_lut_init( rfc_ctx_s *rfc_ctx )
+{
+    assert( rfc_ctx );
+    assert( rfc_ctx->state == RFC_STATE_INIT );
+
+    if( rfc_ctx->damage_lut && rfc_ctx->damage_lut_row_valid )
+    {
+        /* A shared table must not be invalidated, recede to an exclusive one first */
+        if( !damage_lut_detach( rfc_ctx ) )
+        {
+            return false;
+        }
+
+        memset( rfc_ctx->damage_lut, 0, sizeof(double) * rfc_ctx->class_count * rfc_ctx->class_count );
+#if RFC_AT_SUPPORT
+        if( rfc_ctx->amplitude_lut )
+        {
+            memset( rfc_ctx->amplitude_lut, 0, sizeof(double) * rfc_ctx->class_count * rfc_ctx->class_count );
+        }
+#endif /*RFC_AT_SUPPORT*/
+        memset( rfc_ctx->damage_lut_row_valid, 0, rfc_ctx->class_count );
+
+        rfc_ctx->damage_lut_inapt = 0;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Calculate one row of the damage look-up table, i.e. all cycles
+ *             starting in class "class_from". The table is unhooked while
+ *             filling, so damage_calc() delivers analytically (or through the
+ *             delegate).
+ *
+ * @param      rfc_ctx     The rainflow context
+ * @param      class_from  The starting class
+ *
+ * @returns    true on success
+ */
+static
+bool damage_lut_fill_row( rfc_ctx_s *rfc_ctx, unsigned class_from )
 {
     double   *lut;
-    unsigned  from, 
-              to;
+    unsigned  to;
     double    Sa;
 
     assert( rfc_ctx );
-    assert( rfc_ctx->state == RFC_STATE_INIT );
+    assert( rfc_ctx->state >= RFC_STATE_INIT );
+    assert( rfc_ctx->damage_lut );
+    assert( class_from < rfc_ctx->class_count );
 
-    if( rfc_ctx->damage_lut )
+    lut = rfc_ctx->damage_lut;
+    rfc_ctx->damage_lut = NULL;
+
+    for( to = 0; to < rfc_ctx->class_count; to++ )
+    {
+        double D;
+
+        if( !damage_calc( rfc_ctx, class_from, to, &D, &Sa ) )
+        {
+            rfc_ctx->damage_lut = lut;
+            return false;
+        }
+        lut[class_from * rfc_ctx->class_count + to] = D;
+#if RFC_AT_SUPPORT
+        if( rfc_ctx->amplitude_lut )
+        {
+            rfc_ctx->amplitude_lut[class_from * rfc_ctx->class_count + to] = Sa;
+        }
+#endif /*RFC_AT_SUPPORT*/
+    }
+
+    rfc_ctx->damage_lut = lut;
+
+    if( rfc_ctx->damage_lut_row_valid )
     {
-        lut = rfc_ctx->damage_lut;
-        rfc_ctx->damage_lut = NULL;
+        rfc_ctx->damage_lut_row_valid[class_from] = 1;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief      Calculate any row of the damage look-up table not visited yet,
+ *             e.g. before the table content gets exposed as a whole (snapshot,
+ *             RFC_damage_lut_share()).
+ *
+ * @param      rfc_ctx  The rainflow context
+ *
+ * @returns    true on success
+ */
+static
+bool damage_lut_fill_all( rfc_ctx_s *rfc_ctx )
+{
+    unsigned from;
+
+    assert( rfc_ctx );
 
+    if( rfc_ctx->damage_lut && !rfc_ctx->damage_lut_inapt && rfc_ctx->damage_lut_row_valid )
+    {
         for( from = 0; from < rfc_ctx->class_count; from++ )
         {
-            for( to = 0; to < rfc_ctx->class_count; to++ )
+            if( !rfc_ctx->damage_lut_row_valid[from] && !damage_lut_fill_row( rfc_ctx, from ) )
             {
-                double D;
+                return false;
+            }
+        }
+    }
 
-                if( !damage_calc( rfc_ctx, from, to, &D, &Sa ) )
-                {
-                    rfc_ctx->mem_alloc( lut, 0, 0, RFC_MEM_AIM_DLUT );
-                    return false;
-                }
-                lut[from * rfc_ctx->class_count + to] = D;
+    return true;
+}
+
+
+/**
+ * @brief      Give up the share on look-up tables owned together with other
+ *             contexts, see RFC_damage_lut_share(). The last sharer inherits
+ *             the tables, any other leaves them untouched and starts over with
+ *             exclusive (empty) ones. No-op for exclusively owned tables.
+ *
+ * @param      rfc_ctx  The rainflow context
+ *
+ * @returns    true on success
+ */
+static
+bool damage_lut_detach( rfc_ctx_s *rfc_ctx )
+{
+    size_t class_count;
+
+    assert( rfc_ctx );
+
+    if( !rfc_ctx->damage_lut_refcnt )
+    {
+        /* Tables are exclusively owned */
+        return true;
+    }
+
+    class_count = rfc_ctx->class_count;
+
+    if( --(*rfc_ctx->damage_lut_refcnt) == 0 )
+    {
+        /* Last reference, tables fall back to exclusive ownership */
+        ctx_mem_alloc( rfc_ctx, rfc_ctx->damage_lut_refcnt, 0, 0, RFC_MEM_AIM_DLUT );
+    }
+    else
+    {
+        rfc_ctx->damage_lut           = (double*)ctx_mem_alloc( rfc_ctx, NULL, class_count * class_count,
+                                                                     sizeof(double), RFC_MEM_AIM_DLUT );
+        rfc_ctx->damage_lut_row_valid = (unsigned char*)ctx_mem_alloc( rfc_ctx, NULL, class_count,
+                                                                     sizeof(unsigned char), RFC_MEM_AIM_DLUT );
 #if RFC_AT_SUPPORT
-                if( rfc_ctx->amplitude_lut )
-                {
-                    rfc_ctx->amplitude_lut[from * rfc_ctx->class_count + to] = Sa;
-                }
+        rfc_ctx->amplitude_lut        = (double*)ctx_mem_alloc( rfc_ctx, NULL, class_count * class_count,
+                                                                     sizeof(double), RFC_MEM_AIM_ALUT );
+
+        if( !rfc_ctx->amplitude_lut )
+        {
+            rfc_ctx->damage_lut_refcnt = NULL;
+            return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
+        }
+        memset( rfc_ctx->amplitude_lut, 0, sizeof(double) * class_count * class_count );
 #endif /*RFC_AT_SUPPORT*/
-            }
+
+        if( !rfc_ctx->damage_lut || !rfc_ctx->damage_lut_row_valid )
+        {
+            rfc_ctx->damage_lut_refcnt = NULL;
+            return error_raise( rfc_ctx, RFC_ERROR_MEMORY );
         }
 
-        rfc_ctx->damage_lut          = lut;
-        rfc_ctx->damage_lut_inapt    = 0;
+        memset( rfc_ctx->damage_lut, 0, sizeof(double) * class_count * class_count );
+        memset( rfc_ctx->damage_lut_row_valid, 0, class_count );
     }
 
+    rfc_ctx->damage_lut_refcnt = NULL;
+
     return true;
 }
 
@@ -5405,6 +10512,15 @@ bool damage_calc_fast( rfc_ctx_s *rfc_ctx, unsigned class_from, unsigned class_t
 
     if( rfc_ctx->damage_lut && !rfc_ctx->damage_lut_inapt )
     {
+        /* Rows are filled on first access, see damage_lut_init() */
+        if( rfc_ctx->damage_lut_row_valid && !rfc_ctx->damage_lut_row_valid[class_from] )
+        {
+            if( !damage_lut_fill_row( rfc_ctx, class_from ) )
+            {
+                return false;
+            }
+        }
+
         D = rfc_ctx->damage_lut[class_from * rfc_ctx->class_count + class_to];
 
         if( Sa_ret )
@@ -5714,6 +10830,9 @@ void cycle_find_4ptm( rfc_ctx_s *rfc_ctx, rfc_flags_e flags )
 
             /* Closed cycle found, process countings */
             cycle_process_counts( rfc_ctx, from, to, to + 1, flags );
+#if RFC_STATS_SUPPORT
+            rfc_ctx->internal.stats.cycles_4ptm++;
+#endif /*RFC_STATS_SUPPORT*/
 
             /* Remove two inner turning points (idx+1 and idx+2) */
             /* Move last turning point */
@@ -5787,6 +10906,9 @@ label_2:
                 {
                     /* Cycle range is greater or equal to previous, register closed cycle */
                     cycle_process_counts( rfc_ctx, I, J, NULL, flags );
+#if RFC_STATS_SUPPORT
+                    rfc_ctx->internal.stats.cycles_hcm++;
+#endif /*RFC_STATS_SUPPORT*/
                     IZ -= 2;
                     /* Test further closed cycles */
                     goto label_2;
@@ -5876,6 +10998,9 @@ void cycle_find_astm( rfc_ctx_s *rfc_ctx, rfc_flags_e flags )
                 rfc_ctx->curr_inc = rfc_ctx->half_inc;
                 cycle_process_counts( rfc_ctx, from, to, to + 1, flags );
                 rfc_ctx->curr_inc = old_inc;
+#if RFC_STATS_SUPPORT
+                rfc_ctx->internal.stats.cycles_astm++;
+#endif /*RFC_STATS_SUPPORT*/
 
                 /* Remove only first turning point (idx+0) */
                 rfc_ctx->residue[idx+0] = rfc_ctx->residue[idx+1];
@@ -5893,6 +11018,9 @@ void cycle_find_astm( rfc_ctx_s *rfc_ctx, rfc_flags_e flags )
             {
                 /* Count as standard cycle */
                 cycle_process_counts( rfc_ctx, from, to, to + 1, flags );
+#if RFC_STATS_SUPPORT
+                rfc_ctx->internal.stats.cycles_astm++;
+#endif /*RFC_STATS_SUPPORT*/
 
                 /* Remove first two turning points (idx+0 and idx+1) */
                 rfc_ctx->residue[idx+0] = rfc_ctx->residue[idx+2];
@@ -6073,7 +11201,7 @@ void cycle_process_counts( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s *from, rfc_valu
 
                 /* Backup Woehler curve parameters and use shadowed ones for the impaired part instead */
                 RFC_wl_param_get( rfc_ctx, &wl_unimp );
-                RFC_wl_param_set( rfc_ctx,  wl_imp );
+                wl_param_assign( rfc_ctx,  wl_imp );
 
 #if RFC_DAMAGE_FAST
                 if( rfc_ctx->damage_lut )
@@ -6127,7 +11255,7 @@ void cycle_process_counts( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s *from, rfc_valu
 
                 RFC_wl_param_get( rfc_ctx, wl_imp );
                 rfc_ctx->internal.wl.D = D_con;
-                RFC_wl_param_set( rfc_ctx, &wl_unimp );
+                wl_param_assign( rfc_ctx, &wl_unimp );
             }
 #endif /*!RFC_MINIMAL*/
         }
@@ -6146,10 +11274,23 @@ void cycle_process_counts( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s *from, rfc_valu
              *    | # # # # # #<-(6x6-1)
              */
             size_t idx = rfc_ctx->class_count * class_from + class_to;
-            
+
             assert( rfc_ctx->rfm[idx] <= RFC_COUNTS_LIMIT );
-            rfc_ctx->rfm[idx] += rfc_ctx->curr_inc;
+            COUNTS_INC( rfc_ctx, rfc_ctx->rfm[idx], rfc_ctx->curr_inc );
+        }
+#if !RFC_MINIMAL
+        else if( rfc_ctx->rfm_sparse && ( flags & RFC_FLAGS_COUNT_RFM ) )
+        {
+            rfc_counts_t *counts = rfm_sparse_at( rfc_ctx, class_from, class_to, /*insert*/ true );
+
+            /* On allocation failure the error state is already raised */
+            if( counts )
+            {
+                assert( *counts <= RFC_COUNTS_LIMIT );
+                COUNTS_INC( rfc_ctx, *counts, rfc_ctx->curr_inc );
+            }
         }
+#endif /*!RFC_MINIMAL*/
 
 #if !RFC_MINIMAL
         /* Range pair */
@@ -6160,9 +11301,14 @@ void cycle_process_counts( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s *from, rfc_valu
              * Range value = idx * class_width  (=2x Amplitude)
              */
             int idx = abs( (int)class_from - (int)class_to );
-            
+
             assert( rfc_ctx->rp[idx] <= RFC_COUNTS_LIMIT );
-            rfc_ctx->rp[idx] += rfc_ctx->curr_inc;
+            COUNTS_INC( rfc_ctx, rfc_ctx->rp[idx], rfc_ctx->curr_inc );
+
+            if( rfc_ctx->rp_bin_version )
+            {
+                rfc_ctx->rp_bin_version[idx] = ++rfc_ctx->rp_version;
+            }
         }
 
         /* Level crossing, count rising and falling slopes */
@@ -6183,14 +11329,19 @@ void cycle_process_counts( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s *from, rfc_valu
                 {
                     /* Count rising slopes */
                     assert( rfc_ctx->lc[idx] <= RFC_COUNTS_LIMIT );
-                    rfc_ctx->lc[idx] += rfc_ctx->full_inc;
+                    COUNTS_INC( rfc_ctx, rfc_ctx->lc[idx], rfc_ctx->full_inc );
                 }
 
                 if( flags & RFC_FLAGS_COUNT_LC_DN )
                 {
                     /* Count falling slopes */
                     assert( rfc_ctx->lc[idx] <= RFC_COUNTS_LIMIT );
-                    rfc_ctx->lc[idx] += rfc_ctx->full_inc;
+                    COUNTS_INC( rfc_ctx, rfc_ctx->lc[idx], rfc_ctx->full_inc );
+                }
+
+                if( rfc_ctx->lc_bin_version )
+                {
+                    rfc_ctx->lc_bin_version[idx] = ++rfc_ctx->lc_version;
                 }
             }
         }
@@ -6209,6 +11360,9 @@ void cycle_process_counts( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s *from, rfc_valu
 
 
 #if RFC_TP_SUPPORT
+/* Number of turning points moved per portion of an incremental prune, see tp_prune_inc_step() */
+#define RFC_TP_PRUNE_CHUNK 256
+
 /**
  * @brief         Append or alter a turning point in its storage.
  *
@@ -6247,6 +11401,8 @@ bool tp_set( rfc_ctx_s *rfc_ctx, size_t tp_pos, rfc_value_tuple_s *tp )
     else
 #endif /*RFC_USE_DELEGATES*/
     {
+        size_t tp_slot;  /* Storage slot, trails tp_pos while an incremental prune is pending */
+
         if( !rfc_ctx->tp )
         {
             /* Write to non existent tp storage is ok */
@@ -6263,17 +11419,20 @@ bool tp_set( rfc_ctx_s *rfc_ctx, size_t tp_pos, rfc_value_tuple_s *tp )
                 return false;
             }
 
+            /* Account for a pending incremental prune, see tp_prune_inc_start() */
+            tp_slot = tp_prune_map( rfc_ctx, tp_pos );
+
 #if RFC_DH_SUPPORT
             if( tp->damage < 0.0 )
             {
                 /* Don't alter damage value of target point, if tp->damage < 0 */
-                tp->damage = rfc_ctx->tp[ tp_pos - 1 ].damage;
+                tp->damage = rfc_ctx->tp[ tp_slot - 1 ].damage;
             }
 #endif /*RFC_DH_SUPPORT*/
 
-            tp->tp_pos                =  0;                                  /* Omit position information for turning points in its storage */
-            rfc_ctx->tp[ tp_pos - 1 ] = *tp;                                 /* Move or replace turning point */
-            tp->tp_pos                =  tp_pos;                             /* Ping back the position (commonly tp lies in residue buffer) */
+            tp->tp_pos                 =  0;                                 /* Omit position information for turning points in its storage */
+            rfc_ctx->tp[ tp_slot - 1 ] = *tp;                                /* Move or replace turning point */
+            tp->tp_pos                 =  tp_pos;                            /* Ping back the position (commonly tp lies in residue buffer) */
 
 #if RFC_DEBUG_FLAGS
             if( rfc_ctx->internal.debug_flags & RFC_FLAGS_LOG_WRITE_TP )
@@ -6308,8 +11467,11 @@ bool tp_set( rfc_ctx_s *rfc_ctx, size_t tp_pos, rfc_value_tuple_s *tp )
             }
         }
 
+        /* Account for a pending incremental prune, see tp_prune_inc_start() */
+        tp_slot = tp_prune_map( rfc_ctx, tp_pos );
+
         /* Check if buffer needs to be resized */
-        if( rfc_ctx->tp_cnt >= rfc_ctx->tp_cap )
+        if( tp_slot >= rfc_ctx->tp_cap )
         {
             rfc_value_tuple_s  *tp_new;
             size_t              tp_cap_new;
@@ -6318,7 +11480,7 @@ bool tp_set( rfc_ctx_s *rfc_ctx, size_t tp_pos, rfc_value_tuple_s *tp )
             /* Reallocation */
             tp_cap_increment = (size_t)1024 * ( rfc_ctx->tp_cap / 640 + 1 );  /* + 60% + 1024 */
             tp_cap_new       = rfc_ctx->tp_cap + tp_cap_increment;
-            tp_new           = rfc_ctx->mem_alloc( rfc_ctx->tp, tp_cap_new, 
+            tp_new           = ctx_mem_alloc( rfc_ctx, rfc_ctx->tp, tp_cap_new, 
                                                    sizeof(rfc_value_tuple_s), RFC_MEM_AIM_TP );
 
             if( tp_new )
@@ -6335,8 +11497,8 @@ bool tp_set( rfc_ctx_s *rfc_ctx, size_t tp_pos, rfc_value_tuple_s *tp )
         assert( tp_pos <= rfc_ctx->tp_cnt );
 
         /* Append turning point */
-        rfc_ctx->tp[ tp_pos - 1 ] = *tp;      /* Make a copy of tp in .tp, tp->tp_pos remains unaltered */
-        tp->tp_pos                =  tp_pos;  /* Ping back turning point position index in tp, base 1 */
+        rfc_ctx->tp[ tp_slot - 1 ] = *tp;      /* Make a copy of tp in .tp, tp->tp_pos remains unaltered */
+        tp->tp_pos                 =  tp_pos;  /* Ping back turning point position index in tp, base 1 */
 
 #if RFC_DEBUG_FLAGS
         if( rfc_ctx->internal.debug_flags & RFC_FLAGS_LOG_WRITE_TP )
@@ -6349,7 +11511,12 @@ bool tp_set( rfc_ctx_s *rfc_ctx, size_t tp_pos, rfc_value_tuple_s *tp )
 
         if( rfc_ctx->internal.flags & RFC_FLAGS_TPAUTOPRUNE && rfc_ctx->tp_cnt > rfc_ctx->tp_prune_threshold )
         {
-            return RFC_tp_prune( rfc_ctx, rfc_ctx->tp_prune_size, RFC_FLAGS_TPPRUNE_PRESERVE_POS );
+            return tp_prune_inc_start( rfc_ctx, rfc_ctx->tp_prune_size );
+        }
+        else if( rfc_ctx->internal.tp_prune_removal )
+        {
+            /* Settle a pending compaction in bounded portions */
+            tp_prune_inc_step( rfc_ctx, RFC_TP_PRUNE_CHUNK );
         }
 
         return true;
@@ -6393,6 +11560,14 @@ bool tp_get( rfc_ctx_s *rfc_ctx, size_t tp_pos, rfc_value_tuple_s **tp )
             return false;
         }
 
+        /* Account for a pending incremental prune, see tp_prune_inc_start() */
+        tp_pos = tp_prune_map( rfc_ctx, tp_pos );
+
+        if( tp_pos > rfc_ctx->tp_cap )
+        {
+            return false;
+        }
+
         *tp = &rfc_ctx->tp[ tp_pos - 1 ];
 
 #if RFC_DEBUG_FLAGS
@@ -6444,7 +11619,8 @@ bool tp_inc_damage( rfc_ctx_s *rfc_ctx, size_t tp_pos, double damage )
                 return error_raise( rfc_ctx, RFC_ERROR_TP );
             }
 #if RFC_DH_SUPPORT
-            rfc_ctx->tp[ tp_pos - 1 ].damage += damage;
+            /* Account for a pending incremental prune, see tp_prune_inc_start() */
+            rfc_ctx->tp[ tp_prune_map( rfc_ctx, tp_pos ) - 1 ].damage += damage;
 #endif /*RFC_DH_SUPPORT*/
         }
     }
@@ -6474,6 +11650,162 @@ void tp_lock( rfc_ctx_s *rfc_ctx, bool do_lock )
 }
 
 
+/**
+ * @brief      Map a turning point position to its storage slot.
+ *
+ *             While an incremental prune is pending, turning points beyond the
+ *             compacted front still reside behind the removal gap.
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param[in]  tp_pos   The position, base 1
+ *
+ * @return     The storage slot, base 1
+ */
+static
+size_t tp_prune_map( const rfc_ctx_s *rfc_ctx, size_t tp_pos )
+{
+    assert( rfc_ctx );
+
+    if( rfc_ctx->internal.tp_prune_removal && tp_pos > rfc_ctx->internal.tp_prune_moved )
+    {
+        tp_pos += rfc_ctx->internal.tp_prune_removal;
+    }
+
+    return tp_pos;
+}
+
+
+/**
+ * @brief      Begin pruning turning points incrementally (autoprune).
+ *
+ *             Has the same effect as RFC_tp_prune() with flag
+ *             RFC_FLAGS_TPPRUNE_PRESERVE_POS, but defers compacting the
+ *             storage: the removal gap is closed in bounded portions on
+ *             subsequent calls to tp_set(), keeping the worst case cost per
+ *             data point independent of the history size. tp_get() and
+ *             tp_set() map positions across the gap meanwhile, external
+ *             readers see a compact storage again once the turning points are
+ *             locked (or on any API entry that traverses the history).
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param      limit    The expected number of points left over
+ *
+ * @return     true on success
+ */
+static
+bool tp_prune_inc_start( rfc_ctx_s *rfc_ctx, size_t limit )
+{
+    size_t removal, i;
+
+    assert( rfc_ctx );
+    assert( rfc_ctx->state >= RFC_STATE_INIT && rfc_ctx->state <= RFC_STATE_FINISHED );
+
+#if RFC_USE_DELEGATES
+    /* Delegates maintain their own storage, fall back to a synchronous prune */
+    if( rfc_ctx->tp_get_fcn || rfc_ctx->tp_set_fcn )
+    {
+        return RFC_tp_prune( rfc_ctx, limit, RFC_FLAGS_TPPRUNE_PRESERVE_POS );
+    }
+#endif /*RFC_USE_DELEGATES*/
+
+#if RFC_DH_SUPPORT
+    if( rfc_ctx->dh || rfc_ctx->dh_sparse )
+    {
+        return error_raise( rfc_ctx, RFC_ERROR_UNSUPPORTED );
+    }
+#endif /*RFC_DH_SUPPORT*/
+
+    /* A pending compaction must settle before a new removal gap opens */
+    if( rfc_ctx->internal.tp_prune_removal )
+    {
+        tp_prune_inc_step( rfc_ctx, (size_t)-1 );
+    }
+
+    if( !rfc_ctx->tp || rfc_ctx->tp_cnt <= limit )
+    {
+        return true;
+    }
+
+#if RFC_STATS_SUPPORT
+    rfc_ctx->internal.stats.tp_prunes++;
+#endif /*RFC_STATS_SUPPORT*/
+
+    removal = rfc_ctx->tp_cnt - limit;
+
+    /* Residual turning points lose their history backing, as with
+       RFC_tp_prune() without flag RFC_FLAGS_TPPRUNE_PRESERVE_RES */
+    for( i = 0; i < rfc_ctx->residue_cnt; i++ )
+    {
+        rfc_ctx->residue[i].tp_pos = 0;  /* Index 0 => "none" */
+    }
+
+    rfc_ctx->internal.tp_prune_removal = removal;
+    rfc_ctx->internal.tp_prune_moved   = 0;
+    rfc_ctx->tp_cnt                    = limit;
+
+    /* Compact a first portion right away, appending points settle the rest */
+    tp_prune_inc_step( rfc_ctx, RFC_TP_PRUNE_CHUNK );
+
+    return true;
+}
+
+
+/**
+ * @brief      Close the removal gap of a pending incremental prune, moving at
+ *             most max_move turning points.
+ *
+ * @param      rfc_ctx   The rainflow context
+ * @param      max_move  The maximum number of turning points to move
+ */
+static
+void tp_prune_inc_step( rfc_ctx_s *rfc_ctx, size_t max_move )
+{
+    size_t removal, moved, total;
+
+    assert( rfc_ctx );
+    assert( rfc_ctx->tp );
+
+    removal = rfc_ctx->internal.tp_prune_removal;
+    moved   = rfc_ctx->internal.tp_prune_moved;
+
+    if( !removal )
+    {
+        return;
+    }
+
+    /* The interim turning point trails the last stored one */
+    total = rfc_ctx->tp_cnt + ( ( rfc_ctx->state == RFC_STATE_BUSY_INTERIM ) ? 1 : 0 );
+
+    /* The trailing slot may fall behind the storage capacity */
+    if( total + removal > rfc_ctx->tp_cap )
+    {
+        total = rfc_ctx->tp_cap - removal;
+    }
+
+    if( max_move > total - moved )
+    {
+        max_move = total - moved;
+    }
+
+    if( max_move )
+    {
+        memmove( rfc_ctx->tp + moved, rfc_ctx->tp + moved + removal, max_move * sizeof( rfc_value_tuple_s ) );
+        moved += max_move;
+    }
+
+    if( moved >= total )
+    {
+        /* Storage is compact again */
+        rfc_ctx->internal.tp_prune_removal = 0;
+        rfc_ctx->internal.tp_prune_moved   = 0;
+    }
+    else
+    {
+        rfc_ctx->internal.tp_prune_moved = moved;
+    }
+}
+
+
 /**
  * @brief      Restart counting with given points from turning points history
  *
@@ -6505,6 +11837,12 @@ bool tp_refeed( rfc_ctx_s *rfc_ctx, rfc_value_t new_hysteresis, const rfc_class_
         return error_raise( rfc_ctx, RFC_ERROR_INVARG );
     }
 
+    /* Settle a pending incremental compaction, the history is traversed in storage order */
+    if( rfc_ctx->internal.tp_prune_removal )
+    {
+        tp_prune_inc_step( rfc_ctx, (size_t)-1 );
+    }
+
     if( ( rfc_ctx->state < RFC_STATE_BUSY_INTERIM || new_hysteresis == rfc_ctx->hysteresis ) && !new_class_param )
     {
         /* Less than 2 turning points in stack */
@@ -6570,7 +11908,7 @@ bool tp_refeed( rfc_ctx_s *rfc_ctx, rfc_value_t new_hysteresis, const rfc_class_
         const int          n_max  = 500;
         bool               ok     = true;  
 
-        tp = rfc_ctx->mem_alloc( NULL, n_max, sizeof(rfc_value_tuple_s), RFC_MEM_AIM_TP );
+        tp = ctx_mem_alloc( rfc_ctx, NULL, n_max, sizeof(rfc_value_tuple_s), RFC_MEM_AIM_TP );
 
         if( !tp )
         {
@@ -6607,7 +11945,7 @@ bool tp_refeed( rfc_ctx_s *rfc_ctx, rfc_value_t new_hysteresis, const rfc_class_
             tp_cnt -= n_cnt;
         }
 
-        rfc_ctx->mem_alloc( tp, 0, 0, RFC_MEM_AIM_TP );
+        ctx_mem_alloc( rfc_ctx, tp, 0, 0, RFC_MEM_AIM_TP );
 
 #if RFC_DEBUG_FLAGS
         if( rfc_ctx->internal.debug_flags & RFC_FLAGS_LOG_TP_REFEED )
@@ -6739,17 +12077,23 @@ bool spread_damage( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s *from,
 #endif /*RFC_TP_SUPPORT*/
 
 #if RFC_DH_SUPPORT
-            if( rfc_ctx->dh )
+            if( rfc_ctx->dh || rfc_ctx->dh_sparse )
             {
                 if( from->pos )
                 {
-                    rfc_ctx->dh[ from->pos - 1 ] += damage_lhs;
+                    if( !dh_add( rfc_ctx, from->pos - 1, damage_lhs ) )
+                    {
+                        return false;
+                    }
                 }
                 else damage_rhs += damage_lhs;
 
                 if( to->pos )
                 {
-                    rfc_ctx->dh[ to->pos - 1 ] += damage_rhs;
+                    if( !dh_add( rfc_ctx, to->pos - 1, damage_rhs ) )
+                    {
+                        return false;
+                    }
                 }
             }
 #endif /*RFC_DH_SUPPORT*/
@@ -6855,9 +12199,9 @@ bool spread_damage( rfc_ctx_s *rfc_ctx, rfc_value_tuple_s *from,
                 if( D_new > D )
                 {
 #if RFC_DH_SUPPORT
-                    if( rfc_ctx->dh )
+                    if( !dh_add( rfc_ctx, pos_0, D_new - D ) )
                     {
-                        rfc_ctx->dh[ pos_0 ] += D_new - D;
+                        return false;
                     }
 #endif /*RFC_DH_SUPPORT*/
                     if( !tp_inc_damage( rfc_ctx, tp_pos_0 + 1, D_new - D ) )
@@ -7129,56 +12473,222 @@ bool error_raise( rfc_ctx_s *rfc_ctx, rfc_error_e error )
 {
     if( error == RFC_ERROR_NOERROR ) return true;
 
-    if( rfc_ctx && rfc_ctx->version == sizeof(rfc_ctx_s) )
+    if( rfc_ctx && rfc_ctx->version == sizeof(rfc_ctx_s) )
+    {
+        rfc_ctx->state = RFC_STATE_ERROR;
+        rfc_ctx->error = error;
+    }
+    else
+    {
+        assert( false );
+    }
+
+    return false;
+}
+
+
+/**
+ * @brief      Returns the unsigned difference of two values, sign optionally
+ *             returned as -1 or 1.
+ *
+ * @param      rfc_ctx   The rainflow context
+ * @param[in]  pt_from   The point from
+ * @param[in]  pt_to     The point to
+ * @param[out] sign_ptr  Pointer to catch sign (may be NULL)
+ *
+ * @return     Returns the absolute difference of given values
+ */
+static
+rfc_value_t value_delta( rfc_ctx_s* rfc_ctx, const rfc_value_tuple_s* pt_from, const rfc_value_tuple_s* pt_to, int *sign_ptr )
+{
+    double delta;
+
+    assert( rfc_ctx );
+    assert( pt_from && pt_to );
+
+#if RFC_USE_HYSTERESIS_FILTER
+    delta = (double)pt_to->value - (double)pt_from->value;
+#else /*RFC_USE_HYSTERESIS_FILTER*/
+    delta = rfc_ctx->class_width * ( (int)pt_to->cls - (int)pt_from->cls );
+#endif /*RFC_USE_HYSTERESIS_FILTER*/
+
+    if( sign_ptr )
+    {
+        *sign_ptr = ( delta < 0.0 ) ? -1 : 1;
+    }
+
+    return (rfc_value_t)fabs( delta );
+}
+
+
+/**
+ * @brief      (Re-)Allocate or free memory
+ *
+ * @param      ptr   Previous data pointer, or NULL, if unset
+ * @param      num   The number of elements
+ * @param      size  The size of one element in bytes
+ * @param      aim   The aim
+ *
+ * @return     New memory pointer or NULL if either num or size is 0
+ */
+static
+void * mem_alloc( void *ptr, size_t num, size_t size, int aim )
+{
+    if( !num || !size )
+    {
+        if( ptr )
+        {
+            FREE( ptr );
+        }
+        return NULL;
+    }
+    else
+    {
+        return ptr ? REALLOC( ptr, num * size ) : CALLOC( num, size );
+    }
+}
+
+
+/**
+ * @brief      (Re-)Allocate or free memory, context aware. Dispatches to the
+ *             arena allocator, if one is attached (see RFC_mem_arena_init()),
+ *             otherwise to the allocation functor .mem_alloc
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param      ptr      Previous data pointer, or NULL, if unset
+ * @param      num      The number of elements
+ * @param      size     The size of one element in bytes
+ * @param      aim      The aim
+ *
+ * @return     New memory pointer or NULL if either num or size is 0
+ */
+static
+void * ctx_mem_alloc( rfc_ctx_s *rfc_ctx, void *ptr, size_t num, size_t size, int aim )
+{
+    assert( rfc_ctx );
+
+#if RFC_STATS_SUPPORT
+    if( num && size )
+    {
+        rfc_ctx->internal.stats.mem_allocs++;
+    }
+#endif /*RFC_STATS_SUPPORT*/
+
+#if !RFC_MINIMAL
+    if( rfc_ctx->internal.arena )
+    {
+        return mem_arena_alloc( rfc_ctx->internal.arena, ptr, ( !num || !size ) ? 0 : ( num * size ) );
+    }
+#endif /*!RFC_MINIMAL*/
+
+    return rfc_ctx->mem_alloc( ptr, num, size, aim );
+}
+
+
+#if !RFC_MINIMAL
+/**
+ * @brief      (Re-)Allocate or free an arena block. Fresh blocks bump the
+ *             slab position and are zero initialized like CALLOC. Only the
+ *             most recent block can be taken back or grown in place, other
+ *             blocks rest in the slab until RFC_deinit(). When the slab is
+ *             exhausted, blocks fall back to the heap.
+ *
+ * @param      arena  The arena
+ * @param      ptr    Previous data pointer, or NULL, if unset
+ * @param      size   The new block size in bytes, 0 frees
+ *
+ * @return     New memory pointer or NULL, if size is 0
+ */
+static
+void * mem_arena_alloc( rfc_mem_arena_s *arena, void *ptr, size_t size )
+{
+    mem_arena_header_s *header = ptr ? ( (mem_arena_header_s*)ptr - 1 ) : NULL;
+
+    assert( arena );
+
+    if( !size )
+    {
+        /* Free */
+        if( header )
+        {
+            if( !header->arena )
+            {
+                FREE( header );
+            }
+            else if( (void*)header == arena->last )
+            {
+                /* Take back the most recent block */
+                arena->offset = (size_t)( (unsigned char*)header - arena->slab );
+                arena->last   = NULL;
+            }
+        }
+        return NULL;
+    }
+
+    size = MEM_ARENA_ALIGN( size );
+
+    if( header )
+    {
+        /* Reallocation */
+        if( size <= header->size )
+        {
+            return ptr;
+        }
+
+        if( header->arena && (void*)header == arena->last &&
+            ( (unsigned char*)ptr - arena->slab ) + size <= arena->size )
+        {
+            /* Grow the most recent block in place */
+            memset( (unsigned char*)ptr + header->size, 0, size - header->size );
+            arena->offset = (size_t)( (unsigned char*)ptr - arena->slab ) + size;
+            header->size  = size;
+
+            return ptr;
+        }
+        else
+        {
+            void *new_ptr = mem_arena_alloc( arena, NULL, size );
+
+            if( !new_ptr ) return NULL;
+
+            memcpy( new_ptr, ptr, header->size );
+            mem_arena_alloc( arena, ptr, 0 );
+
+            return new_ptr;
+        }
+    }
+
+    /* Fresh block */
+    if( arena->offset + sizeof(mem_arena_header_s) + size <= arena->size )
     {
-        rfc_ctx->state = RFC_STATE_ERROR;
-        rfc_ctx->error = error;
+        header          = (mem_arena_header_s*)( arena->slab + arena->offset );
+        header->arena   = arena;
+        header->size    = size;
+        arena->last     = header;
+        arena->offset  += sizeof(mem_arena_header_s) + size;
+        memset( header + 1, 0, size );
     }
     else
     {
-        assert( false );
-    }
-
-    return false;
-}
-
-
-/**
- * @brief      Returns the unsigned difference of two values, sign optionally
- *             returned as -1 or 1.
- *
- * @param      rfc_ctx   The rainflow context
- * @param[in]  pt_from   The point from
- * @param[in]  pt_to     The point to
- * @param[out] sign_ptr  Pointer to catch sign (may be NULL)
- *
- * @return     Returns the absolute difference of given values
- */
-static
-rfc_value_t value_delta( rfc_ctx_s* rfc_ctx, const rfc_value_tuple_s* pt_from, const rfc_value_tuple_s* pt_to, int *sign_ptr )
-{
-    double delta;
-
-    assert( rfc_ctx );
-    assert( pt_from && pt_to );
+        /* Slab exhausted, fall back to the heap */
+        header = (mem_arena_header_s*)CALLOC( 1, sizeof(mem_arena_header_s) + size );
 
-#if RFC_USE_HYSTERESIS_FILTER
-    delta = (double)pt_to->value - (double)pt_from->value;
-#else /*RFC_USE_HYSTERESIS_FILTER*/
-    delta = rfc_ctx->class_width * ( (int)pt_to->cls - (int)pt_from->cls );
-#endif /*RFC_USE_HYSTERESIS_FILTER*/
+        if( !header ) return NULL;
 
-    if( sign_ptr )
-    {
-        *sign_ptr = ( delta < 0.0 ) ? -1 : 1;
+        header->arena = NULL;
+        header->size  = size;
     }
 
-    return (rfc_value_t)fabs( delta );
+    return header + 1;
 }
 
 
 /**
- * @brief      (Re-)Allocate or free memory
+ * @brief      Allocation functor installed by RFC_mem_arena_init(). Resolves
+ *             the arena from the block header, so buffers handed out by the
+ *             context (e.g. RFC_rfm_get()) can be released through
+ *             .mem_alloc as usual. Fresh blocks requested through the
+ *             functor carry no context and are served from the heap.
  *
  * @param      ptr   Previous data pointer, or NULL, if unset
  * @param      num   The number of elements
@@ -7188,21 +12698,49 @@ rfc_value_t value_delta( rfc_ctx_s* rfc_ctx, const rfc_value_tuple_s* pt_from, c
  * @return     New memory pointer or NULL if either num or size is 0
  */
 static
-void * mem_alloc( void *ptr, size_t num, size_t size, int aim )
+void * mem_alloc_arena( void *ptr, size_t num, size_t size, int aim )
 {
-    if( !num || !size )
+    mem_arena_header_s *header;
+
+    (void)aim;
+
+    if( !ptr )
     {
-        if( ptr )
-        {
-            FREE( ptr );
-        }
-        return NULL;
+        if( !num || !size ) return NULL;
+
+        header = (mem_arena_header_s*)CALLOC( 1, sizeof(mem_arena_header_s) + MEM_ARENA_ALIGN( num * size ) );
+
+        if( !header ) return NULL;
+
+        header->arena = NULL;
+        header->size  = MEM_ARENA_ALIGN( num * size );
+
+        return header + 1;
     }
-    else
+
+    header = (mem_arena_header_s*)ptr - 1;
+
+    if( header->arena )
     {
-        return ptr ? REALLOC( ptr, num * size ) : CALLOC( num, size );
+        return mem_arena_alloc( header->arena, ptr, ( !num || !size ) ? 0 : ( num * size ) );
+    }
+
+    /* Heap fallback block */
+    if( !num || !size )
+    {
+        FREE( header );
+        return NULL;
     }
+
+    header = (mem_arena_header_s*)REALLOC( header, sizeof(mem_arena_header_s) + MEM_ARENA_ALIGN( num * size ) );
+
+    if( !header ) return NULL;
+
+    header->size = MEM_ARENA_ALIGN( num * size );
+
+    return header + 1;
 }
+#endif /*!RFC_MINIMAL*/
 
 
 
@@ -7245,6 +12783,213 @@ int rfc_vfprintf_fcn( void *ctx, FILE* stream, const char *fmt, va_list arg )
 }
 #endif /*RFC_DEBUG_FLAGS*/
 
+/**
+ * @brief      Raise a MATLAB error for a rainflow error code (does not return)
+ *
+ * @param[in]  error  The error code (\ref rfc_error_e)
+ */
+static
+void mexRaiseError( int error )
+{
+    switch( error )
+    {
+        case RFC_ERROR_INVARG:
+            mexErrMsgTxt( "Invalid argument(s)!" );
+        case RFC_ERROR_MEMORY:
+            mexErrMsgTxt( "Error during memory allocation!" );
+#if RFC_AT_SUPPORT
+        case RFC_ERROR_AT:
+            mexErrMsgTxt( "Error during amplitude transformation!" );
+#endif /*RFC_AT_SUPPORT*/
+#if RFC_TP_SUPPORT
+        case RFC_ERROR_TP:
+            mexErrMsgTxt( "Error during turning point access!" );
+#endif /*RFC_TP_SUPPORT*/
+#if RFC_DAMAGE_FAST
+        case RFC_ERROR_LUT:
+            mexErrMsgTxt( "Error during lookup table access!" );
+#endif /*RFC_DAMAGE_FAST*/
+        case RFC_ERROR_UNEXP:
+        default:
+            mexErrMsgTxt( "Unexpected error occurred!" );
+    }
+}
+
+
+/**
+ * @brief      Export counting results as MATLAB return values
+ *
+ * @param      rfc_ctx  The rainflow context
+ * @param[in]  nlhs     Number of left hand side values expected
+ * @param      plhs     Left hand side values
+ * @param[in]  use_hcm  Non-zero, if counting uses the HCM method
+ */
+static
+void mexExportResults( rfc_ctx_s *rfc_ctx, int nlhs, mxArray* plhs[], int use_hcm )
+{
+    unsigned class_count = rfc_ctx->class_count;
+
+#if !RFC_HCM_SUPPORT
+    (void)use_hcm;
+#endif /*!RFC_HCM_SUPPORT*/
+
+    /* Damage */
+    plhs[0] = mxCreateDoubleScalar( rfc_ctx->damage );
+
+    /* Residue */
+#if RFC_HCM_SUPPORT
+    if( use_hcm )
+    {
+        if( nlhs > 1 && rfc_ctx->internal.hcm.stack )
+        {
+            mxArray* re = mxCreateDoubleMatrix( rfc_ctx->internal.hcm.IZ, 1, mxREAL );
+            if( re )
+            {
+                int i;
+                double *val = mxGetPr(re);
+
+                for( i = 0; i < rfc_ctx->internal.hcm.IZ; i++ )
+                {
+                    *val++ = (double)rfc_ctx->internal.hcm.stack[i].value;
+                }
+                plhs[1] = re;
+            }
+        }
+    }
+    else
+#endif /*!RFC_HCM_SUPPORT*/
+    {
+        if( nlhs > 1 && rfc_ctx->residue )
+        {
+            mxArray* re = mxCreateDoubleMatrix( rfc_ctx->residue_cnt, 1, mxREAL );
+            if( re )
+            {
+                size_t i;
+                double *val = mxGetPr(re);
+
+                for( i = 0; i < rfc_ctx->residue_cnt; i++ )
+                {
+                    *val++ = (double)rfc_ctx->residue[i].value;
+                }
+                plhs[1] = re;
+            }
+        }
+    }
+
+    /* Rainflow matrix (column major order) */
+    if( nlhs > 2 && rfc_ctx->rfm )
+    {
+        mxArray* rfm = mxCreateDoubleMatrix( class_count, class_count, mxREAL );
+        if( rfm )
+        {
+            double *ptr = mxGetPr(rfm);
+            size_t from, to;
+            for( to = 0; to < class_count; to++ )
+            {
+                for( from = 0; from < class_count; from++ )
+                {
+                    *ptr++ = (double)rfc_ctx->rfm[ MAT_OFFS( from, to ) ] / rfc_ctx->full_inc;
+                }
+            }
+            plhs[2] = rfm;
+        }
+    }
+
+#if !RFC_MINIMAL
+    /* Range pair */
+    if( nlhs > 3 && rfc_ctx->rp )
+    {
+        mxArray* rp = mxCreateDoubleMatrix( class_count, 1, mxREAL );
+        if( rp )
+        {
+            double *ptr = mxGetPr(rp);
+            size_t i;
+            for( i = 0; i < class_count; i++ )
+            {
+                *ptr++ = (double)rfc_ctx->rp[i] / rfc_ctx->curr_inc;
+            }
+            plhs[3] = rp;
+        }
+    }
+
+    /* Level crossing */
+    if( nlhs > 4 && rfc_ctx->lc )
+    {
+        mxArray* lc = mxCreateDoubleMatrix( class_count, 1, mxREAL );
+        if( lc )
+        {
+            double *ptr = mxGetPr(lc);
+            size_t i;
+            for( i = 0; i < class_count; i++ )
+            {
+                *ptr++ = (double)rfc_ctx->lc[i];
+            }
+            plhs[4] = lc;
+        }
+    }
+#if RFC_TP_SUPPORT
+    /* Turning points */
+    if( nlhs > 5 && rfc_ctx->tp )
+    {
+#if RFC_DH_SUPPORT
+        mxArray *tp  = mxCreateDoubleMatrix( rfc_ctx->tp_cnt, 3, mxREAL );
+        double  *dam = tp ? ( mxGetPr(tp) + 2 * rfc_ctx->tp_cnt ) : NULL;
+#else /*!RFC_DH_SUPPORT*/
+        mxArray* tp  = mxCreateDoubleMatrix( rfc_ctx->tp_cnt, 2, mxREAL );
+#endif /*RFC_DH_SUPPORT*/
+
+        if( tp )
+        {
+            size_t  i;
+            double *idx  = mxGetPr(tp) + 0 * rfc_ctx->tp_cnt;
+            double *val  = mxGetPr(tp) + 1 * rfc_ctx->tp_cnt;
+            double  D    = 0.0;
+
+            for( i = 0; i < rfc_ctx->tp_cnt; i++ )
+            {
+                *val++  = (double)rfc_ctx->tp[i].value;
+                *idx++  = (double)rfc_ctx->tp[i].pos;
+#if RFC_DH_SUPPORT
+                *dam++  = (double)rfc_ctx->tp[i].damage;
+                 D     += (double)rfc_ctx->tp[i].damage;
+#endif /*RFC_DH_SUPPORT*/
+            }
+            /* assert( D == rfc_ctx->damage ); */
+            plhs[5] = tp;
+        }
+    }
+#endif /*RFC_TP_SUPPORT*/
+#if RFC_DH_SUPPORT
+    /* Turning points */
+    if( nlhs > 6 )
+    {
+        if( rfc_ctx->dh )
+        {
+            mxArray *dh  = mxCreateDoubleMatrix( rfc_ctx->internal.pos, 1, mxREAL );
+            double  *dh_ptr = dh ? mxGetPr(dh) : NULL;
+
+            if( dh_ptr )
+            {
+                size_t i;
+
+                for( i = 0; i < rfc_ctx->internal.pos; i++ )
+                {
+                    *dh_ptr++ = rfc_ctx->dh[i];
+                }
+            }
+
+            plhs[6] = dh;
+        }
+        else
+        {
+            plhs[6] = mxCreateDoubleMatrix( 0, 0, mxREAL );
+        }
+    }
+#endif /*RFC_DH_SUPPORT*/
+#endif /*!RFC_MINIMAL*/
+}
+
+
 /**
  * MATLAB wrapper for the rainflow algorithm
  */
@@ -7455,186 +13200,16 @@ void mexRainflow( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
             int error = rfc_ctx.error;
 
             RFC_deinit( &rfc_ctx );
-            switch( error )
-            {
-                case RFC_ERROR_INVARG:
-                    mexErrMsgTxt( "Invalid argument(s)!" );
-                case RFC_ERROR_MEMORY:
-                    mexErrMsgTxt( "Error during memory allocation!" );
-#if RFC_AT_SUPPORT
-                case RFC_ERROR_AT:
-                    mexErrMsgTxt( "Error during amplitude transformation!" );
-#endif /*RFC_AT_SUPPORT*/
-#if RFC_TP_SUPPORT
-                case RFC_ERROR_TP:
-                    mexErrMsgTxt( "Error during turning point access!" );
-#endif /*RFC_TP_SUPPORT*/
-#if RFC_DAMAGE_FAST
-                case RFC_ERROR_LUT:
-                    mexErrMsgTxt( "Error during lookup table access!" );
-#endif /*RFC_DAMAGE_FAST*/
-                case RFC_ERROR_UNEXP:
-                default:
-                    mexErrMsgTxt( "Unexpected error occurred!" );
-            }
+            mexRaiseError( error );
         }
 
-        /* Return results */
-        if( plhs )
-        {
-            /* Damage */
-            plhs[0] = mxCreateDoubleScalar( rfc_ctx.damage );
-
-            /* Residue */
-#if RFC_HCM_SUPPORT
-            if( use_hcm )
-            {
-                if( nlhs > 1 && rfc_ctx.internal.hcm.stack )
-                {
-                    mxArray* re = mxCreateDoubleMatrix( rfc_ctx.internal.hcm.IZ, 1, mxREAL );
-                    if( re )
-                    {
-                        int i;
-                        double *val = mxGetPr(re);
-
-                        for( i = 0; i < rfc_ctx.internal.hcm.IZ; i++ )
-                        {
-                            *val++ = (double)rfc_ctx.internal.hcm.stack[i].value;
-                        }
-                        plhs[1] = re;
-                    }
-                }
-            }
-            else
-#endif /*!RFC_HCM_SUPPORT*/
-            {
-                if( nlhs > 1 && rfc_ctx.residue )
-                {
-                    mxArray* re = mxCreateDoubleMatrix( rfc_ctx.residue_cnt, 1, mxREAL );
-                    if( re )
-                    {
-                        size_t i;
-                        double *val = mxGetPr(re);
-
-                        for( i = 0; i < rfc_ctx.residue_cnt; i++ )
-                        {
-                            *val++ = (double)rfc_ctx.residue[i].value;
-                        }
-                        plhs[1] = re;
-                    }
-                }
-            }
-
-            /* Rainflow matrix (column major order) */
-            if( nlhs > 2 && rfc_ctx.rfm )
-            {
-                mxArray* rfm = mxCreateDoubleMatrix( class_count, class_count, mxREAL );
-                if( rfm )
-                {
-                    double *ptr = mxGetPr(rfm);
-                    size_t from, to;
-                    for( to = 0; to < class_count; to++ )
-                    {
-                        for( from = 0; from < class_count; from++ )
-                        {
-                            *ptr++ = (double)rfc_ctx.rfm[ MAT_OFFS( from, to ) ] / rfc_ctx.full_inc;
-                        }
-                    }
-                    plhs[2] = rfm;
-                }
-            }
-            
-#if !RFC_MINIMAL
-            /* Range pair */
-            if( nlhs > 3 && rfc_ctx.rp )
-            {
-                mxArray* rp = mxCreateDoubleMatrix( class_count, 1, mxREAL );
-                if( rp )
-                {
-                    double *ptr = mxGetPr(rp);
-                    size_t i;
-                    for( i = 0; i < class_count; i++ )
-                    {
-                        *ptr++ = (double)rfc_ctx.rp[i] / rfc_ctx.curr_inc;
-                    }
-                    plhs[3] = rp;
-                }
-            }
-
-            /* Level crossing */
-            if( nlhs > 4 && rfc_ctx.lc )
-            {
-                mxArray* lc = mxCreateDoubleMatrix( class_count, 1, mxREAL );
-                if( lc )
-                {
-                    double *ptr = mxGetPr(lc);
-                    size_t i;
-                    for( i = 0; i < class_count; i++ )
-                    {
-                        *ptr++ = (double)rfc_ctx.lc[i];
-                    }
-                    plhs[4] = lc;
-                }
-            }
-#if RFC_TP_SUPPORT
-            /* Turning points */
-            if( nlhs > 5 && rfc_ctx.tp )
-            {
-#if RFC_DH_SUPPORT
-                mxArray *tp  = mxCreateDoubleMatrix( rfc_ctx.tp_cnt, 3, mxREAL );
-                double  *dam = tp ? ( mxGetPr(tp) + 2 * rfc_ctx.tp_cnt ) : NULL;
-#else /*!RFC_DH_SUPPORT*/
-                mxArray* tp  = mxCreateDoubleMatrix( rfc_ctx.tp_cnt, 2, mxREAL );
-#endif /*RFC_DH_SUPPORT*/
-
-                if( tp )
-                {
-                    size_t  i;
-                    double *idx  = mxGetPr(tp) + 0 * rfc_ctx.tp_cnt;
-                    double *val  = mxGetPr(tp) + 1 * rfc_ctx.tp_cnt;
-                    double  D    = 0.0;
-
-                    for( i = 0; i < rfc_ctx.tp_cnt; i++ )
-                    {
-                        *val++  = (double)rfc_ctx.tp[i].value;
-                        *idx++  = (double)rfc_ctx.tp[i].pos;
-#if RFC_DH_SUPPORT
-                        *dam++  = (double)rfc_ctx.tp[i].damage;
-                         D     += (double)rfc_ctx.tp[i].damage;
-#endif /*RFC_DH_SUPPORT*/
-                    }
-                    /* assert( D == rfc_ctx.damage ); */
-                    plhs[5] = tp;
-                }
-            }
-#endif /*RFC_TP_SUPPORT*/
-#if RFC_DH_SUPPORT
-            /* Turning points */
-            if( nlhs > 6 )
-            {
-                if( rfc_ctx.dh )
-                {
-                    mxArray *dh  = mxCreateDoubleMatrix( rfc_ctx.internal.pos, 1, mxREAL );
-                    double  *dh_ptr = dh ? mxGetPr(dh) : NULL;
-
-                    if( dh_ptr )
-                    {
-                        size_t i;
-
-                        for( i = 0; i < rfc_ctx.internal.pos; i++ )
-                        {
-                            *dh_ptr++ = rfc_ctx.dh[i];
-                        }
-                    }
-
-                    plhs[6] = dh;
-                }
-                else
-                {
-                    plhs[6] = mxCreateDoubleMatrix( 0, 0, mxREAL );
-                }
-            }
-#endif /*RFC_DH_SUPPORT*/
+        /* Return results */
+        if( plhs )
+        {
+#if !RFC_MINIMAL
+            mexExportResults( &rfc_ctx, nlhs, plhs, use_hcm );
+#else /*RFC_MINIMAL*/
+            mexExportResults( &rfc_ctx, nlhs, plhs, 0 );
 #endif /*!RFC_MINIMAL*/
         }
 
@@ -7777,6 +13352,373 @@ void mexTP( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 
 
 #if !RFC_MINIMAL
+/* Persistent contexts for the handle based streaming interface:
+   rfc('init',...) returns a handle, rfc('feed',handle,chunk) accumulates,
+   rfc('results',handle) finalizes and exports, rfc('deinit',handle) releases.
+   The slot table survives between mex invocations (mexMakeMemoryPersistent),
+   context internals live on the CRT heap and are released via mexAtExit. */
+#define MEX_CTX_SLOTS 16
+
+typedef struct mex_ctx_slot
+{
+    rfc_ctx_s   ctx;              /**< Rainflow context, kept alive across calls */
+    int         in_use;           /**< Slot is occupied */
+    int         finalized;        /**< Residual method applied, feeding closed */
+    int         use_hcm;          /**< Counting uses the HCM method */
+    int         residual_method;  /**< Residual method, applied on "results" */
+} mex_ctx_slot_s;
+
+static mex_ctx_slot_s *mex_ctx_slots = NULL;
+
+
+/**
+ * @brief      Release all persistent contexts (registered with mexAtExit)
+ */
+static
+void mexStreamCleanup( void )
+{
+    if( mex_ctx_slots )
+    {
+        int i;
+
+        for( i = 0; i < MEX_CTX_SLOTS; i++ )
+        {
+            if( mex_ctx_slots[i].in_use )
+            {
+                RFC_deinit( &mex_ctx_slots[i].ctx );
+                mex_ctx_slots[i].in_use = 0;
+            }
+        }
+        mxFree( mex_ctx_slots );
+        mex_ctx_slots = NULL;
+    }
+}
+
+
+/**
+ * @brief      Fetch an occupied context slot from a handle argument
+ *
+ * @param[in]  mxHandle  The handle returned by rfc('init',...)
+ *
+ * @return     The context slot (function does not return on error)
+ */
+static
+mex_ctx_slot_s* mexStreamSlot( const mxArray *mxHandle )
+{
+    int handle;
+
+    if( !mxIsNumeric( mxHandle ) || mxGetNumberOfElements( mxHandle ) != 1 )
+    {
+        mexErrMsgTxt( "Handle must be a numeric scalar!" );
+    }
+
+    handle = (int)( mxGetScalar( mxHandle ) + 0.5 );
+
+    if( !mex_ctx_slots || handle < 1 || handle > MEX_CTX_SLOTS || !mex_ctx_slots[handle-1].in_use )
+    {
+        mexErrMsgTxt( "Invalid handle, use rfc('init',...) first!" );
+    }
+
+    return &mex_ctx_slots[handle-1];
+}
+
+
+/**
+ * MATLAB wrapper initializing a persistent context, returns a handle
+ */
+static
+void mexStreamInit( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
+{
+    if( nrhs != 10 )
+    {
+        mexErrMsgTxt( "Function needs exact 10 arguments!" );
+    }
+    else
+    {
+        mex_ctx_slot_s *slot = NULL;
+        int             handle;
+        bool            ok;
+
+        unsigned        class_count     = (unsigned)( mxGetScalar( prhs[0] ) + 0.5 );
+        double          class_width     = mxGetScalar( prhs[1] );
+        double          class_offset    = mxGetScalar( prhs[2] );
+        double          hysteresis      = mxGetScalar( prhs[3] );
+        int             residual_method = (int)( mxGetScalar( prhs[4] ) + 0.5 );
+        int             enforce_margin  = (int)mxGetScalar( prhs[5] );
+        int             use_hcm         = (int)mxGetScalar( prhs[6] );
+        int             use_astm        = (int)mxGetScalar( prhs[7] );
+        int             spread_damage   = (int)mxGetScalar( prhs[8] );
+        int             auto_resize     = (int)mxGetScalar( prhs[9] );
+
+        mxAssert( residual_method >= 0 && residual_method < RFC_RES_COUNT,
+                  "Invalid residual method!" );
+
+#if RFC_HCM_SUPPORT
+        mxAssert( use_hcm == 0 || use_hcm == 1,
+                  "Invalid HCM flag, use 0 or 1!" );
+#else /*!RFC_HCM_SUPPORT*/
+        mxAssert( use_hcm == 0,
+                  "HCM not supported!" );
+#endif /*RFC_HCM_SUPPORT*/
+
+#if RFC_ASTM_SUPPORT
+        mxAssert( use_astm == 0 || use_astm == 1,
+                  "Invalid ASTM flag, use 0 or 1!" );
+#if RFC_HCM_SUPPORT
+        mxAssert( use_astm == 0 || use_hcm == 0,
+                  "Invalid ASTM flag, use either HCM or ASTM!" );
+#endif /*RFC_HCM_SUPPORT*/
+#else /*!RFC_ASTM_SUPPORT*/
+        mxAssert( use_astm == 0,
+                  "ASTM not supported!" );
+#endif /*RFC_ASTM_SUPPORT*/
+
+#if RFC_DH_SUPPORT
+        mxAssert( spread_damage >= RFC_SD_NONE && spread_damage < RFC_SD_COUNT,
+                  "Invalid spread damage method!" );
+#else /*!RFC_DH_SUPPORT*/
+        if( spread_damage != 0 )
+        {
+            mexErrMsgTxt( "Invalid spread damage method, only 0 accepted!" );
+        }
+#endif /*RFC_DH_SUPPORT*/
+
+#if RFC_AR_SUPPORT
+        mxAssert( auto_resize == 0 || auto_resize == 1,
+                  "Invalid auto resize flag, use 0 or 1!" );
+#else
+        if( auto_resize != 0 )
+        {
+            mexErrMsgTxt( "Invalid auto resize flag, only 0 accepted!" );
+        }
+#endif /*RFC_AR_SUPPORT*/
+
+        /* Create the persistent slot table on first use */
+        if( !mex_ctx_slots )
+        {
+            mex_ctx_slots = (mex_ctx_slot_s*)mxCalloc( MEX_CTX_SLOTS, sizeof(mex_ctx_slot_s) );
+
+            if( !mex_ctx_slots )
+            {
+                mexErrMsgTxt( "Error during memory allocation!" );
+            }
+
+            mexMakeMemoryPersistent( mex_ctx_slots );
+            mexAtExit( mexStreamCleanup );
+        }
+
+        for( handle = 0; handle < MEX_CTX_SLOTS; handle++ )
+        {
+            if( !mex_ctx_slots[handle].in_use )
+            {
+                slot = &mex_ctx_slots[handle];
+                break;
+            }
+        }
+
+        if( !slot )
+        {
+            mexErrMsgTxt( "All context slots occupied, use rfc('deinit',handle) first!" );
+        }
+
+        memset( slot, 0, sizeof(*slot) );
+        slot->ctx.version = sizeof(rfc_ctx_s);
+
+        ok = RFC_init( &slot->ctx,
+                       class_count, (rfc_value_t)class_width, (rfc_value_t)class_offset,
+                       (rfc_value_t)hysteresis, RFC_FLAGS_DEFAULT );
+        if( !ok )
+        {
+            RFC_deinit( &slot->ctx );
+            mexErrMsgTxt( "Error during initialization!" );
+        }
+
+#if RFC_DEBUG_FLAGS
+        slot->ctx.debug_vfprintf_fcn = rfc_vfprintf_fcn;
+#endif /*RFC_DEBUG_FLAGS*/
+
+#if RFC_TP_SUPPORT
+        ok = RFC_tp_init( &slot->ctx, /*tp*/ NULL, /*tp_cap*/ 128, /* is_static */ false );
+
+        if( !ok )
+        {
+            RFC_deinit( &slot->ctx );
+            mexErrMsgTxt( "Error during initialization (tp)!" );
+        }
+#endif /*RFC_TP_SUPPORT*/
+
+#if RFC_DH_SUPPORT
+        if( spread_damage >= RFC_SD_TRANSIENT_23 )
+        {
+            ok = RFC_dh_init( &slot->ctx, spread_damage, /*dh*/ NULL, /*dh_cap*/ 1, /*is_static*/ false );
+        }
+        else
+        {
+            ok = RFC_dh_init( &slot->ctx, spread_damage, /*dh*/ NULL, /*dh_cap*/ 0, /*is_static*/ true );
+        }
+
+        if( !ok )
+        {
+            RFC_deinit( &slot->ctx );
+            mexErrMsgTxt( "Error during initialization (dh)!" );
+        }
+#endif /*RFC_DH_SUPPORT*/
+
+#if RFC_AR_SUPPORT
+        if( auto_resize )
+        {
+            RFC_flags_set( &slot->ctx, RFC_FLAGS_AUTORESIZE, /* stack */ 0, /* overwrite */ false );
+        }
+#endif /*RFC_AR_SUPPORT*/
+
+        /* Setup */
+        slot->ctx.internal.flags |= enforce_margin ? RFC_FLAGS_ENFORCE_MARGIN : 0;
+
+#if RFC_HCM_SUPPORT && RFC_ASTM_SUPPORT
+             if( use_hcm )  slot->ctx.counting_method = RFC_COUNTING_METHOD_HCM;
+        else if( use_astm ) slot->ctx.counting_method = RFC_COUNTING_METHOD_ASTM;
+        else                slot->ctx.counting_method = RFC_COUNTING_METHOD_4PTM;
+#elif RFC_HCM_SUPPORT
+        if( use_hcm )       slot->ctx.counting_method = RFC_COUNTING_METHOD_HCM;
+        else                slot->ctx.counting_method = RFC_COUNTING_METHOD_4PTM;
+#elif RFC_ASTM_SUPPORT
+        if( use_astm )      slot->ctx.counting_method = RFC_COUNTING_METHOD_ASTM;
+        else                slot->ctx.counting_method = RFC_COUNTING_METHOD_4PTM;
+#else /*!(RFC_HCM_SUPPORT  || RFC_ASTM_SUPPORT)*/
+        slot->ctx.counting_method = RFC_COUNTING_METHOD_4PTM;
+#endif /*(RFC_HCM_SUPPORT  || RFC_ASTM_SUPPORT)*/
+
+        slot->use_hcm         = use_hcm;
+        slot->residual_method = residual_method;
+        slot->finalized       = 0;
+        slot->in_use          = 1;
+
+        if( plhs )
+        {
+            plhs[0] = mxCreateDoubleScalar( (double)( handle + 1 ) );
+        }
+    }
+}
+
+
+/**
+ * MATLAB wrapper feeding one chunk into a persistent context
+ */
+static
+void mexStreamFeed( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
+{
+    if( nrhs != 2 )
+    {
+        mexErrMsgTxt( "Function needs exact 2 arguments!" );
+    }
+    else
+    {
+        mex_ctx_slot_s *slot     = mexStreamSlot( prhs[0] );
+        const mxArray  *mxData   = prhs[1];
+        rfc_value_t    *buffer   = NULL;
+        double         *data     = mxGetPr( mxData );
+        size_t          data_len = mxGetNumberOfElements( mxData );
+        size_t          i;
+        bool            ok;
+
+        if( slot->finalized )
+        {
+            mexErrMsgTxt( "Context is already finalized, use rfc('init',...) for a new count!" );
+        }
+
+        /* Cast values from double type to rfc_value_t */
+        if( sizeof( rfc_value_t ) != sizeof(double) && data_len )  /* maybe unsafe! */
+        {
+            buffer = (rfc_value_t *)mem_alloc( NULL, data_len,
+                                               sizeof(rfc_value_t), RFC_MEM_AIM_TEMP );
+
+            if( !buffer )
+            {
+                mexErrMsgTxt( "Error during memory allocation!" );
+            }
+
+            for( i = 0; i < data_len; i++ )
+            {
+                buffer[i] = (rfc_value_t)data[i];
+            }
+        }
+        else buffer = (rfc_value_t*)data;
+
+        ok = RFC_feed( &slot->ctx, buffer, data_len );
+
+        /* Free temporary buffer (cast) */
+        if( (void*)buffer != (void*)data )
+        {
+            buffer = mem_alloc( buffer, 0, 0, RFC_MEM_AIM_TEMP );
+        }
+
+        if( !ok )
+        {
+            int error = slot->ctx.error;
+
+            RFC_deinit( &slot->ctx );
+            slot->in_use = 0;
+            mexRaiseError( error );
+        }
+    }
+}
+
+
+/**
+ * MATLAB wrapper finalizing a persistent context and exporting its results
+ */
+static
+void mexStreamResults( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
+{
+    if( nrhs != 1 )
+    {
+        mexErrMsgTxt( "Function needs exact 1 argument!" );
+    }
+    else
+    {
+        mex_ctx_slot_s *slot = mexStreamSlot( prhs[0] );
+
+        if( !slot->finalized )
+        {
+            if( !RFC_finalize( &slot->ctx, slot->residual_method ) )
+            {
+                int error = slot->ctx.error;
+
+                RFC_deinit( &slot->ctx );
+                slot->in_use = 0;
+                mexRaiseError( error );
+            }
+            slot->finalized = 1;
+        }
+
+        if( plhs )
+        {
+            mexExportResults( &slot->ctx, nlhs, plhs, slot->use_hcm );
+        }
+    }
+}
+
+
+/**
+ * MATLAB wrapper releasing a persistent context
+ */
+static
+void mexStreamDeinit( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
+{
+    if( nrhs != 1 )
+    {
+        mexErrMsgTxt( "Function needs exact 1 argument!" );
+    }
+    else
+    {
+        mex_ctx_slot_s *slot = mexStreamSlot( prhs[0] );
+
+        RFC_deinit( &slot->ctx );
+        slot->in_use = 0;
+    }
+}
+
+
 /**
  * @brief      Compare two string case insensitive
  *
@@ -7816,9 +13758,25 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
     }
 
     if( 0 == wal_stricmp( buffer, "rfc" ) )
-    { 
+    {
         mexRainflow( nlhs, plhs, nrhs - 1, prhs + 1 );
     }
+    else if( 0 == wal_stricmp( buffer, "init" ) )
+    {
+        mexStreamInit( nlhs, plhs, nrhs - 1, prhs + 1 );
+    }
+    else if( 0 == wal_stricmp( buffer, "feed" ) )
+    {
+        mexStreamFeed( nlhs, plhs, nrhs - 1, prhs + 1 );
+    }
+    else if( 0 == wal_stricmp( buffer, "results" ) )
+    {
+        mexStreamResults( nlhs, plhs, nrhs - 1, prhs + 1 );
+    }
+    else if( 0 == wal_stricmp( buffer, "deinit" ) )
+    {
+        mexStreamDeinit( nlhs, plhs, nrhs - 1, prhs + 1 );
+    }
 #if RFC_AT_SUPPORT
     else if( 0 == wal_stricmp( buffer, "amptransform" ) )
     {
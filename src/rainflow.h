@@ -116,13 +116,125 @@
 #define OFF (0)
 #endif /*OFF*/
 
-#define RFC_CLASS_COUNT_MAX (1024)
+#define RFC_CLASS_COUNT_MAX (4096)
 
 #ifndef RFC_VALUE_TYPE
 #define RFC_VALUE_TYPE double
 #endif /*RFC_VALUE_TYPE*/
 
-#if RFC_USE_INTEGRAL_COUNTS
+/* Defining RFC_VALUE_SUFFIX renames the entire function set by appending
+   _<suffix>, so differently typed builds link side by side into one binary,
+   e.g. RFC_VALUE_TYPE=float with RFC_VALUE_SUFFIX=f32 exports RFC_feed_f32.
+   All suffixed sets must agree on the remaining option flags. In C++ a mixed
+   precision translation unit includes this header once per set, the plain set
+   first, with RAINFLOW_H undefined and a distinct RFC_CPP_NAMESPACE each. */
+#ifdef RFC_VALUE_SUFFIX
+#define RFC_SUFFIXED_( name, suffix )   name ## _ ## suffix
+#define RFC_SUFFIXED( name, suffix )    RFC_SUFFIXED_( name, suffix )
+#define RFC_at_init                     RFC_SUFFIXED( RFC_at_init, RFC_VALUE_SUFFIX )
+#define RFC_at_lut_init                 RFC_SUFFIXED( RFC_at_lut_init, RFC_VALUE_SUFFIX )
+#define RFC_at_transform                RFC_SUFFIXED( RFC_at_transform, RFC_VALUE_SUFFIX )
+#define RFC_at_transform_batch          RFC_SUFFIXED( RFC_at_transform_batch, RFC_VALUE_SUFFIX )
+#define RFC_class_count                 RFC_SUFFIXED( RFC_class_count, RFC_VALUE_SUFFIX )
+#define RFC_class_mean                  RFC_SUFFIXED( RFC_class_mean, RFC_VALUE_SUFFIX )
+#define RFC_class_number                RFC_SUFFIXED( RFC_class_number, RFC_VALUE_SUFFIX )
+#define RFC_class_offset                RFC_SUFFIXED( RFC_class_offset, RFC_VALUE_SUFFIX )
+#define RFC_class_param_get             RFC_SUFFIXED( RFC_class_param_get, RFC_VALUE_SUFFIX )
+#define RFC_class_param_set             RFC_SUFFIXED( RFC_class_param_set, RFC_VALUE_SUFFIX )
+#define RFC_class_upper                 RFC_SUFFIXED( RFC_class_upper, RFC_VALUE_SUFFIX )
+#define RFC_class_width                 RFC_SUFFIXED( RFC_class_width, RFC_VALUE_SUFFIX )
+#define RFC_clear_counts                RFC_SUFFIXED( RFC_clear_counts, RFC_VALUE_SUFFIX )
+#define RFC_ctx_attach                  RFC_SUFFIXED( RFC_ctx_attach, RFC_VALUE_SUFFIX )
+#define RFC_ctx_deserialize             RFC_SUFFIXED( RFC_ctx_deserialize, RFC_VALUE_SUFFIX )
+#define RFC_ctx_detach                  RFC_SUFFIXED( RFC_ctx_detach, RFC_VALUE_SUFFIX )
+#define RFC_ctx_merge                   RFC_SUFFIXED( RFC_ctx_merge, RFC_VALUE_SUFFIX )
+#define RFC_ctx_serialize               RFC_SUFFIXED( RFC_ctx_serialize, RFC_VALUE_SUFFIX )
+#define RFC_cycle_process_counts        RFC_SUFFIXED( RFC_cycle_process_counts, RFC_VALUE_SUFFIX )
+#define RFC_damage                      RFC_SUFFIXED( RFC_damage, RFC_VALUE_SUFFIX )
+#define RFC_damage_from_rfm             RFC_SUFFIXED( RFC_damage_from_rfm, RFC_VALUE_SUFFIX )
+#define RFC_damage_from_rfm_wl          RFC_SUFFIXED( RFC_damage_from_rfm_wl, RFC_VALUE_SUFFIX )
+#define RFC_damage_from_rp              RFC_SUFFIXED( RFC_damage_from_rp, RFC_VALUE_SUFFIX )
+#define RFC_damage_lut_share            RFC_SUFFIXED( RFC_damage_lut_share, RFC_VALUE_SUFFIX )
+#define RFC_debug_fprintf               RFC_SUFFIXED( RFC_debug_fprintf, RFC_VALUE_SUFFIX )
+#define RFC_deinit                      RFC_SUFFIXED( RFC_deinit, RFC_VALUE_SUFFIX )
+#define RFC_dh_get                      RFC_SUFFIXED( RFC_dh_get, RFC_VALUE_SUFFIX )
+#define RFC_dh_init                     RFC_SUFFIXED( RFC_dh_init, RFC_VALUE_SUFFIX )
+#define RFC_dh_init_sparse              RFC_SUFFIXED( RFC_dh_init_sparse, RFC_VALUE_SUFFIX )
+#define RFC_dh_window_damage            RFC_SUFFIXED( RFC_dh_window_damage, RFC_VALUE_SUFFIX )
+#define RFC_error_get                   RFC_SUFFIXED( RFC_error_get, RFC_VALUE_SUFFIX )
+#define RFC_feed                        RFC_SUFFIXED( RFC_feed, RFC_VALUE_SUFFIX )
+#define RFC_feed_file                   RFC_SUFFIXED( RFC_feed_file, RFC_VALUE_SUFFIX )
+#define RFC_feed_ring_attach            RFC_SUFFIXED( RFC_feed_ring_attach, RFC_VALUE_SUFFIX )
+#define RFC_feed_ring_drain             RFC_SUFFIXED( RFC_feed_ring_drain, RFC_VALUE_SUFFIX )
+#define RFC_feed_ring_push              RFC_SUFFIXED( RFC_feed_ring_push, RFC_VALUE_SUFFIX )
+#define RFC_feed_scaled                 RFC_SUFFIXED( RFC_feed_scaled, RFC_VALUE_SUFFIX )
+#define RFC_feed_tuple                  RFC_SUFFIXED( RFC_feed_tuple, RFC_VALUE_SUFFIX )
+#define RFC_finalize                    RFC_SUFFIXED( RFC_finalize, RFC_VALUE_SUFFIX )
+#define RFC_finalize_preview            RFC_SUFFIXED( RFC_finalize_preview, RFC_VALUE_SUFFIX )
+#define RFC_flags_check                 RFC_SUFFIXED( RFC_flags_check, RFC_VALUE_SUFFIX )
+#define RFC_flags_get                   RFC_SUFFIXED( RFC_flags_get, RFC_VALUE_SUFFIX )
+#define RFC_flags_set                   RFC_SUFFIXED( RFC_flags_set, RFC_VALUE_SUFFIX )
+#define RFC_flags_unset                 RFC_SUFFIXED( RFC_flags_unset, RFC_VALUE_SUFFIX )
+#define RFC_hcm_init                    RFC_SUFFIXED( RFC_hcm_init, RFC_VALUE_SUFFIX )
+#define RFC_hysteresis                  RFC_SUFFIXED( RFC_hysteresis, RFC_VALUE_SUFFIX )
+#define RFC_init                        RFC_SUFFIXED( RFC_init, RFC_VALUE_SUFFIX )
+#define RFC_lc_from_residue             RFC_SUFFIXED( RFC_lc_from_residue, RFC_VALUE_SUFFIX )
+#define RFC_lc_from_residue_tuples      RFC_SUFFIXED( RFC_lc_from_residue_tuples, RFC_VALUE_SUFFIX )
+#define RFC_lc_from_rfm                 RFC_SUFFIXED( RFC_lc_from_rfm, RFC_VALUE_SUFFIX )
+#define RFC_lc_get                      RFC_SUFFIXED( RFC_lc_get, RFC_VALUE_SUFFIX )
+#define RFC_lc_get_delta                RFC_SUFFIXED( RFC_lc_get_delta, RFC_VALUE_SUFFIX )
+#define RFC_lc_view                     RFC_SUFFIXED( RFC_lc_view, RFC_VALUE_SUFFIX )
+#define RFC_mem_arena_init              RFC_SUFFIXED( RFC_mem_arena_init, RFC_VALUE_SUFFIX )
+#define RFC_res_get                     RFC_SUFFIXED( RFC_res_get, RFC_VALUE_SUFFIX )
+#define RFC_rfm_check                   RFC_SUFFIXED( RFC_rfm_check, RFC_VALUE_SUFFIX )
+#define RFC_rfm_damage                  RFC_SUFFIXED( RFC_rfm_damage, RFC_VALUE_SUFFIX )
+#define RFC_rfm_get                     RFC_SUFFIXED( RFC_rfm_get, RFC_VALUE_SUFFIX )
+#define RFC_rfm_init_sparse             RFC_SUFFIXED( RFC_rfm_init_sparse, RFC_VALUE_SUFFIX )
+#define RFC_rfm_make_symmetric          RFC_SUFFIXED( RFC_rfm_make_symmetric, RFC_VALUE_SUFFIX )
+#define RFC_rfm_non_zeros               RFC_SUFFIXED( RFC_rfm_non_zeros, RFC_VALUE_SUFFIX )
+#define RFC_rfm_peek                    RFC_SUFFIXED( RFC_rfm_peek, RFC_VALUE_SUFFIX )
+#define RFC_rfm_poke                    RFC_SUFFIXED( RFC_rfm_poke, RFC_VALUE_SUFFIX )
+#define RFC_rfm_refeed                  RFC_SUFFIXED( RFC_rfm_refeed, RFC_VALUE_SUFFIX )
+#define RFC_rfm_set                     RFC_SUFFIXED( RFC_rfm_set, RFC_VALUE_SUFFIX )
+#define RFC_rfm_sum                     RFC_SUFFIXED( RFC_rfm_sum, RFC_VALUE_SUFFIX )
+#define RFC_rp_from_rfm                 RFC_SUFFIXED( RFC_rp_from_rfm, RFC_VALUE_SUFFIX )
+#define RFC_rp_get                      RFC_SUFFIXED( RFC_rp_get, RFC_VALUE_SUFFIX )
+#define RFC_rp_get_delta                RFC_SUFFIXED( RFC_rp_get_delta, RFC_VALUE_SUFFIX )
+#define RFC_rp_view                     RFC_SUFFIXED( RFC_rp_view, RFC_VALUE_SUFFIX )
+#define RFC_state_get                   RFC_SUFFIXED( RFC_state_get, RFC_VALUE_SUFFIX )
+#define RFC_stats_get                   RFC_SUFFIXED( RFC_stats_get, RFC_VALUE_SUFFIX )
+#define RFC_stats_reset                 RFC_SUFFIXED( RFC_stats_reset, RFC_VALUE_SUFFIX )
+#define RFC_tp_clear                    RFC_SUFFIXED( RFC_tp_clear, RFC_VALUE_SUFFIX )
+#define RFC_tp_export_append            RFC_SUFFIXED( RFC_tp_export_append, RFC_VALUE_SUFFIX )
+#define RFC_tp_export_close             RFC_SUFFIXED( RFC_tp_export_close, RFC_VALUE_SUFFIX )
+#define RFC_tp_export_open              RFC_SUFFIXED( RFC_tp_export_open, RFC_VALUE_SUFFIX )
+#define RFC_tp_export_results           RFC_SUFFIXED( RFC_tp_export_results, RFC_VALUE_SUFFIX )
+#define RFC_tp_import                   RFC_SUFFIXED( RFC_tp_import, RFC_VALUE_SUFFIX )
+#define RFC_tp_init                     RFC_SUFFIXED( RFC_tp_init, RFC_VALUE_SUFFIX )
+#define RFC_tp_init_autoprune           RFC_SUFFIXED( RFC_tp_init_autoprune, RFC_VALUE_SUFFIX )
+#define RFC_tp_prune                    RFC_SUFFIXED( RFC_tp_prune, RFC_VALUE_SUFFIX )
+#define RFC_tp_refeed                   RFC_SUFFIXED( RFC_tp_refeed, RFC_VALUE_SUFFIX )
+#define RFC_wl_calc_k2                  RFC_SUFFIXED( RFC_wl_calc_k2, RFC_VALUE_SUFFIX )
+#define RFC_wl_calc_n                   RFC_SUFFIXED( RFC_wl_calc_n, RFC_VALUE_SUFFIX )
+#define RFC_wl_calc_sa                  RFC_SUFFIXED( RFC_wl_calc_sa, RFC_VALUE_SUFFIX )
+#define RFC_wl_calc_sd                  RFC_SUFFIXED( RFC_wl_calc_sd, RFC_VALUE_SUFFIX )
+#define RFC_wl_calc_sx                  RFC_SUFFIXED( RFC_wl_calc_sx, RFC_VALUE_SUFFIX )
+#define RFC_wl_init_any                 RFC_SUFFIXED( RFC_wl_init_any, RFC_VALUE_SUFFIX )
+#define RFC_wl_init_elementary          RFC_SUFFIXED( RFC_wl_init_elementary, RFC_VALUE_SUFFIX )
+#define RFC_wl_init_modified            RFC_SUFFIXED( RFC_wl_init_modified, RFC_VALUE_SUFFIX )
+#define RFC_wl_init_original            RFC_SUFFIXED( RFC_wl_init_original, RFC_VALUE_SUFFIX )
+#define RFC_wl_param_get                RFC_SUFFIXED( RFC_wl_param_get, RFC_VALUE_SUFFIX )
+#define RFC_wl_param_set                RFC_SUFFIXED( RFC_wl_param_set, RFC_VALUE_SUFFIX )
+#endif /*RFC_VALUE_SUFFIX*/
+
+#if RFC_USE_INTEGRAL_COUNTS > 1
+/* 32 bit counts halve the histogram footprint; increments saturate at
+   RFC_COUNTS_LIMIT and latch RFC_ERROR_COUNTS_SATURATED then, see RFC_error_get() */
+#define RFC_COUNTS_VALUE_TYPE    uint32_t
+#define RFC_FULL_CYCLE_INCREMENT (2)
+#define RFC_HALF_CYCLE_INCREMENT (1)
+#define RFC_COUNTS_LIMIT         (UINT32_MAX - RFC_FULL_CYCLE_INCREMENT) /* ~4.3e9 (eff. ~2.1e9) */
+#elif RFC_USE_INTEGRAL_COUNTS
 #define RFC_COUNTS_VALUE_TYPE    unsigned long long
 #define RFC_FULL_CYCLE_INCREMENT (2)
 #define RFC_HALF_CYCLE_INCREMENT (1)
@@ -153,6 +265,10 @@
 #define RFC_GLOBAL_EXTREMA   OFF
 #undef  RFC_DAMAGE_FAST
 #define RFC_DAMAGE_FAST      OFF
+#undef  RFC_STATS_SUPPORT
+#define RFC_STATS_SUPPORT    OFF
+#undef  RFC_FILE_SUPPORT
+#define RFC_FILE_SUPPORT     OFF
 #else /*!RFC_MINIMAL*/
 #ifndef RFC_MINIMAL
 #define RFC_MINIMAL OFF
@@ -184,6 +300,12 @@
 #ifndef RFC_DAMAGE_FAST
 #define RFC_DAMAGE_FAST ON
 #endif /*RFC_DAMAGE_FAST*/
+#ifndef RFC_STATS_SUPPORT
+#define RFC_STATS_SUPPORT OFF
+#endif /*RFC_STATS_SUPPORT*/
+#ifndef RFC_FILE_SUPPORT
+#define RFC_FILE_SUPPORT OFF
+#endif /*RFC_FILE_SUPPORT*/
 #ifndef RFC_DEBUG_FLAGS
 #define RFC_DEBUG_FLAGS OFF
 #endif /*RFC_DEBUG_FLAGS*/
@@ -353,6 +475,8 @@ enum rfc_error
 #endif /*RFC_DAMAGE_FAST*/
     RFC_ERROR_DATA_OUT_OF_RANGE     =  9,                           /**< Input data leaves classrange */
     RFC_ERROR_DATA_INCONSISTENT     =  10,                          /**< Processed data is inconsistent (internal error) */
+    RFC_ERROR_COUNTS_SATURATED      =  11,                          /**< A counting value saturated (RFC_USE_INTEGRAL_COUNTS > 1), counting proceeds clamped */
+    RFC_ERROR_FILE                  =  12,                          /**< File could not be opened, mapped or read, see RFC_feed_file() */
 };
 
 
@@ -409,6 +533,17 @@ enum rfc_sd_method
 #endif /*RFC_DH_SUPPORT*/
 
 
+#if RFC_FILE_SUPPORT
+enum rfc_file_format
+{
+    RFC_FILE_FORMAT_F64             = 0,                            /**< Raw IEEE-754 binary64 samples, host byte order */
+    RFC_FILE_FORMAT_F32             = 1,                            /**< Raw IEEE-754 binary32 samples, host byte order */
+    RFC_FILE_FORMAT_CSV             = 2,                            /**< Text records, one per line, fields split at ',', ';' or whitespace */
+    RFC_FILE_FORMAT_COUNT                                           /**< Number of options */
+};
+#endif /*RFC_FILE_SUPPORT*/
+
+
 enum rfc_wl_defaults
 {
     RFC_WL_SD_DEFAULT               =  1000,                        /**< Fatigue strength amplitude (Miner original) */
@@ -438,6 +573,19 @@ typedef     enum        rfc_sd_method           rfc_sd_method_e;            /**
 typedef     struct      rfc_class_param         rfc_class_param_s;          /** Class parameters (width, offset, count) */
 typedef     struct      rfc_wl_param            rfc_wl_param_s;             /** Woehler curve parameters (sd, nd, k, k2, omission) */
 typedef     struct      rfc_rfm_item            rfc_rfm_item_s;             /** Rainflow matrix element */
+typedef     struct      rfc_result              rfc_result_s;               /** Finalized results, see RFC_finalize_preview() */
+#if RFC_DH_SUPPORT
+typedef     struct      rfc_dh_item             rfc_dh_item_s;              /** Sparse damage history element, see RFC_dh_init_sparse() */
+#endif /*RFC_DH_SUPPORT*/
+typedef     struct      rfc_ring_buffer         rfc_ring_buffer_s;          /** Lock-free feed ring buffer, see RFC_feed_ring... */
+typedef     struct      rfc_mem_arena           rfc_mem_arena_s;            /** Arena allocator state (opaque), see RFC_mem_arena_init() */
+#if RFC_STATS_SUPPORT
+typedef     struct      rfc_stats               rfc_stats_s;                /** Hot path statistics, see RFC_stats_get() */
+#endif /*RFC_STATS_SUPPORT*/
+#if RFC_FILE_SUPPORT
+typedef     enum        rfc_file_format         rfc_file_format_e;          /** File format for RFC_feed_file() */
+typedef     struct      rfc_tp_export           rfc_tp_export_s;            /** Streaming turning point writer, see RFC_tp_export_open() */
+#endif /*RFC_FILE_SUPPORT*/
 #endif /*!RFC_MINIMAL*/
 
 /* Memory allocation functions typedef */
@@ -454,6 +602,7 @@ bool        RFC_wl_init_original        (       void *ctx, double sd, double nd,
 bool        RFC_wl_init_modified        (       void *ctx, double sx, double nx, double k, double k2 );
 bool        RFC_wl_init_any             (       void *ctx, const rfc_wl_param_s* wl_param );
 bool        RFC_clear_counts            (       void *ctx );
+bool        RFC_mem_arena_init          (       void *ctx, size_t size );
 #endif /*!RFC_MINIMAL*/
 bool        RFC_deinit                  (       void *ctx );
 bool        RFC_feed                    (       void *ctx, const rfc_value_t* data, size_t count );
@@ -461,10 +610,28 @@ bool        RFC_feed                    (       void *ctx, const rfc_value_t* da
 bool        RFC_cycle_process_counts    (       void *ctx, rfc_value_t from_val, rfc_value_t to_val, rfc_flags_e flags );
 bool        RFC_feed_scaled             (       void *ctx, const rfc_value_t* data, size_t count, double factor );
 bool        RFC_feed_tuple              (       void *ctx, rfc_value_tuple_s *data, size_t count );
+bool        RFC_ctx_merge               (       void *ctx, const void *ctx_src );
+bool        RFC_ctx_attach              (       void *ctx, void *ctx_follower );
+bool        RFC_ctx_detach              (       void *ctx, void *ctx_follower );
+bool        RFC_feed_ring_attach        (       void *ctx, rfc_ring_buffer_s *ring, rfc_value_t *buffer, size_t capacity );
+bool        RFC_feed_ring_push          (       rfc_ring_buffer_s *ring, const rfc_value_t *data, size_t count );
+bool        RFC_feed_ring_drain         (       void *ctx, size_t *count );
+bool        RFC_ctx_serialize           ( const void *ctx, void **buffer, size_t *buffer_size );
+bool        RFC_ctx_deserialize         (       void *ctx, const void *buffer, size_t buffer_size );
+#if RFC_FILE_SUPPORT
+bool        RFC_feed_file               (       void *ctx, const char *path, rfc_file_format_e format, unsigned channel_count, unsigned channel );
+bool        RFC_tp_export_open          (       void *ctx, rfc_tp_export_s *writer, const char *path, rfc_file_format_e value_format );
+bool        RFC_tp_export_append        (       void *ctx, rfc_tp_export_s *writer, const rfc_value_tuple_s *tp, size_t count );
+bool        RFC_tp_export_results       (       void *ctx, rfc_tp_export_s *writer );
+bool        RFC_tp_export_close         (       void *ctx, rfc_tp_export_s *writer );
+bool        RFC_tp_import               (       void *ctx, const char *path );
+#endif /*RFC_FILE_SUPPORT*/
 #endif /*!RFC_MINIMAL*/
 bool        RFC_finalize                (       void *ctx, rfc_res_method_e residual_method );
 #if !RFC_MINIMAL
+bool        RFC_finalize_preview        ( const void *ctx, rfc_res_method_e residual_method, rfc_result_s *result );
 /* Functions on rainflow matrix */
+bool        RFC_rfm_init_sparse         (       void *ctx, size_t cap );
 bool        RFC_rfm_make_symmetric      (       void *ctx );
 bool        RFC_rfm_non_zeros           ( const void *ctx, unsigned *count );
 bool        RFC_rfm_get                 ( const void *ctx, rfc_rfm_item_s **buffer, unsigned *count );
@@ -476,14 +643,19 @@ bool        RFC_rfm_damage              ( const void *ctx, unsigned from_first,
 bool        RFC_rfm_check               ( const void *ctx );
 bool        RFC_rfm_refeed              (       void *ctx, rfc_value_t new_hysteresis, const rfc_class_param_s *new_class_param );
 bool        RFC_lc_get                  ( const void *ctx, rfc_counts_t *lc, rfc_value_t *level );
+bool        RFC_lc_view                 ( const void *ctx, const rfc_counts_t **lc, size_t *version );
+bool        RFC_lc_get_delta            ( const void *ctx, size_t *version, unsigned *index, rfc_counts_t *counts, unsigned *count );
 bool        RFC_lc_from_rfm             ( const void *ctx, rfc_counts_t *lc, rfc_value_t *level, const rfc_counts_t *rfm, rfc_flags_e flags );
 bool        RFC_lc_from_residue_tuples  ( const void *ctx, rfc_counts_t *lc, rfc_value_t *level, const rfc_value_tuple_s* residue, unsigned residue_cnt, rfc_flags_e flags );
 bool        RFC_lc_from_residue         ( const void *ctx, rfc_counts_t *lc, rfc_value_t *level, const rfc_value_t* residue, unsigned residue_cnt, rfc_flags_e flags );
 bool        RFC_rp_get                  ( const void *ctx, rfc_counts_t *rp, rfc_value_t *Sa );
+bool        RFC_rp_view                 ( const void *ctx, const rfc_counts_t **rp, size_t *version );
+bool        RFC_rp_get_delta            ( const void *ctx, size_t *version, unsigned *index, rfc_counts_t *counts, unsigned *count );
 bool        RFC_rp_from_rfm             ( const void *ctx, rfc_counts_t *rp, rfc_value_t *Sa, const rfc_counts_t *rfm );
 bool        RFC_damage                  ( const void *ctx, rfc_value_t *damage, rfc_value_t *damage_residue );
 bool        RFC_damage_from_rp          ( const void *ctx, double *damage, const rfc_counts_t *counts, const rfc_value_t *Sa, rfc_rp_damage_method_e rp_calc_type );
 bool        RFC_damage_from_rfm         ( const void *ctx, double *damage, const rfc_counts_t *rfm );
+bool        RFC_damage_from_rfm_wl      ( const void *ctx, double *damage, const rfc_counts_t *rfm, const rfc_wl_param_s *wl_param, unsigned wl_param_count );
 bool        RFC_wl_calc_sx              ( const void *ctx, double s0, double n0, double k, double *sx, double nx, double  k2, double  sd, double nd );
 bool        RFC_wl_calc_sd              ( const void *ctx, double s0, double n0, double k, double  sx, double nx, double  k2, double *sd, double nd );
 bool        RFC_wl_calc_k2              ( const void *ctx, double s0, double n0, double k, double  sx, double nx, double *k2, double  sd, double nd );
@@ -491,6 +663,9 @@ bool        RFC_wl_calc_sa              ( const void *ctx, double s0, double n0,
 bool        RFC_wl_calc_n               ( const void *ctx, double s0, double n0, double k, double  sa, double *n );
 bool        RFC_wl_param_set            (       void *ctx, const rfc_wl_param_s * );
 bool        RFC_wl_param_get            ( const void *ctx, rfc_wl_param_s * );
+#if RFC_DAMAGE_FAST
+bool        RFC_damage_lut_share        (       void *ctx, void *ctx_src );
+#endif /*RFC_DAMAGE_FAST*/
 bool        RFC_class_param_set         (       void *ctx, const rfc_class_param_s * );
 bool        RFC_class_param_get         ( const void *ctx, rfc_class_param_s * );
 bool        RFC_class_number            ( const void *ctx, rfc_value_t value, unsigned *class_number );
@@ -505,6 +680,9 @@ bool        RFC_flags_unset             (       void *ctx, int flags, int stack
 bool        RFC_flags_get               ( const void *ctx, int *flags, int stack );
 bool        RFC_flags_check             ( const void *ctx, int flags_to_check, int stack );
 #endif /*!RFC_MINIMAL*/
+#if RFC_HCM_SUPPORT
+bool        RFC_hcm_init                (       void *ctx, rfc_value_tuple_s *stack, size_t stack_cap, bool is_static );
+#endif /*RFC_HCM_SUPPORT*/
 #if RFC_TP_SUPPORT
 bool        RFC_tp_init                 (       void *ctx, rfc_value_tuple_s *tp, size_t tp_cap, bool is_static );
 bool        RFC_tp_init_autoprune       (       void *ctx, bool autoprune, size_t size, size_t threshold );
@@ -512,16 +690,25 @@ bool        RFC_tp_prune                (       void *ctx, size_t count, rfc_fla
 bool        RFC_tp_refeed               (       void *ctx, rfc_value_t new_hysteresis, const rfc_class_param_s *new_class_param );
 bool        RFC_tp_clear                (       void *ctx );
 #endif /*RFC_TP_SUPPORT*/
+#if RFC_STATS_SUPPORT
+bool        RFC_stats_get               ( const void *ctx, rfc_stats_s *stats );
+bool        RFC_stats_reset             (       void *ctx );
+#endif /*RFC_STATS_SUPPORT*/
 bool        RFC_res_get                 ( const void *ctx, const rfc_value_tuple_s **residue, unsigned *count );
 #if RFC_DH_SUPPORT
 bool        RFC_dh_init                 (       void *ctx, rfc_sd_method_e method, double *dh, size_t dh_cap, bool is_static );
+bool        RFC_dh_init_sparse          (       void *ctx, rfc_sd_method_e method, size_t cap );
 bool        RFC_dh_get                  ( const void *ctx, const double **dh, size_t *count );
+bool        RFC_dh_window_damage        ( const void *ctx, size_t pos_from, size_t pos_to, double *damage );
 #endif /*RFC_DH_SUPPORT*/
 
 #if RFC_AT_SUPPORT
-bool        RFC_at_init                 (       void *ctx, const double *Sa, const double *Sm, unsigned count, 
+bool        RFC_at_init                 (       void *ctx, const double *Sa, const double *Sm, unsigned count,
                                                            double M, double Sm_rig, double R_rig, bool R_pinned, bool symmetric );
+bool        RFC_at_lut_init             (       void *ctx, double Sa_max, double Sm_min, double Sm_max,
+                                                           unsigned Sa_divisions, unsigned Sm_divisions );
 bool        RFC_at_transform            ( const void *ctx, double Sa, double Sm, double *Sa_transformed );
+bool        RFC_at_transform_batch      ( const void *ctx, const double *Sa, const double *Sm, double *Sa_transformed, size_t count );
 #endif /*RFC_AT_SUPPORT*/
 
 #if RFC_DEBUG_FLAGS
@@ -630,6 +817,73 @@ struct rfc_rfm_item
     unsigned                            to;                         /**< Ending class, base 0 */
     rfc_counts_t                        counts;                     /**< Counts */
 };
+
+#if RFC_DH_SUPPORT
+struct rfc_dh_item
+{
+    size_t                              pos;                        /**< Stream position, base 0 */
+    double                              damage;                     /**< Damage portion assigned to that position */
+};
+#endif /*RFC_DH_SUPPORT*/
+
+struct rfc_result
+{
+    double                              damage;                     /**< Total damage, as if the counting was finalized */
+    double                              damage_residue;             /**< Damage portion the residue contributes */
+    size_t                              residue_cnt;                /**< Number of turning points left in the residue */
+    rfc_counts_t                       *rfm;                        /**< Caller buffer for rainflow matrix cycle deltas, class_count^2 elements (optional, may be NULL) */
+    rfc_counts_t                       *rp;                         /**< Caller buffer for range pair count deltas, class_count elements (optional, may be NULL) */
+};
+
+/**
+ * Lock-free ring buffer between one data acquisition thread (producer) and
+ * one counting thread (consumer), see RFC_feed_ring_attach(). Producer and
+ * consumer each write their own index only, so no lock is needed. One slot
+ * always remains unused to tell a full buffer from an empty one.
+ */
+struct rfc_ring_buffer
+{
+    rfc_value_t                        *buffer;                     /**< Sample storage (caller owned) */
+    size_t                              capacity;                   /**< Buffer capacity in number of samples */
+    volatile size_t                     head;                       /**< Write index, advanced by RFC_feed_ring_push() only */
+    volatile size_t                     tail;                       /**< Read index, advanced by RFC_feed_ring_drain() only */
+};
+
+#if RFC_STATS_SUPPORT
+/**
+ * Hot path statistics, cheap always-on counters collected while counting.
+ * Read with RFC_stats_get(), reset with RFC_stats_reset().
+ */
+struct rfc_stats
+{
+    size_t                              samples_fed;                /**< Input samples consumed while feeding, prefilter-skipped ones included */
+    size_t                              tp_emitted;                 /**< Turning points put into the residue */
+    size_t                              cycles_4ptm;                /**< Cycles closed by cycle_find_4ptm() */
+    size_t                              cycles_hcm;                 /**< Cycles closed by cycle_find_hcm() */
+    size_t                              cycles_astm;                /**< Cycles (full and half) closed by cycle_find_astm() */
+    size_t                              residue_depth_max;          /**< Peak number of turning points in the residue */
+    size_t                              mem_allocs;                 /**< Allocations performed (fresh and resizing) */
+    size_t                              tp_prunes;                  /**< Turning point prunings carried out */
+};
+#endif /*RFC_STATS_SUPPORT*/
+
+#if RFC_FILE_SUPPORT
+#define RFC_TP_EXPORT_BUFFER            (4096)                      /**< Write buffer size in bytes, see RFC_tp_export_open() */
+
+/**
+ * Buffered streaming writer for turning point archives, see
+ * RFC_tp_export_open(). All fields are maintained by the writer functions.
+ */
+struct rfc_tp_export
+{
+    void                               *file;                       /**< Output stream (FILE*) */
+    int                                 value_format;               /**< RFC_FILE_FORMAT_F64 or RFC_FILE_FORMAT_F32 */
+    size_t                              pos_prev;                   /**< Last written stream position, positions are delta encoded */
+    size_t                              tp_cnt;                     /**< Number of turning points written so far */
+    size_t                              buffer_cnt;                 /**< Bytes pending in .buffer */
+    unsigned char                       buffer[RFC_TP_EXPORT_BUFFER]; /**< Write buffer, flushed when full and on close */
+};
+#endif /*RFC_FILE_SUPPORT*/
 #endif /*!RFC_MINIMAL*/
 
 
@@ -712,6 +966,22 @@ struct rfc_ctx
 #if !RFC_MINIMAL
     rfc_counts_t                       *rp;                         /**< Range pair counts, always class_count elements */
     rfc_counts_t                       *lc;                         /**< Level crossing counts, always class_count elements. Every per .flags selected slope increments by .full_inc! */
+
+    /* Histogram modification stamps for delta readout (see RFC_rp_get_delta(), RFC_lc_get_delta()) */
+    size_t                             *rp_bin_version;             /**< Version of the last modification per bin of .rp, class_count elements */
+    size_t                             *lc_bin_version;             /**< Version of the last modification per bin of .lc, class_count elements */
+    size_t                              rp_version;                 /**< Monotonic version of .rp, bumped on each modification */
+    size_t                              lc_version;                 /**< Monotonic version of .lc, bumped on each modification */
+
+    /* Sparse rainflow matrix storage (optional alternative to .rfm, see RFC_rfm_init_sparse()) */
+    rfc_rfm_item_s                     *rfm_sparse;                 /**< Hash table (open addressing), .from == (unsigned)-1 denotes a free slot */
+    size_t                              rfm_sparse_cap;             /**< Table capacity in elements, always a power of two */
+    size_t                              rfm_sparse_cnt;             /**< Number of occupied elements */
+
+    /* Follower contexts, counting the same turning points on their own class grids (see RFC_ctx_attach()) */
+    rfc_ctx_s                         **followers;                  /**< Attached follower contexts (not owned) */
+    unsigned                            follower_cnt;               /**< Number of attached followers */
+    unsigned                            follower_cap;               /**< Capacity of .followers in elements */
 #endif /*!RFC_MINIMAL*/
 
 #if RFC_TP_SUPPORT
@@ -729,12 +999,18 @@ struct rfc_ctx
     double                             *dh;                         /**< Damage history, pointer may be changed whilst memory reallocation! */
     size_t                              dh_cap;                     /**< Capacity of dh */
     size_t                              dh_cnt;                     /**< Number of values in dh */
+    /* Sparse damage history storage (optional alternative to .dh, see RFC_dh_init_sparse()) */
+    rfc_dh_item_s                      *dh_sparse;                  /**< Items with assigned damage, ascending by .pos */
+    size_t                              dh_sparse_cap;              /**< Capacity of dh_sparse in elements */
+    size_t                              dh_sparse_cnt;              /**< Number of elements in dh_sparse */
 #endif /*RFC_DH_SUPPORT*/
 
     /* Damage */
 #if RFC_DAMAGE_FAST
-    double                             *damage_lut;                 /**< Damage look-up table */
+    double                             *damage_lut;                 /**< Damage look-up table, filled lazily row by row on first access */
     int                                 damage_lut_inapt;           /**< Greater 0, if values in damage_lut aren't proper to Woehler curve parameters */
+    unsigned char                      *damage_lut_row_valid;       /**< Fill state per row of .damage_lut, class_count elements */
+    size_t                             *damage_lut_refcnt;          /**< Reference count when look-up tables are shared (see RFC_damage_lut_share()), NULL if exclusively owned */
 #if RFC_AT_SUPPORT
     double                             *amplitude_lut;              /**< Amplitude look-up table, only valid if damage_lut_inapt == 0 */
 #endif /*RFC_AT_SUPPORT*/
@@ -752,8 +1028,21 @@ struct rfc_ctx
         double                          Sm_rig;
         double                          R_rig;
         bool                            R_pinned;
-    }                                   
+    }
                                         at;
+
+    struct at_lut
+    {
+        double                         *grid;                       /**< Dense (Sa,Sm) transform grid, sa_divisions+1 rows of sm_divisions+1 nodes, see RFC_at_lut_init() */
+        unsigned                        sa_divisions;               /**< Number of grid cells along the amplitude axis */
+        unsigned                        sm_divisions;               /**< Number of grid cells along the mean load axis */
+        double                          sa_max;                     /**< Grid covers amplitudes [0, sa_max] */
+        double                          sm_min;                     /**< Grid covers mean loads [sm_min, sm_max] */
+        double                          sm_max;                     /**< Upper mean load bound of the grid */
+        double                          sa_scale;                   /**< Reciprocal grid spacing along the amplitude axis */
+        double                          sm_scale;                   /**< Reciprocal grid spacing along the mean load axis */
+    }
+                                        at_lut;
 #endif /*RFC_AT_SUPPORT*/
 
     /* Internal usage */
@@ -778,11 +1067,18 @@ struct rfc_ctx
         bool                            res_static;                 /**< true, if .residue refers the static residue .internal.residue */
 #if !RFC_MINIMAL
         rfc_wl_param_s                  wl;                         /**< Shadowed Woehler curve parameters */
+        rfc_ring_buffer_s              *ring;                       /**< Attached feed ring buffer (optional, may be NULL), see RFC_feed_ring_attach() */
+        rfc_mem_arena_s                *arena;                      /**< Arena allocator (optional, may be NULL), see RFC_mem_arena_init() */
+#if RFC_STATS_SUPPORT
+        rfc_stats_s                     stats;                      /**< Hot path statistics, see RFC_stats_get() */
+#endif /*RFC_STATS_SUPPORT*/
 #endif /*!RFC_MINIMAL*/
 #if RFC_TP_SUPPORT
         rfc_value_tuple_s               margin[2];                  /**< First and last data point */
         int                             margin_stage;               /**< 0: Init, 1: Left margin set, 2: 1st turning point is safe */
         bool                            tp_static;                  /**< true, if tp is statically allocated */
+        size_t                          tp_prune_removal;           /**< Pending incremental prune: number of removed leading turning points, not compacted yet (0 = none pending) */
+        size_t                          tp_prune_moved;             /**< Pending incremental prune: number of turning points already moved to the front */
 #endif /*RFC_TP_SUPPORT*/
 #if RFC_DH_SUPPORT
         bool                            dh_static;                  /**< true, if dh is statically allocated */
@@ -793,6 +1089,7 @@ struct rfc_ctx
             /* Residue */
             rfc_value_tuple_s          *stack;                      /**< Stack */
             size_t                      stack_cap;                  /**< Stack capacity in number of elements (max. 2*class_count) */
+            bool                        stack_static;               /**< true, if stack is statically allocated, see RFC_hcm_init() */
             int                         IR;                         /**< Pointer to residue stack, first turning point of cycles able to close, base 1 */
             int                         IZ;                         /**< Pointer to residue stack, last turning point of cycles able to close, base 1 */
         }                               hcm;
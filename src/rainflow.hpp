@@ -37,16 +37,37 @@
 
 
 
-#pragma once
+/* All declarations live in RFC_CPP_NAMESPACE; the first inclusion exports
+ * them unqualified for compatibility. A mixed precision translation unit
+ * includes this header once per value type, the plain set first:
+ *
+ *     #include "rainflow.hpp"                  // double, rainflow_C
+ *     #undef RAINFLOW_H
+ *     #undef RAINFLOW_HPP
+ *     #undef RFC_VALUE_TYPE
+ *     #define RFC_VALUE_TYPE    float
+ *     #define RFC_VALUE_SUFFIX  f32            // links against RFC_*_f32
+ *     #define RFC_CPP_NAMESPACE rainflow_C_f32
+ *     #include "rainflow.hpp"                  // rainflow_C_f32::Rainflow
+ */
+#ifndef RAINFLOW_HPP
+#define RAINFLOW_HPP
 
 #include <vector>
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
 #include "rainflow.h"
 
 #pragma pack(push, 1)
 
+namespace RFC_CPP_NAMESPACE {
+
 /* Suppose correct configuration */
 static
 char compiler_assert_rfc_config
@@ -195,6 +216,8 @@ public:
         RFC_ERROR_LUT                           = RF::RFC_ERROR_LUT,                            /**< Error while accessing look up tables */
         RFC_ERROR_DATA_OUT_OF_RANGE             = RF::RFC_ERROR_DATA_OUT_OF_RANGE,              /**< Input data leaves classrange */
         RFC_ERROR_DATA_INCONSISTENT             = RF::RFC_ERROR_DATA_INCONSISTENT,              /**< Processed data is inconsistent (internal error) */
+        RFC_ERROR_COUNTS_SATURATED              = RF::RFC_ERROR_COUNTS_SATURATED,               /**< A counting value saturated (RFC_USE_INTEGRAL_COUNTS > 1), counting proceeds clamped */
+        RFC_ERROR_FILE                          = RF::RFC_ERROR_FILE,                           /**< File could not be opened, mapped or read, see RFC_feed_file() */
     };
 
 
@@ -294,8 +317,16 @@ public:
     bool            cycle_process_counts    ( rfc_value_t from_val, rfc_value_t to_val, rfc_flags_e flags );
     bool            feed_scaled             ( const rfc_value_t* data, size_t count, double factor );
     bool            feed_tuple              ( rfc_value_tuple_s *data, size_t count );
+    bool            merge                   ( const RainflowT &rhs );
+    bool            attach                  ( RainflowT &follower );
+    bool            detach                  ( RainflowT &follower );
+    bool            damage_lut_share        ( RainflowT &src );
+    bool            ctx_serialize           ( void **buffer, size_t *buffer_size ) const;
+    bool            ctx_deserialize         ( const void *buffer, size_t buffer_size );
     bool            finalize                ( rfc_res_method_e residual_method = RFC_RES_IGNORE );
-    /* Functions on rainflow matrix */           
+    bool            finalize_preview        ( rfc_res_method_e residual_method, RF::rfc_result_s *result ) const;
+    /* Functions on rainflow matrix */
+    bool            rfm_init_sparse         ( size_t cap = 0 );
     bool            rfm_make_symmetric      ();
     bool            rfm_non_zeros           ( unsigned *count ) const;
     bool            rfm_get                 ( rfc_rfm_item_s **buffer, unsigned *count ) const;
@@ -308,14 +339,19 @@ public:
     bool            rfm_refeed              ( rfc_value_t new_hysteresis, const rfc_class_param_s *new_class_param );
 /* Functions on histograms */           
     bool            lc_get                  ( rfc_counts_t *lc, rfc_value_t *level ) const;
+    bool            lc_view                 ( const rfc_counts_t **lc, size_t *version ) const;
+    bool            lc_get_delta            ( size_t *version, unsigned *index, rfc_counts_t *counts, unsigned *count ) const;
     bool            lc_from_rfm             ( rfc_counts_t *lc, rfc_value_t *level, const rfc_counts_t *rfm, rfc_flags_e flags ) const;
     bool            lc_from_residue         ( rfc_counts_t *lc, rfc_value_t *level, const rfc_value_tuple_s* residue, unsigned residue_cnt, rfc_flags_e flags ) const;
     bool            lc_from_residue         ( rfc_counts_t *lc, rfc_value_t *level, const rfc_value_t* residue, unsigned residue_cnt, rfc_flags_e flags ) const;
     bool            rp_get                  ( rfc_counts_t *rp, rfc_value_t *Sa ) const;
+    bool            rp_view                 ( const rfc_counts_t **rp, size_t *version ) const;
+    bool            rp_get_delta            ( size_t *version, unsigned *index, rfc_counts_t *counts, unsigned *count ) const;
     bool            rp_from_rfm             ( rfc_counts_t *rp, rfc_value_t *Sa, const rfc_counts_t *rfm ) const;
     bool            damage                  ( rfc_value_t *damage = NULL, rfc_value_t *damage_residue = NULL ) const;
     bool            damage_from_rp          ( double *damage, const rfc_counts_t *counts, const rfc_value_t *Sa, rfc_rp_damage_method_e rp_calc_type ) const;
     bool            damage_from_rfm         ( double *damage, const rfc_counts_t *rfm ) const;
+    bool            damage_from_rfm_wl      ( double *damage, const rfc_counts_t *rfm, const rfc_wl_param_s *wl_param, unsigned wl_param_count ) const;
     /* Woehler curve */
     bool            wl_calc_sx              ( double s0, double n0, double k, double *sx, double nx, double  k2, double  sd, double nd ) const;
     bool            wl_calc_sd              ( double s0, double n0, double k, double  sx, double nx, double  k2, double *sd, double nd ) const;
@@ -326,16 +362,22 @@ public:
     bool            tp_init_autoprune       ( bool autoprune, size_t size, size_t threshold );
     bool            tp_prune                ( size_t count, rfc_flags_e flags );
     bool            tp_refeed               ( rfc_value_t new_hysteresis, const rfc_class_param_s *new_class_param );
+    bool            tp_refeed_parallel      ( rfc_value_t new_hysteresis, const rfc_class_param_s *new_class_param, unsigned num_threads = 0 );
     bool            tp_clear                ();
     /* Residuum */
     bool            res_get                 ( const rfc_value_tuple_s **residue, unsigned *count ) const;
     /* Damage history */
     bool            dh_init                 ( rfc_sd_method_e method, double *dh, size_t dh_cap, bool is_static );
+    bool            dh_init_sparse          ( rfc_sd_method_e method, size_t cap );
     bool            dh_get                  ( const double **dh, size_t *count ) const;
+    bool            dh_window_damage        ( size_t pos_from, size_t pos_to, double *damage ) const;
     /* Amplitude transformation*/
-    bool            at_init                 ( const double *Sa, const double *Sm, unsigned count, 
+    bool            at_init                 ( const double *Sa, const double *Sm, unsigned count,
                                               double M, double Sm_rig, double R_rig, bool R_pinned, bool symmetric );
+    bool            at_lut_init             ( double Sa_max = 0, double Sm_min = 0, double Sm_max = 0,
+                                              unsigned Sa_divisions = 0, unsigned Sm_divisions = 0 );
     bool            at_transform            ( double Sa, double Sm, double *Sa_transformed ) const;
+    bool            at_transform_batch      ( const double *Sa, const double *Sm, double *Sa_transformed, size_t count ) const;
     /* Flags */
     bool            flags_set               ( int flags, bool debugging = false, bool overwrite = true );
     bool            flags_unset             ( int flags, bool debugging = false );
@@ -551,6 +593,48 @@ bool RainflowT<T>::feed_tuple( rfc_value_tuple_s *data, size_t count )
 }
 
 
+template< class T >
+bool RainflowT<T>::merge( const RainflowT &rhs )
+{
+    return RF::RFC_ctx_merge( &m_ctx, &rhs.ctx_get() );
+}
+
+
+template< class T >
+bool RainflowT<T>::attach( RainflowT &follower )
+{
+    return RF::RFC_ctx_attach( &m_ctx, &follower.ctx_get() );
+}
+
+
+template< class T >
+bool RainflowT<T>::detach( RainflowT &follower )
+{
+    return RF::RFC_ctx_detach( &m_ctx, &follower.ctx_get() );
+}
+
+
+template< class T >
+bool RainflowT<T>::damage_lut_share( RainflowT &src )
+{
+    return RF::RFC_damage_lut_share( &m_ctx, &src.ctx_get() );
+}
+
+
+template< class T >
+bool RainflowT<T>::ctx_serialize( void **buffer, size_t *buffer_size ) const
+{
+    return RF::RFC_ctx_serialize( &ctx_get(), buffer, buffer_size );
+}
+
+
+template< class T >
+bool RainflowT<T>::ctx_deserialize( const void *buffer, size_t buffer_size )
+{
+    return RF::RFC_ctx_deserialize( &m_ctx, buffer, buffer_size );
+}
+
+
 template< class T >
 bool RainflowT<T>::finalize( rfc_res_method_e residual_method )
 {
@@ -558,6 +642,20 @@ bool RainflowT<T>::finalize( rfc_res_method_e residual_method )
 }
 
 
+template< class T >
+bool RainflowT<T>::finalize_preview( rfc_res_method_e residual_method, RF::rfc_result_s *result ) const
+{
+    return RF::RFC_finalize_preview( &m_ctx, (RF::rfc_res_method_e)residual_method, result );
+}
+
+
+template< class T >
+bool RainflowT<T>::rfm_init_sparse( size_t cap )
+{
+    return RF::RFC_rfm_init_sparse( &m_ctx, cap );
+}
+
+
 template< class T >
 bool RainflowT<T>::rfm_make_symmetric()
 {
@@ -635,6 +733,20 @@ bool RainflowT<T>::lc_get( rfc_counts_t *lc, rfc_value_t *level ) const
 }
 
 
+template< class T >
+bool RainflowT<T>::lc_view( const rfc_counts_t **lc, size_t *version ) const
+{
+    return RF::RFC_lc_view( &m_ctx, (const RF::rfc_counts_t **)lc, version );
+}
+
+
+template< class T >
+bool RainflowT<T>::lc_get_delta( size_t *version, unsigned *index, rfc_counts_t *counts, unsigned *count ) const
+{
+    return RF::RFC_lc_get_delta( &m_ctx, version, index, (RF::rfc_counts_t *)counts, count );
+}
+
+
 template< class T >
 bool RainflowT<T>::lc_from_rfm( rfc_counts_t *lc, rfc_value_t *level, const rfc_counts_t *rfm, rfc_flags_e flags ) const
 {
@@ -663,6 +775,20 @@ bool RainflowT<T>::rp_get( rfc_counts_t *rp, rfc_value_t *Sa ) const
 }
 
 
+template< class T >
+bool RainflowT<T>::rp_view( const rfc_counts_t **rp, size_t *version ) const
+{
+    return RF::RFC_rp_view( &m_ctx, (const RF::rfc_counts_t **)rp, version );
+}
+
+
+template< class T >
+bool RainflowT<T>::rp_get_delta( size_t *version, unsigned *index, rfc_counts_t *counts, unsigned *count ) const
+{
+    return RF::RFC_rp_get_delta( &m_ctx, version, index, (RF::rfc_counts_t *)counts, count );
+}
+
+
 template< class T >
 bool RainflowT<T>::rp_from_rfm( rfc_counts_t *rp, rfc_value_t *Sa, const rfc_counts_t *rfm ) const
 {
@@ -690,6 +816,13 @@ bool RainflowT<T>::damage_from_rfm( double *damage, const rfc_counts_t *rfm ) co
 }
 
 
+template< class T >
+bool RainflowT<T>::damage_from_rfm_wl( double *damage, const rfc_counts_t *rfm, const rfc_wl_param_s *wl_param, unsigned wl_param_count ) const
+{
+    return RF::RFC_damage_from_rfm_wl( &m_ctx, damage, (const RF::rfc_counts_t *)rfm, (const RF::rfc_wl_param_s *)wl_param, wl_param_count );
+}
+
+
 template< class T >
 bool RainflowT<T>::wl_calc_sx( double s0, double n0, double k, double *sx, double nx, double  k2, double  sd, double nd ) const
 {
@@ -758,6 +891,329 @@ bool RainflowT<T>::tp_refeed( rfc_value_t new_hysteresis, const rfc_class_param_
 }
 
 
+/* Find a turning point by its stream position (positions strictly ascending),
+   returns tp.size() if not found */
+static inline
+size_t tp_refeed_parallel_find( const std::vector<RF::rfc_value_tuple_s> &tp, size_t pos )
+{
+    size_t lo = 0, hi = tp.size();
+
+    while( lo < hi )
+    {
+        size_t mid = lo + ( hi - lo ) / 2;
+
+        if( tp[mid].pos < pos )
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return ( lo < tp.size() && tp[lo].pos == pos ) ? lo : tp.size();
+}
+
+
+/* Multithreaded variant of tp_refeed(): The turning point history is split into
+   contiguous partitions, counted concurrently into thread local contexts and
+   recombined in stream order (see merge()). Counting results match tp_refeed()
+   up to boundary effects at the partition seams, where the hysteresis filter
+   starts over without upstream state: single turning points may differ there,
+   occasionally shifting one cycle to an adjacent class.
+   Falls back to tp_refeed(), if the configuration rules out partitioned counting. */
+template< class T >
+bool RainflowT<T>::tp_refeed_parallel( rfc_value_t new_hysteresis, const rfc_class_param_s *new_class_param, unsigned num_threads )
+{
+    std::vector<RF::rfc_value_tuple_s>  history;
+    std::vector<RainflowT*>             workers;
+    std::vector<std::thread>            threads;
+    std::vector<int>                    feed_ok;
+    rfc_wl_param_s                      wl_param;
+    RF::rfc_value_tuple_s               extrema[2] = { { 0 }, { 0 } };  /* [0]=min, [1]=max */
+    size_t                              history_cnt, part_len, pos, pos_offset, i;
+    unsigned                            class_count, t;
+    rfc_value_t                         class_width, class_offset;
+    int                                 flags;
+    bool                                ok = true;
+
+    if( !num_threads )
+    {
+        num_threads = std::thread::hardware_concurrency();
+    }
+
+    history_cnt = m_ctx.tp_cnt + ( ( m_ctx.state == RF::RFC_STATE_BUSY_INTERIM ) ? 1 : 0 );
+
+    if( new_class_param )
+    {
+        class_count  = new_class_param->count;
+        class_width  = new_class_param->width;
+        class_offset = new_class_param->offset;
+    }
+    else
+    {
+        class_count  = m_ctx.class_count;
+        class_width  = m_ctx.class_width;
+        class_offset = m_ctx.class_offset;
+    }
+
+    if( !flags_get( &flags ) )
+    {
+        return false;
+    }
+
+    /* Partitioned counting requires classes and the plain stream filter; any
+       other configuration is handled by the single threaded path */
+    if( num_threads < 2                                             ||
+        history_cnt < (size_t)num_threads * 1024                    ||
+        !class_count || !m_ctx.class_count                          ||
+        m_ctx.state <  RF::RFC_STATE_INIT                           ||
+        m_ctx.state >= RF::RFC_STATE_FINISHED                       ||
+        new_hysteresis < m_ctx.hysteresis                           ||
+        m_ctx.counting_method == RF::RFC_COUNTING_METHOD_HCM        ||
+        m_ctx.tp_locked                                             ||
+        m_ctx.dh                                                    ||
+#ifndef RFC_TP_STORAGE
+        !m_ctx.tp                                                   ||
+#endif /*!RFC_TP_STORAGE*/
+        ( flags & ( RFC_FLAGS_ENFORCE_MARGIN | RFC_FLAGS_TPAUTOPRUNE | RFC_FLAGS_AUTORESIZE ) ) )
+    {
+        return tp_refeed( new_hysteresis, new_class_param );
+    }
+
+    /* Collect the current history, requantized to the new class parameters */
+    history.resize( history_cnt );
+    for( i = 0; i < history_cnt; i++ )
+    {
+        const RF::rfc_value_tuple_s *pt_src;
+        RF::rfc_value_tuple_s        pt = { 0 };
+
+        if( i < m_ctx.tp_cnt )
+        {
+#ifdef RFC_TP_STORAGE
+            pt_src = &m_tp[i];
+#else /*!RFC_TP_STORAGE*/
+            pt_src = &m_ctx.tp[i];
+#endif /*RFC_TP_STORAGE*/
+        }
+        else
+        {
+            /* A pending interim turning point resides beyond the residue */
+            pt_src = &m_ctx.residue[m_ctx.residue_cnt];
+        }
+
+        pt.value   = pt_src->value;
+        pt.pos     = pt_src->pos;
+        pt.cls     = (unsigned)( ( pt.value - class_offset ) / class_width );
+        history[i] = pt;
+
+        if( !i || pt.value < extrema[0].value ) extrema[0] = pt;
+        if( !i || pt.value > extrema[1].value ) extrema[1] = pt;
+    }
+
+    pos        = m_ctx.internal.pos;
+    pos_offset = m_ctx.internal.pos_offset;
+
+    /* Reconfigure this context with the new parameters on an empty history */
+    if( !tp_clear() || !RF::RFC_tp_refeed( &m_ctx, new_hysteresis, new_class_param ) )
+    {
+        return false;
+    }
+
+    if( !clear_counts() || !tp_clear() )
+    {
+        return false;
+    }
+    m_tp.resize( m_ctx.tp_cnt );
+
+    if( !wl_param_get( wl_param ) )
+    {
+        return false;
+    }
+
+    /* Count partitions into thread local contexts */
+    part_len = ( history_cnt + num_threads - 1 ) / num_threads;
+    feed_ok.resize( num_threads, 0 );
+
+    for( t = 0; t < num_threads && (size_t)t * part_len < history_cnt; t++ )
+    {
+        RainflowT             *w     = new RainflowT;
+        size_t                 start = (size_t)t * part_len;
+        size_t                 len   = ( start + part_len < history_cnt ) ? part_len : ( history_cnt - start );
+        RF::rfc_value_tuple_s *part  = &history[start];
+        int                   *result;
+
+        workers.push_back( w );
+
+        if( !w->init( class_count, class_width, class_offset, new_hysteresis, (rfc_flags_e)flags ) ||
+            !w->wl_init_any( &wl_param ) )
+        {
+            ok = false;
+            break;
+        }
+
+        w->ctx_get().counting_method = m_ctx.counting_method;
+
+        if( m_ctx.at.count && !w->at_init( m_ctx.at.Sa, m_ctx.at.Sm, m_ctx.at.count, m_ctx.at.M,
+                                           m_ctx.at.Sm_rig, m_ctx.at.R_rig, m_ctx.at.R_pinned, /*symmetric*/ false ) )
+        {
+            ok = false;
+            break;
+        }
+
+#ifndef RFC_TP_STORAGE
+        if( !RF::RFC_tp_init( &w->ctx_get(), NULL, len + 1, false ) )
+        {
+            ok = false;
+            break;
+        }
+#endif /*!RFC_TP_STORAGE*/
+
+        result = &feed_ok[t];
+        threads.push_back( std::thread( [w, part, len, result]() { *result = w->feed_tuple( part, len ) ? 1 : 0; } ) );
+    }
+
+    for( i = 0; i < threads.size(); i++ )
+    {
+        threads[i].join();
+    }
+
+    for( t = 0; ok && t < (unsigned)threads.size(); t++ )
+    {
+        ok = feed_ok[t] != 0;
+    }
+
+    /* Recombine in stream order */
+    for( t = 0; ok && t < (unsigned)workers.size(); t++ )
+    {
+        ok = merge( *workers[t] );
+    }
+
+    if( ok )
+    {
+        /* Merging fed the worker residues across the seams, appending their points
+           as turning points here. Replace them by the full requantized history and
+           carry any damage assigned at the seams over (see spread_damage()) */
+        std::vector<RF::rfc_value_tuple_s> tp_all;
+        size_t                             total = 0;
+
+        for( t = 0; t < (unsigned)workers.size(); t++ )
+        {
+            total += workers[t]->ctx_get().tp_cnt;
+        }
+
+        tp_all.reserve( total );
+        for( t = 0; t < (unsigned)workers.size(); t++ )
+        {
+            RainflowT *w = workers[t];
+
+            for( i = 0; i < w->ctx_get().tp_cnt; i++ )
+            {
+#ifdef RFC_TP_STORAGE
+                tp_all.push_back( w->tp_storage()[i] );
+#else /*!RFC_TP_STORAGE*/
+                tp_all.push_back( w->ctx_get().tp[i] );
+#endif /*RFC_TP_STORAGE*/
+            }
+        }
+
+        for( i = 0; ok && i < m_ctx.tp_cnt; i++ )
+        {
+#ifdef RFC_TP_STORAGE
+            const RF::rfc_value_tuple_s *pt = &m_tp[i];
+#else /*!RFC_TP_STORAGE*/
+            const RF::rfc_value_tuple_s *pt = &m_ctx.tp[i];
+#endif /*RFC_TP_STORAGE*/
+
+            if( pt->damage > 0.0 )
+            {
+                size_t n = tp_refeed_parallel_find( tp_all, pt->pos );
+
+                if( n < tp_all.size() )
+                {
+                    tp_all[n].damage += pt->damage;
+                }
+            }
+        }
+
+#ifdef RFC_TP_STORAGE
+        m_tp.resize( 0 );
+        for( i = 0; i < tp_all.size(); i++ )
+        {
+            m_tp.push_back( tp_all[i] );
+        }
+        m_ctx.tp_cnt = tp_all.size();
+        m_ctx.tp_cap = m_tp.capacity();
+#else /*!RFC_TP_STORAGE*/
+        if( m_ctx.tp_cap < total )
+        {
+            RF::rfc_value_tuple_s *tp_new = (RF::rfc_value_tuple_s*)m_ctx.mem_alloc( m_ctx.tp, total,
+                                                sizeof( RF::rfc_value_tuple_s ), RF::RFC_MEM_AIM_TP );
+
+            if( tp_new )
+            {
+                m_ctx.tp     = tp_new;
+                m_ctx.tp_cap = total;
+            }
+            else
+            {
+                ok = false;
+            }
+        }
+
+        if( ok )
+        {
+            std::copy( tp_all.begin(), tp_all.end(), m_ctx.tp );
+            m_ctx.tp_cnt = total;
+        }
+#endif /*RFC_TP_STORAGE*/
+
+        if( ok )
+        {
+            /* Re-link the residue to the rebuilt storage */
+            for( i = 0; i < m_ctx.residue_cnt; i++ )
+            {
+                size_t n = tp_refeed_parallel_find( tp_all, m_ctx.residue[i].pos );
+
+                m_ctx.residue[i].tp_pos = ( n < tp_all.size() ) ? ( n + 1 ) : 0;
+            }
+
+            m_ctx.internal.extrema[0]      = extrema[0];
+            m_ctx.internal.extrema[1]      = extrema[1];
+            m_ctx.internal.extrema_changed = true;
+        }
+    }
+
+    if( !ok )
+    {
+        /* Recovery: feed the collected history single threaded into the
+           reconfigured context, equivalent to tp_refeed() */
+        ok = clear_counts() && tp_clear();
+
+        m_tp.resize( m_ctx.tp_cnt );
+
+        if( ok )
+        {
+            ok = feed_tuple( &history[0], history_cnt );
+        }
+    }
+
+    if( ok )
+    {
+        m_ctx.internal.pos        = pos;
+        m_ctx.internal.pos_offset = pos_offset;
+    }
+
+    for( t = 0; t < (unsigned)workers.size(); t++ )
+    {
+        delete workers[t];
+    }
+
+    return ok;
+}
+
+
 template< class T >
 bool RainflowT<T>::tp_clear()
 {
@@ -779,6 +1235,13 @@ bool RainflowT<T>::dh_init( rfc_sd_method_e method, double *dh, size_t dh_cap, b
 }
 
 
+template< class T >
+bool RainflowT<T>::dh_init_sparse( rfc_sd_method_e method, size_t cap )
+{
+    return RF::RFC_dh_init_sparse( &m_ctx, (RF::rfc_sd_method_e)method, cap );
+}
+
+
 template< class T >
 bool RainflowT<T>::dh_get( const double **dh, size_t *count ) const
 {
@@ -786,6 +1249,13 @@ bool RainflowT<T>::dh_get( const double **dh, size_t *count ) const
 }
 
 
+template< class T >
+bool RainflowT<T>::dh_window_damage( size_t pos_from, size_t pos_to, double *damage ) const
+{
+    return RF::RFC_dh_window_damage( &m_ctx, pos_from, pos_to, damage );
+}
+
+
 template< class T >
 bool RainflowT<T>::at_init( const double *Sa, const double *Sm, unsigned count,
                                   double M, double Sm_rig, double R_rig, bool R_pinned, bool symmetric )
@@ -794,6 +1264,14 @@ bool RainflowT<T>::at_init( const double *Sa, const double *Sm, unsigned count,
 }
 
 
+template< class T >
+bool RainflowT<T>::at_lut_init( double Sa_max, double Sm_min, double Sm_max,
+                                unsigned Sa_divisions, unsigned Sm_divisions )
+{
+    return RF::RFC_at_lut_init( &m_ctx, Sa_max, Sm_min, Sm_max, Sa_divisions, Sm_divisions );
+}
+
+
 template< class T >
 bool RainflowT<T>::at_transform( double Sa, double Sm, double *Sa_transformed ) const
 {
@@ -801,6 +1279,13 @@ bool RainflowT<T>::at_transform( double Sa, double Sm, double *Sa_transformed )
 }
 
 
+template< class T >
+bool RainflowT<T>::at_transform_batch( const double *Sa, const double *Sm, double *Sa_transformed, size_t count ) const
+{
+    return RF::RFC_at_transform_batch( &m_ctx, Sa, Sm, Sa_transformed, count );
+}
+
+
 template< class T >
 bool RainflowT<T>::flags_set( int flags, bool debugging, bool overwrite )
 {
@@ -1212,4 +1697,863 @@ extern "C"
 }
 #endif /*RFC_TP_STORAGE*/
 
-#pragma pack(pop)
+
+/* Compile time policies for RainflowStaticT, see there. Alternative traits
+   classes provide the same enumerators */
+struct rfc_static_default_traits
+{
+    enum
+    {
+        record_tp    = 0,   /* Keep the turning point history */
+        count_rfm    = 1,   /* Count into the rainflow matrix */
+        count_damage = 1    /* Accumulate pseudo damage (Woehler, see wl_init_elementary()) */
+    };
+};
+
+
+/* Compile time specialized counting core (4 point method, CRTP).
+
+   Counterpart to the delegate driven generic path: cycle finding, turning point
+   recording and damage calculation are resolved at compile time, so the hot loop
+   inlines completely. Counting matches the RFC_MINIMAL configuration of the C
+   core: rainflow matrix and pseudo damage (elementary Woehler curve, evaluated
+   through a per class look up table), residue pending until finalize().
+   A derived class may hook closed cycles and confirmed turning points:
+
+       struct MyCounter : RainflowStaticT<MyCounter>
+       {
+           void on_cycle( const rfc_value_tuple_s &from, const rfc_value_tuple_s &to );
+           void on_turning_point( const rfc_value_tuple_s &tp );
+       };
+
+   Both hooks default to no-ops and cost nothing when unused. on_cycle() fires
+   for every closed cycle, histogram and damage counting skip cycles spanning
+   less than one class, as the C core does. */
+template< class Derived, class Traits = rfc_static_default_traits >
+class RainflowStaticT
+{
+public:
+    typedef     RF::rfc_value_t                     rfc_value_t;                                /** Input data value type */
+    typedef     RF::rfc_counts_t                    rfc_counts_t;                               /** Type of counting values */
+    typedef     RF::rfc_value_tuple_s               rfc_value_tuple_s;                          /** Tuple of value and index position */
+
+    RainflowStaticT()
+        : m_class_count( 0 )
+        , m_class_width( 0 )
+        , m_class_offset( 0 )
+        , m_hysteresis( 0 )
+        , m_residue_cnt( 0 )
+        , m_damage( 0.0 )
+        , m_pos( 0 )
+        , m_slope( 0 )
+        , m_state( S_INIT0 )
+    {}
+
+    bool init( unsigned class_count, rfc_value_t class_width, rfc_value_t class_offset, rfc_value_t hysteresis )
+    {
+        if( !class_count || class_width <= 0.0 || hysteresis < 0.0 )
+        {
+            return false;
+        }
+
+        m_class_count  = class_count;
+        m_class_width  = class_width;
+        m_class_offset = class_offset;
+        m_hysteresis   = hysteresis;
+        m_residue.resize( 2 * (size_t)class_count + 1 );
+        m_residue_cnt  = 0;
+        m_damage       = 0.0;
+        m_pos          = 0;
+        m_slope        = 0;
+        m_state        = S_INIT;
+        m_tp.clear();
+
+        if( (int)Traits::count_rfm )
+        {
+            m_rfm.assign( (size_t)class_count * class_count, 0 );
+        }
+
+        return wl_init_elementary( (double)RF::RFC_WL_SD_DEFAULT, (double)RF::RFC_WL_ND_DEFAULT, (double)RF::RFC_WL_K_DEFAULT );
+    }
+
+    bool wl_init_elementary( double sx, double nx, double k )
+    {
+        if( !m_class_count || sx <= 0.0 || nx <= 0.0 )
+        {
+            return false;
+        }
+
+        if( (int)Traits::count_damage )
+        {
+            /* One entry per cycle range in classes, see damage_calc_amplitude() */
+            const double SX_log = log( sx );
+            const double NX_log = log( nx );
+            size_t       range;
+
+            m_damage_lut.assign( m_class_count, 0.0 );
+
+            for( range = 1; range < m_class_count; range++ )
+            {
+                double Sa = (double)range / 2.0 * m_class_width;
+
+                m_damage_lut[range] = exp( fabs( k ) * ( log( Sa ) - SX_log ) - NX_log );
+            }
+        }
+
+        return true;
+    }
+
+    /* Hot loop: hysteresis filter and cycle counting, statically dispatched */
+    bool feed( const rfc_value_t *data, size_t count )
+    {
+        if( m_state < S_INIT || m_state >= S_FINISHED )
+        {
+            return false;
+        }
+
+        while( count-- )
+        {
+            rfc_value_tuple_s pt = { 0 };
+
+            pt.value = *data++;
+            pt.pos   = ++m_pos;
+
+            if( pt.value < m_class_offset )
+            {
+                return false;
+            }
+
+            pt.cls = (unsigned)( ( pt.value - m_class_offset ) / m_class_width );
+
+            if( pt.cls >= m_class_count )
+            {
+                return false;
+            }
+
+            {
+                const rfc_value_tuple_s *tp_new = filter_pt( pt );
+
+                if( tp_new )
+                {
+                    if( (int)Traits::record_tp )
+                    {
+                        m_tp.push_back( *tp_new );
+                    }
+                    derived().on_turning_point( *tp_new );
+
+                    find_cycles_4ptm();
+                }
+            }
+        }
+
+        return true;
+    }
+
+    /* Confirm a pending interim turning point and close counting, the residue
+       remains as is (residual method "none") */
+    bool finalize()
+    {
+        if( m_state < S_INIT || m_state >= S_FINISHED )
+        {
+            return false;
+        }
+
+        if( m_state == S_BUSY_INTERIM )
+        {
+            const rfc_value_tuple_s tp_interim = m_residue[m_residue_cnt++];
+
+            m_state = S_BUSY;
+
+            if( (int)Traits::record_tp )
+            {
+                m_tp.push_back( tp_interim );
+            }
+            derived().on_turning_point( tp_interim );
+
+            /* Check once more if a new cycle is closed now */
+            find_cycles_4ptm();
+        }
+
+        m_state = S_FINISHED;
+
+        return true;
+    }
+
+    /* CRTP hooks, shadowed by Derived */
+    inline void on_cycle         ( const rfc_value_tuple_s &, const rfc_value_tuple_s & ) {}
+    inline void on_turning_point ( const rfc_value_tuple_s & )                            {}
+
+    /* Readouts */
+    double                                damage      ()                           const { return m_damage; }
+    const std::vector<rfc_counts_t>&      rfm_storage ()                           const { return m_rfm; }
+    rfc_counts_t                          rfm_at      ( unsigned from, unsigned to ) const
+    {
+        return ( from < m_class_count && to < m_class_count ) ? m_rfm[ (size_t)m_class_count * from + to ] : 0;
+    }
+    const rfc_value_tuple_s*              residue     ()                           const { return &m_residue[0]; }
+    size_t                                residue_cnt ()                           const { return m_residue_cnt + ( ( m_state == S_BUSY_INTERIM ) ? 1 : 0 ); }
+    const std::vector<rfc_value_tuple_s>& tp          ()                           const { return m_tp; }
+    size_t                                pos         ()                           const { return m_pos; }
+    unsigned                              class_count ()                           const { return m_class_count; }
+
+protected:
+    enum state_e { S_INIT0 = 0, S_INIT, S_BUSY, S_BUSY_INTERIM, S_FINISHED };
+
+    inline Derived& derived() { return *static_cast<Derived*>( this ); }
+
+    /* Peak-valley filtering, see feed_filter_pt(); returns the confirmed
+       turning point (last in residue) or NULL */
+    inline const rfc_value_tuple_s * filter_pt( const rfc_value_tuple_s &pt )
+    {
+        if( m_state < S_BUSY_INTERIM )
+        {
+            int is_falling_slope = -1;
+
+            if( m_state == S_INIT )
+            {
+                /* Very first point, initialize local min-max search */
+                m_extrema[0] = m_extrema[1] = pt;
+                m_state      = S_BUSY;
+
+                return NULL;
+            }
+
+            /* Still searching for first turning point(s), update local extrema */
+            if( pt.value < m_extrema[0].value )
+            {
+                is_falling_slope = 1;
+                m_extrema[0]     = pt;
+            }
+            else if( pt.value > m_extrema[1].value )
+            {
+                is_falling_slope = 0;
+                m_extrema[1]     = pt;
+            }
+
+            if( is_falling_slope >= 0 && value_delta( m_extrema[0], m_extrema[1], NULL ) > m_hysteresis )
+            {
+                /* Criteria met, emit maximum on falling slope as first turning
+                   point, pt becomes the interim turning point */
+                m_residue[0]   = m_extrema[is_falling_slope];
+                m_slope        = is_falling_slope ? -1 : 1;
+                m_state        = S_BUSY_INTERIM;
+
+                m_residue[++m_residue_cnt] = pt;
+
+                return &m_residue[m_residue_cnt - 1];
+            }
+        }
+        else
+        {
+            /* Consecutive search, check against interim turning point */
+            int         slope;
+            rfc_value_t delta = value_delta( m_residue[m_residue_cnt], pt, &slope );
+
+            if( slope == m_slope )
+            {
+                /* Continuous slope, replace interim turning point */
+                if( m_residue[m_residue_cnt].value != pt.value )
+                {
+                    m_residue[m_residue_cnt] = pt;
+                }
+            }
+            else if( delta > m_hysteresis )
+            {
+                /* Slope reversal beyond hysteresis, interim turning point
+                   becomes real, pt is the new interim turning point */
+                m_slope = slope;
+
+                m_residue[++m_residue_cnt] = pt;
+
+                return &m_residue[m_residue_cnt - 1];
+            }
+        }
+
+        return NULL;
+    }
+
+    inline rfc_value_t value_delta( const rfc_value_tuple_s &pt_from, const rfc_value_tuple_s &pt_to, int *sign_ptr ) const
+    {
+#if RFC_USE_HYSTERESIS_FILTER
+        double delta = (double)pt_to.value - (double)pt_from.value;
+#else /*!RFC_USE_HYSTERESIS_FILTER*/
+        double delta = m_class_width * ( (int)pt_to.cls - (int)pt_from.cls );
+#endif /*RFC_USE_HYSTERESIS_FILTER*/
+
+        if( sign_ptr )
+        {
+            *sign_ptr = ( delta < 0.0 ) ? -1 : 1;
+        }
+
+        return (rfc_value_t)fabs( delta );
+    }
+
+    /* Counting core, see cycle_find_4ptm() */
+    inline void find_cycles_4ptm()
+    {
+        while( m_residue_cnt >= 4 )
+        {
+            size_t idx = m_residue_cnt - 4;
+
+            unsigned A = m_residue[idx+0].cls;
+            unsigned B = m_residue[idx+1].cls;
+            unsigned C = m_residue[idx+2].cls;
+            unsigned D = m_residue[idx+3].cls;
+
+            if( B > C ) { unsigned temp = B; B = C; C = temp; }
+            if( A > D ) { unsigned temp = A; A = D; D = temp; }
+
+            /* Check for closed cycles */
+            if( A <= B && C <= D )
+            {
+                const rfc_value_tuple_s &from = m_residue[idx+1];
+                const rfc_value_tuple_s &to   = m_residue[idx+2];
+
+                derived().on_cycle( from, to );
+
+                if( from.cls != to.cls )
+                {
+                    if( (int)Traits::count_damage )
+                    {
+                        m_damage += m_damage_lut[ ( from.cls > to.cls ) ? ( from.cls - to.cls ) : ( to.cls - from.cls ) ];
+                    }
+
+                    if( (int)Traits::count_rfm )
+                    {
+                        m_rfm[ (size_t)m_class_count * from.cls + to.cls ] += (rfc_counts_t)RFC_FULL_CYCLE_INCREMENT;
+                    }
+                }
+
+                /* Remove the two inner turning points */
+                m_residue[idx+1] = m_residue[idx+3];
+                if( m_state == S_BUSY_INTERIM )
+                {
+                    /* Move interim turning point */
+                    m_residue[idx+2] = m_residue[idx+4];
+                }
+                m_residue_cnt -= 2;
+            }
+            else break;
+        }
+    }
+
+    unsigned                        m_class_count;
+    rfc_value_t                     m_class_width;
+    rfc_value_t                     m_class_offset;
+    rfc_value_t                     m_hysteresis;
+    std::vector<rfc_value_tuple_s>  m_residue;      /* Confirmed turning points, interim at [m_residue_cnt] */
+    size_t                          m_residue_cnt;
+    std::vector<rfc_counts_t>       m_rfm;
+    std::vector<double>             m_damage_lut;
+    std::vector<rfc_value_tuple_s>  m_tp;
+    rfc_value_tuple_s               m_extrema[2];   /* Local min-max search */
+    double                          m_damage;
+    size_t                          m_pos;
+    int                             m_slope;
+    state_e                         m_state;
+};
+
+
+/* Plain compile time specialized counter without hooks */
+class RainflowStatic : public RainflowStaticT<RainflowStatic> {};
+
+#pragma pack(pop)
+
+
+/* Batch engine for many independent channels (one context per channel).
+
+   Channels live in one contiguous array, split into contiguous blocks which are
+   pinned to the workers of a built-in thread pool: a channel is only ever
+   touched by its one worker, so the hot context fields of neighboring channels
+   stay in that core's cache instead of bouncing between cores. feed_batch()
+   accepts interleaved (frame major) or planar (channel major) buffers; planar
+   blocks are fed in place, interleaved frames are gathered into a worker local
+   scratch buffer first.
+
+       RainflowBank bank( channel_count );
+
+       bank.init( class_count, class_width, class_offset, hysteresis );
+       while( have_data )
+       {
+           bank.feed_batch( frames, frame_count, RainflowBank::RFC_BATCH_INTERLEAVED );
+       }
+       bank.finalize( Rainflow::RFC_RES_REPEATED );
+       bank.channel( i ).damage( &damage_i );
+
+   Results per channel match feeding that channel's samples into a standalone
+   context. Failed channels poison their own context only (see error_get()),
+   feed_batch() and finalize() return false if any channel failed. */
+template< class T = std::vector<RF::rfc_value_tuple_s> >
+class RainflowBankT
+{
+public:
+    typedef     RainflowT<T>                            rainflow_type;
+    typedef     typename rainflow_type::rfc_value_t     rfc_value_t;
+    typedef     typename rainflow_type::rfc_flags_e     rfc_flags_e;
+    typedef     typename rainflow_type::rfc_res_method_e rfc_res_method_e;
+
+    /* Memory layout of a multichannel batch */
+    enum rfc_batch_layout_e
+    {
+        RFC_BATCH_INTERLEAVED = 0,                      /**< Frame major: data[ frame * channel_count + channel ] */
+        RFC_BATCH_PLANAR      = 1                       /**< Channel major: data[ channel * frame_count + frame ] */
+    };
+
+    explicit RainflowBankT( unsigned channel_count, unsigned num_threads = 0 )
+        : m_channels( NULL )
+        , m_channel_cnt( channel_count )
+        , m_generation( 0 )
+        , m_busy( 0 )
+        , m_shutdown( false )
+    {
+        unsigned t;
+
+        m_channels = channel_count ? new rainflow_type[channel_count] : NULL;
+
+        if( !num_threads )
+        {
+            num_threads = std::thread::hardware_concurrency();
+        }
+
+        if( num_threads > channel_count )
+        {
+            num_threads = channel_count;
+        }
+
+        if( num_threads < 2 )
+        {
+            /* No pool, feed_batch() processes all channels inline */
+            return;
+        }
+
+        /* Pin contiguous channel blocks to the workers */
+        m_first.resize( num_threads );
+        m_cnt.resize( num_threads );
+        m_ok.resize( num_threads, 1 );
+
+        for( t = 0; t < num_threads; t++ )
+        {
+            size_t first = (size_t)m_channel_cnt *   t       / num_threads;
+            size_t next  = (size_t)m_channel_cnt * ( t + 1 ) / num_threads;
+
+            m_first[t] = (unsigned)first;
+            m_cnt[t]   = (unsigned)( next - first );
+        }
+
+        for( t = 0; t < num_threads; t++ )
+        {
+            m_threads.push_back( std::thread( &RainflowBankT::worker_fcn, this, t ) );
+        }
+    }
+
+    ~RainflowBankT()
+    {
+        if( !m_threads.empty() )
+        {
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                m_shutdown = true;
+            }
+            m_cv_work.notify_all();
+
+            for( size_t t = 0; t < m_threads.size(); t++ )
+            {
+                m_threads[t].join();
+            }
+        }
+
+        delete[] m_channels;
+    }
+
+    /* Initialize all channels with shared class parameters */
+    bool init( unsigned class_count, rfc_value_t class_width, rfc_value_t class_offset,
+               rfc_value_t hysteresis, rfc_flags_e flags = rainflow_type::RFC_FLAGS_DEFAULT )
+    {
+        bool ok = m_channel_cnt > 0;
+
+        for( unsigned i = 0; i < m_channel_cnt; i++ )
+        {
+            ok = m_channels[i].init( class_count, class_width, class_offset, hysteresis, flags ) && ok;
+        }
+
+        return ok;
+    }
+
+    /* Feed frame_count samples per channel, scheduled across the worker pool */
+    bool feed_batch( const rfc_value_t *data, size_t frame_count, rfc_batch_layout_e layout = RFC_BATCH_INTERLEAVED )
+    {
+        if( !m_channel_cnt || ( !data && frame_count ) )
+        {
+            return false;
+        }
+
+        if( !frame_count )
+        {
+            return true;
+        }
+
+        if( m_threads.empty() )
+        {
+            return feed_channel_range( 0, m_channel_cnt, data, frame_count, layout, m_scratch );
+        }
+
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            m_job.data        = data;
+            m_job.frame_count = frame_count;
+            m_job.layout      = layout;
+            m_busy            = (unsigned)m_threads.size();
+            m_generation++;
+        }
+        m_cv_work.notify_all();
+
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+
+            m_cv_done.wait( lock, [this]{ return m_busy == 0; } );
+        }
+
+        for( size_t t = 0; t < m_threads.size(); t++ )
+        {
+            if( !m_ok[t] ) return false;
+        }
+
+        return true;
+    }
+
+    /* Finalize all channels, see RFC_finalize() */
+    bool finalize( rfc_res_method_e residual_method = rainflow_type::RFC_RES_IGNORE )
+    {
+        bool ok = m_channel_cnt > 0;
+
+        for( unsigned i = 0; i < m_channel_cnt; i++ )
+        {
+            ok = m_channels[i].finalize( residual_method ) && ok;
+        }
+
+        return ok;
+    }
+
+    unsigned channel_count() const { return m_channel_cnt; }
+
+    rainflow_type&       channel( unsigned i )       { return m_channels[i]; }
+    const rainflow_type& channel( unsigned i ) const { return m_channels[i]; }
+
+private:
+    /* Non-copyable, owns contexts and threads */
+    RainflowBankT( const RainflowBankT& );
+    RainflowBankT& operator=( const RainflowBankT& );
+
+    struct job_s
+    {
+        const rfc_value_t              *data;
+        size_t                          frame_count;
+        rfc_batch_layout_e              layout;
+    };
+
+    bool feed_channel_range( unsigned first, unsigned cnt, const rfc_value_t *data, size_t frame_count,
+                             rfc_batch_layout_e layout, std::vector<rfc_value_t> &scratch )
+    {
+        bool ok = true;
+
+        for( unsigned i = first; i < first + cnt; i++ )
+        {
+            if( layout == RFC_BATCH_PLANAR )
+            {
+                /* Planar channels are contiguous already */
+                ok = m_channels[i].feed( data + (size_t)i * frame_count, frame_count ) && ok;
+            }
+            else
+            {
+                /* Gather the channel from the interleaved frames */
+                scratch.resize( frame_count );
+                for( size_t f = 0; f < frame_count; f++ )
+                {
+                    scratch[f] = data[ f * m_channel_cnt + i ];
+                }
+                ok = m_channels[i].feed( &scratch[0], frame_count ) && ok;
+            }
+        }
+
+        return ok;
+    }
+
+    void worker_fcn( unsigned worker )
+    {
+        std::vector<rfc_value_t> scratch;
+        size_t                   seen = 0;
+
+        for(;;)
+        {
+            job_s job;
+
+            {
+                std::unique_lock<std::mutex> lock( m_mutex );
+
+                m_cv_work.wait( lock, [this, &seen]{ return m_shutdown || m_generation != seen; } );
+
+                if( m_shutdown ) return;
+
+                seen = m_generation;
+                job  = m_job;
+            }
+
+            int ok = feed_channel_range( m_first[worker], m_cnt[worker],
+                                         job.data, job.frame_count, job.layout, scratch ) ? 1 : 0;
+
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+
+                m_ok[worker] = ok;
+                if( --m_busy == 0 )
+                {
+                    m_cv_done.notify_one();
+                }
+            }
+        }
+    }
+
+    rainflow_type                      *m_channels;     /* All channels, worker blocks are contiguous */
+    unsigned                            m_channel_cnt;
+    std::vector<std::thread>            m_threads;
+    std::vector<unsigned>               m_first;        /* First channel per worker */
+    std::vector<unsigned>               m_cnt;          /* Channel count per worker */
+    std::vector<int>                    m_ok;           /* Per worker result of the current batch */
+    std::vector<rfc_value_t>            m_scratch;      /* Gather buffer for the poolless path */
+    job_s                               m_job;
+    size_t                              m_generation;   /* Batch sequence number, workers wait for a change */
+    unsigned                            m_busy;         /* Workers still on the current batch */
+    bool                                m_shutdown;
+    std::mutex                          m_mutex;
+    std::condition_variable             m_cv_work;
+    std::condition_variable             m_cv_done;
+};
+
+
+#ifdef RFC_TP_STORAGE
+typedef RainflowBankT<RFC_TP_STORAGE> RainflowBank;
+#else
+typedef RainflowBankT<> RainflowBank;
+#endif /*RFC_TP_STORAGE*/
+
+
+/* Asynchronous facade for one counter: counting overlaps decode/IO.
+
+   feed_async() copies the chunk into a bounded job queue and returns a
+   std::future<bool> carrying that chunk's result; a single worker thread
+   feeds the attached counter in submission order. A full queue blocks
+   feed_async(), back pressure keeps memory bounded. An optional chunk
+   callback runs on the worker thread after each processed job and may read
+   incremental results off the counter.
+
+       Rainflow      rf;
+       RainflowAsync async( rf );
+
+       rf.init( class_count, class_width, class_offset, hysteresis );
+       while( have_data )
+       {
+           async.feed_async( chunk, chunk_size );  // returns while counting
+           // ... decode the next chunk ...
+       }
+       async.finalize_async( Rainflow::RFC_RES_REPEATED ).get();
+       rf.damage( &damage );
+
+   Between the first feed_async() and wait() (or the last future) the counter
+   belongs to the worker; access it from the chunk callback only. */
+template< class T = std::vector<RF::rfc_value_tuple_s> >
+class RainflowAsyncT
+{
+public:
+    typedef     RainflowT<T>                            rainflow_type;
+    typedef     typename rainflow_type::rfc_value_t     rfc_value_t;
+    typedef     typename rainflow_type::rfc_res_method_e rfc_res_method_e;
+
+    explicit RainflowAsyncT( rainflow_type &rf, size_t queue_depth = 4 )
+        : m_rf( rf )
+        , m_jobs( queue_depth ? queue_depth : 1 )
+        , m_head( 0 )
+        , m_queued( 0 )
+        , m_shutdown( false )
+    {
+        m_thread = std::thread( &RainflowAsyncT::worker_fcn, this );
+    }
+
+    ~RainflowAsyncT()
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            m_shutdown = true;
+        }
+        m_cv_work.notify_all();
+        m_thread.join();  /* Pending jobs are still processed */
+    }
+
+    /* Set a callback run on the worker thread after each processed job */
+    void on_chunk( std::function<void( rainflow_type&, bool )> fcn )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_on_chunk = fcn;
+    }
+
+    /* Enqueue a copy of the chunk, blocks while the queue is full */
+    std::future<bool> feed_async( const rfc_value_t *data, size_t count )
+    {
+        return submit( JOB_FEED, data, count, (rfc_res_method_e)rainflow_type::RFC_RES_NONE );
+    }
+
+    std::future<bool> feed_async( const std::vector<rfc_value_t> &data )
+    {
+        return submit( JOB_FEED, data.empty() ? NULL : &data[0], data.size(), (rfc_res_method_e)rainflow_type::RFC_RES_NONE );
+    }
+
+    /* Enqueue the finalization behind all pending chunks */
+    std::future<bool> finalize_async( rfc_res_method_e res_method )
+    {
+        return submit( JOB_FINALIZE, NULL, 0, res_method );
+    }
+
+    /* Block until all submitted jobs are processed */
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        while( m_queued )
+        {
+            m_cv_done.wait( lock );
+        }
+    }
+
+private:
+    enum job_kind_e { JOB_FEED = 0, JOB_FINALIZE = 1 };
+
+    struct job_s
+    {
+        int                                 kind;
+        std::vector<rfc_value_t>            data;
+        rfc_res_method_e                    res_method;
+        std::promise<bool>                  promise;
+    };
+
+    std::future<bool> submit( int kind, const rfc_value_t *data, size_t count, rfc_res_method_e res_method )
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        while( m_queued == m_jobs.size() )
+        {
+            m_cv_done.wait( lock );
+        }
+
+        /* The slot is untouched by the worker until m_queued includes it */
+        job_s &job = m_jobs[ ( m_head + m_queued ) % m_jobs.size() ];
+
+        job.kind       = kind;
+        job.res_method = res_method;
+        job.promise    = std::promise<bool>();
+        if( count )
+        {
+            job.data.assign( data, data + count );
+        }
+        else
+        {
+            job.data.clear();
+        }
+
+        std::future<bool> future = job.promise.get_future();
+
+        m_queued++;
+        lock.unlock();
+        m_cv_work.notify_one();
+
+        return future;
+    }
+
+    void worker_fcn()
+    {
+        for(;;)
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+
+            while( !m_queued && !m_shutdown )
+            {
+                m_cv_work.wait( lock );
+            }
+
+            if( !m_queued )
+            {
+                return;
+            }
+
+            /* The head slot belongs to the worker, process it unlocked */
+            job_s &job = m_jobs[ m_head ];
+            std::function<void( rainflow_type&, bool )> fcn = m_on_chunk;
+            lock.unlock();
+
+            bool ok;
+
+            if( job.kind == JOB_FEED )
+            {
+                ok = job.data.empty() ? true : m_rf.feed( &job.data[0], job.data.size() );
+            }
+            else
+            {
+                ok = m_rf.finalize( job.res_method );
+            }
+
+            if( fcn )
+            {
+                fcn( m_rf, ok );
+            }
+
+            job.data.clear();
+            job.promise.set_value( ok );
+
+            lock.lock();
+            m_head = ( m_head + 1 ) % m_jobs.size();
+            m_queued--;
+            lock.unlock();
+            m_cv_done.notify_all();
+        }
+    }
+
+    /* Not copyable */
+    RainflowAsyncT( const RainflowAsyncT& );
+    RainflowAsyncT& operator=( const RainflowAsyncT& );
+
+    rainflow_type                      &m_rf;
+    std::vector<job_s>                  m_jobs;      /* Bounded job ring */
+    size_t                              m_head;      /* Next job to process */
+    size_t                              m_queued;    /* Filled slots */
+    bool                                m_shutdown;
+    std::function<void( rainflow_type&, bool )> m_on_chunk;
+    std::thread                         m_thread;
+    std::mutex                          m_mutex;
+    std::condition_variable             m_cv_work;
+    std::condition_variable             m_cv_done;
+};
+
+
+#ifdef RFC_TP_STORAGE
+typedef RainflowAsyncT<RFC_TP_STORAGE> RainflowAsync;
+#else
+typedef RainflowAsyncT<> RainflowAsync;
+#endif /*RFC_TP_STORAGE*/
+
+}  /* namespace RFC_CPP_NAMESPACE */
+
+
+/* The first inclusion exports the conventional unqualified names, further
+ * value type sets stay behind their RFC_CPP_NAMESPACE */
+#ifndef RAINFLOW_HPP_GLOBAL_NAMES
+#define RAINFLOW_HPP_GLOBAL_NAMES
+using RFC_CPP_NAMESPACE::RainflowT;
+using RFC_CPP_NAMESPACE::Rainflow;
+using RFC_CPP_NAMESPACE::RainflowStaticT;
+using RFC_CPP_NAMESPACE::RainflowStatic;
+using RFC_CPP_NAMESPACE::RainflowBankT;
+using RFC_CPP_NAMESPACE::RainflowBank;
+using RFC_CPP_NAMESPACE::RainflowAsyncT;
+using RFC_CPP_NAMESPACE::RainflowAsync;
+#endif /*RAINFLOW_HPP_GLOBAL_NAMES*/
+
+#endif /*RAINFLOW_HPP*/
@@ -0,0 +1,235 @@
+/*
+ *
+ *   |                     .-.
+ *   |                    /   \
+ *   |     .-.===========/     \         .-.
+ *   |    /   \         /       \       /   \
+ *   |   /     \       /         \     /     \         .-.
+ *   +--/-------\-----/-----------\---/-------\-------/---\
+ *   | /         \   /             '-'=========\     /     \   /
+ *   |/           '-'                           \   /       '-'
+ *   |                                           '-'
+ *          ____  ___    _____   __________    ____ _       __
+ *         / __ \/   |  /  _/ | / / ____/ /   / __ \ |     / /
+ *        / /_/ / /| |  / //  |/ / /_  / /   / / / / | /| / /
+ *       / _, _/ ___ |_/ // /|  / __/ / /___/ /_/ /| |/ |/ /
+ *      /_/ |_/_/  |_/___/_/ |_/_/   /_____/\____/ |__/|__/
+ *
+ *    Rainflow Counting Algorithm (4-point-method), C99 compliant
+ *
+ *    Memory mapped turning point storage (POSIX)
+ *
+ *
+ * MmapStorageT is a file backed, vector-like container intended as turning
+ * point storage for the C++ wrapper (RainflowT). Elements live in a memory
+ * mapped file instead of the heap, so the turning point history of long
+ * monitoring campaigns may exceed physical memory: the kernel pages cold
+ * regions out to the backing file on demand. Reads hand out references into
+ * the mapping, no copies are involved when the rainflow core walks the
+ * history (tp_refeed, tp_prune).
+ *
+ * The container satisfies the storage interface required by RainflowT
+ * (operator[], size(), capacity(), push_back(), resize()) with std::vector
+ * semantics: references stay valid until the next capacity growth.
+ *
+ * Usage (compare test/rfc_wrapper_advanced.cpp):
+ *
+ *     #include "rainflow_mmap.hpp"
+ *     namespace RFC_CPP_NAMESPACE
+ *     {
+ *         typedef struct rfc_value_tuple rfc_value_tuple_s;
+ *     }
+ *     #define RFC_TP_STORAGE MmapStorageT<RFC_CPP_NAMESPACE::rfc_value_tuple_s>
+ *     #include "rainflow.hpp"
+ *
+ * Default constructed storage maps an unlinked temporary file, which the
+ * system reclaims when the storage is destroyed. Constructed with a filename
+ * the backing file persists and retains the turning point history on disk.
+ *
+ *================================================================================
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2023, Andras Martin
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *================================================================================
+ */
+
+#pragma once
+
+#if defined(_WIN32)
+#error "rainflow_mmap.hpp requires POSIX memory mapping (mmap)"
+#endif /*_WIN32*/
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+template< class T >
+class MmapStorageT
+{
+public:
+
+    typedef T       value_type;
+    typedef size_t  size_type;
+
+    /* ctor */      MmapStorageT            ()                          // Anonymous temporary backing file
+    : m_fd( -1 ), m_elements( NULL ), m_size( 0 ), m_cap( 0 ), m_persistent( false )
+    {
+        char path[] = "/tmp/rfc_tp_XXXXXX";
+
+        m_fd = mkstemp( path );
+
+        if( m_fd < 0 )
+        {
+            throw std::bad_alloc();
+        }
+
+        (void)unlink( path );  // Reclaimed on close
+    }
+
+    /* ctor */      MmapStorageT            ( const char *filename )    // Persistent backing file
+    : m_fd( -1 ), m_elements( NULL ), m_size( 0 ), m_cap( 0 ), m_persistent( true )
+    {
+        m_fd = open( filename, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+
+        if( m_fd < 0 )
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    /* dtor */     ~MmapStorageT            ()
+    {
+        if( m_elements )
+        {
+            if( m_persistent )
+            {
+                (void)msync( m_elements, m_cap * sizeof(T), MS_SYNC );
+            }
+            (void)munmap( m_elements, m_cap * sizeof(T) );
+        }
+
+        if( m_fd >= 0 )
+        {
+            if( m_persistent )
+            {
+                /* Trim spare capacity, so the file carries m_size elements */
+                (void)ftruncate( m_fd, (off_t)( m_size * sizeof(T) ) );
+            }
+            (void)close( m_fd );
+        }
+    }
+
+    /* Element access (zero-copy, references point into the mapping) */
+    inline
+    T&              operator[]              ( size_t i )       { assert( i < m_cap ); return m_elements[i]; }
+    inline const
+    T&              operator[]              ( size_t i ) const { assert( i < m_cap ); return m_elements[i]; }
+
+    inline
+    size_t          size                    () const { return m_size; }
+    inline
+    size_t          capacity                () const { return m_cap; }
+
+    void            push_back               ( const T& element )
+    {
+        if( m_size == m_cap )
+        {
+            reserve( m_cap ? m_cap * 2 : 1 );
+        }
+        m_elements[m_size++] = element;
+    }
+
+    void            resize                  ( size_t count )
+    {
+        if( count > m_cap )
+        {
+            reserve( count );
+        }
+
+        if( count > m_size )
+        {
+            /* Match std::vector, new elements are value initialized */
+            memset( m_elements + m_size, 0, ( count - m_size ) * sizeof(T) );
+        }
+
+        m_size = count;
+    }
+
+    void            reserve                 ( size_t count )
+    {
+        size_t page_size = (size_t)sysconf( _SC_PAGESIZE );
+        size_t bytes;
+
+        if( count <= m_cap ) return;
+
+        /* Grow in whole pages */
+        bytes = ( count * sizeof(T) + page_size - 1 ) / page_size * page_size;
+
+        if( ftruncate( m_fd, (off_t)bytes ) != 0 )
+        {
+            throw std::bad_alloc();
+        }
+
+        if( m_elements )
+        {
+            (void)munmap( m_elements, m_cap * sizeof(T) );
+        }
+
+        m_elements = (T*)mmap( NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0 );
+
+        if( m_elements == MAP_FAILED )
+        {
+            m_elements = NULL;
+            m_cap      = 0;
+            m_size     = 0;
+            throw std::bad_alloc();
+        }
+
+        m_cap = bytes / sizeof(T);
+    }
+
+    /* Flush dirty pages to the backing file */
+    bool            flush                   () const
+    {
+        return m_elements ? msync( m_elements, m_cap * sizeof(T), MS_SYNC ) == 0 : true;
+    }
+
+private:
+                    MmapStorageT            ( const MmapStorageT& );    // Inhibit copy ctor
+    MmapStorageT&   operator=               ( const MmapStorageT& );    // Inhibit copy assignment
+
+    int             m_fd;           /**< Backing file descriptor */
+    T              *m_elements;     /**< Memory mapped element storage */
+    size_t          m_size;         /**< Number of elements in use */
+    size_t          m_cap;          /**< Number of elements mapped */
+    bool            m_persistent;   /**< true, if backing file is kept on destruction */
+};
@@ -0,0 +1,381 @@
+/*
+ *
+ *   |                     .-.
+ *   |                    /   \
+ *   |     .-.===========/     \         .-.
+ *   |    /   \         /       \       /   \
+ *   |   /     \       /         \     /     \         .-.
+ *   +--/-------\-----/-----------\---/-------\-------/---\
+ *   | /         \   /             '-'=========\     /     \   /
+ *   |/           '-'                           \   /       '-'
+ *   |                                           '-'
+ *          ____  ___    _____   __________    ____ _       __
+ *         / __ \/   |  /  _/ | / / ____/ /   / __ \ |     / /
+ *        / /_/ / /| |  / //  |/ / /_  / /   / / / / | /| / /
+ *       / _, _/ ___ |_/ // /|  / __/ / /___/ /_/ /| |/ |/ /
+ *      /_/ |_/_/  |_/___/_/ |_/_/   /_____/\____/ |__/|__/
+ *
+ *    Rainflow Counting Algorithm (4-point-method), C99 compliant
+ *    Benchmark suite
+ *
+ *================================================================================
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2025, Andras Martin
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *================================================================================
+ */
+
+/*
+ * Micro benchmarks for the hot paths: RFC_feed across class counts and
+ * counting methods, turning point maintenance (tp_prune, tp_refeed) and
+ * the matrix readouts (RFC_lc_from_rfm, RFC_damage_from_rfm).
+ *
+ * Input signals are the recorded long series (test/long_series.csv,
+ * embedded via long_series.c) and two synthetic signals (uniform noise
+ * and an amplitude modulated sine).
+ *
+ * Feature flags (RFC_MINIMAL, RFC_TP_SUPPORT, RFC_DAMAGE_FAST,
+ * RFC_HCM_SUPPORT, ...) are compile time options; benchmark a flag
+ * combination by configuring the build accordingly, e.g.
+ *     cmake -DRFC_MINIMAL=ON .. && make rfc_benchmark
+ * Benchmarks whose prerequisites are compiled out are skipped silently.
+ *
+ * Each benchmark repeats its workload until a minimum wall time is
+ * reached and reports the best single run, so numbers are comparable
+ * between commits.
+ */
+
+#define RFC_VALUE_TYPE   double
+
+#include "../src/rainflow.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "long_series.c"
+
+#define NUMEL(x)            ( sizeof(x) / sizeof((x)[0]) )
+#define BENCH_MIN_TIME      0.25    /* Minimum accumulated wall time per benchmark (seconds) */
+#define BENCH_MIN_RUNS      3
+#define SYNTHETIC_LEN       100000
+#define FEED_REPS           10      /* Passes over the input signal per run */
+
+/* Class range covering the long series and both synthetic signals */
+#define CLASS_RANGE         5000.0
+#define CLASS_OFFSET        -2025.0
+
+static double  synthetic_noise[SYNTHETIC_LEN];
+static double  synthetic_sine[SYNTHETIC_LEN];
+
+
+static double wall_time( void )
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+
+static void bench_report( const char *name, unsigned class_count, double best, double units_per_run, const char *unit )
+{
+    printf( "%-32s %8u %12.3f ms %12.3f M%s/s\n",
+            name, class_count, best * 1e3, units_per_run / best / 1e6, unit );
+    fflush( stdout );
+}
+
+
+static void make_synthetic( void )
+{
+    unsigned long long lcg = 1;
+    size_t             i;
+
+    for( i = 0; i < SYNTHETIC_LEN; i++ )
+    {
+        lcg                 = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+        synthetic_noise[i]  = (double)( ( lcg >> 33 ) % 4000 ) - 1800.0;
+        /* Amplitude modulated sine, ~40 samples per cycle */
+        synthetic_sine[i]   = sin( (double)i * 0.157 ) * ( 900.0 + 800.0 * sin( (double)i * 0.00217 ) );
+    }
+}
+
+
+/* RFC_feed throughput for a given signal and class count */
+static void bench_feed( const char *name, const double *data, size_t data_len, unsigned class_count, int counting_method, bool with_tp )
+{
+    double best = -1.0, total = 0.0;
+    int    runs = 0;
+
+    (void)counting_method;
+    (void)with_tp;
+
+    while( total < BENCH_MIN_TIME || runs < BENCH_MIN_RUNS )
+    {
+        rfc_ctx_s ctx = { sizeof(ctx) };
+        double    t0, dt;
+        int       rep;
+
+        if( !RFC_init( &ctx, class_count, CLASS_RANGE / class_count, CLASS_OFFSET, CLASS_RANGE / class_count - 1, RFC_FLAGS_DEFAULT ) )
+        {
+            fprintf( stderr, "%s: RFC_init failed\n", name );
+            exit( EXIT_FAILURE );
+        }
+#if !RFC_MINIMAL
+        if( counting_method >= 0 )
+        {
+            ctx.counting_method = (rfc_counting_method_e)counting_method;
+        }
+#endif /*!RFC_MINIMAL*/
+#if RFC_TP_SUPPORT
+        if( with_tp )
+        {
+            if( !RFC_tp_init( &ctx, NULL, data_len * FEED_REPS + 1, /*is_static*/ false ) )
+            {
+                fprintf( stderr, "%s: RFC_tp_init failed\n", name );
+                exit( EXIT_FAILURE );
+            }
+        }
+#endif /*RFC_TP_SUPPORT*/
+
+        t0 = wall_time();
+        for( rep = 0; rep < FEED_REPS; rep++ )
+        {
+            if( !RFC_feed( &ctx, data, data_len ) )
+            {
+                fprintf( stderr, "%s: RFC_feed failed\n", name );
+                exit( EXIT_FAILURE );
+            }
+        }
+        dt = wall_time() - t0;
+
+        RFC_deinit( &ctx );
+
+        total += dt;
+        if( best < 0.0 || dt < best ) best = dt;
+        runs++;
+    }
+
+    bench_report( name, class_count, best, (double)data_len * FEED_REPS, "samples" );
+}
+
+
+#if RFC_TP_SUPPORT
+/* Turning point pruning; setup (feed) is excluded from timing */
+static void bench_tp_prune( void )
+{
+    double best = -1.0, total = 0.0;
+    int    runs = 0;
+
+    while( total < BENCH_MIN_TIME || runs < BENCH_MIN_RUNS )
+    {
+        rfc_ctx_s ctx = { sizeof(ctx) };
+        double    t0, dt;
+        int       rep;
+        size_t    tp_cnt;
+
+        RFC_init( &ctx, 100, CLASS_RANGE / 100, CLASS_OFFSET, CLASS_RANGE / 100 - 1, RFC_FLAGS_DEFAULT );
+        RFC_tp_init( &ctx, NULL, data_length * FEED_REPS + 1, /*is_static*/ false );
+
+        for( rep = 0; rep < FEED_REPS; rep++ )
+        {
+            RFC_feed( &ctx, data_export, data_length );
+        }
+        tp_cnt = ctx.tp_cnt;
+
+        t0 = wall_time();
+        if( !RFC_tp_prune( &ctx, tp_cnt / 10, RFC_FLAGS_TPPRUNE_PRESERVE_POS ) )
+        {
+            fprintf( stderr, "tp_prune: RFC_tp_prune failed\n" );
+            exit( EXIT_FAILURE );
+        }
+        dt = wall_time() - t0;
+
+        RFC_deinit( &ctx );
+
+        total += dt;
+        if( best < 0.0 || dt < best ) best = dt;
+        runs++;
+    }
+
+    bench_report( "tp_prune/long_series", 100, best, (double)data_length * FEED_REPS, "tp" );
+}
+
+
+/* Re-rainflow the stored turning points against a doubled class width
+   (the class count is fixed and the new hysteresis must not fall below
+   the recorded one) */
+static void bench_tp_refeed( void )
+{
+    double best = -1.0, total = 0.0;
+    int    runs = 0;
+
+    while( total < BENCH_MIN_TIME || runs < BENCH_MIN_RUNS )
+    {
+        rfc_ctx_s         ctx = { sizeof(ctx) };
+        rfc_class_param_s class_param;
+        double            t0, dt;
+        int               rep;
+        size_t            tp_cnt;
+
+        RFC_init( &ctx, 100, CLASS_RANGE / 100, CLASS_OFFSET, CLASS_RANGE / 100 - 1, RFC_FLAGS_DEFAULT );
+        RFC_tp_init( &ctx, NULL, data_length * FEED_REPS + 1, /*is_static*/ false );
+
+        for( rep = 0; rep < FEED_REPS; rep++ )
+        {
+            RFC_feed( &ctx, data_export, data_length );
+        }
+        tp_cnt = ctx.tp_cnt;
+
+        class_param.count  = 100;
+        class_param.width  = CLASS_RANGE / 100 * 2;
+        class_param.offset = CLASS_OFFSET - CLASS_RANGE / 2;
+
+        t0 = wall_time();
+        if( !RFC_tp_refeed( &ctx, class_param.width / 2, &class_param ) )
+        {
+            fprintf( stderr, "tp_refeed: RFC_tp_refeed failed\n" );
+            exit( EXIT_FAILURE );
+        }
+        dt = wall_time() - t0;
+
+        RFC_deinit( &ctx );
+
+        total += dt;
+        if( best < 0.0 || dt < best ) best = dt;
+        runs++;
+    }
+
+    bench_report( "tp_refeed/long_series", 100, best, (double)data_length * FEED_REPS, "tp" );
+}
+#endif /*RFC_TP_SUPPORT*/
+
+
+#if !RFC_MINIMAL
+/* Matrix readouts on a counted context; many inner repetitions per run */
+#define READOUT_REPS 200
+
+static void bench_rfm_readouts( unsigned class_count )
+{
+    rfc_ctx_s     ctx       = { sizeof(ctx) };
+    rfc_counts_t *lc;
+    rfc_value_t  *level;
+    double        best_lc     = -1.0, total_lc     = 0.0;
+    double        best_damage = -1.0, total_damage = 0.0;
+    double        damage;
+    int           runs, rep;
+
+    RFC_init( &ctx, class_count, CLASS_RANGE / class_count, CLASS_OFFSET, CLASS_RANGE / class_count - 1, RFC_FLAGS_DEFAULT );
+    RFC_feed( &ctx, data_export, data_length );
+    RFC_finalize( &ctx, RFC_RES_HALFCYCLES );
+
+    lc    = (rfc_counts_t*)calloc( class_count, sizeof(rfc_counts_t) );
+    level = (rfc_value_t*) calloc( class_count, sizeof(rfc_value_t) );
+    if( !lc || !level )
+    {
+        fprintf( stderr, "rfm_readouts: out of memory\n" );
+        exit( EXIT_FAILURE );
+    }
+
+    for( runs = 0; total_lc < BENCH_MIN_TIME || runs < BENCH_MIN_RUNS; runs++ )
+    {
+        double t0 = wall_time(), dt;
+
+        for( rep = 0; rep < READOUT_REPS; rep++ )
+        {
+            if( !RFC_lc_from_rfm( &ctx, lc, level, /*rfm*/ NULL, RFC_FLAGS_COUNT_LC ) )
+            {
+                fprintf( stderr, "lc_from_rfm failed\n" );
+                exit( EXIT_FAILURE );
+            }
+        }
+        dt        = wall_time() - t0;
+        total_lc += dt;
+        if( best_lc < 0.0 || dt < best_lc ) best_lc = dt;
+    }
+    bench_report( "lc_from_rfm", class_count, best_lc, (double)READOUT_REPS, "calls" );
+
+    for( runs = 0; total_damage < BENCH_MIN_TIME || runs < BENCH_MIN_RUNS; runs++ )
+    {
+        double t0 = wall_time(), dt;
+
+        for( rep = 0; rep < READOUT_REPS; rep++ )
+        {
+            if( !RFC_damage_from_rfm( &ctx, &damage, /*rfm*/ NULL ) )
+            {
+                fprintf( stderr, "damage_from_rfm failed\n" );
+                exit( EXIT_FAILURE );
+            }
+        }
+        dt            = wall_time() - t0;
+        total_damage += dt;
+        if( best_damage < 0.0 || dt < best_damage ) best_damage = dt;
+    }
+    bench_report( "damage_from_rfm", class_count, best_damage, (double)READOUT_REPS, "calls" );
+
+    free( lc );
+    free( level );
+    RFC_deinit( &ctx );
+}
+#endif /*!RFC_MINIMAL*/
+
+
+int main( void )
+{
+    unsigned class_counts[] = { 10, 100, 1000 };
+    size_t   i;
+
+    make_synthetic();
+
+    printf( "%-32s %8s %15s %18s\n", "benchmark", "classes", "best run", "throughput" );
+
+    for( i = 0; i < NUMEL( class_counts ); i++ )
+    {
+        bench_feed( "feed/long_series", data_export, data_length, class_counts[i], -1, /*with_tp*/ false );
+    }
+    bench_feed( "feed/synthetic_noise", synthetic_noise, SYNTHETIC_LEN, 100, -1, /*with_tp*/ false );
+    bench_feed( "feed/synthetic_sine",  synthetic_sine,  SYNTHETIC_LEN, 100, -1, /*with_tp*/ false );
+
+#if !RFC_MINIMAL && RFC_HCM_SUPPORT
+    bench_feed( "feed_hcm/long_series",  data_export, data_length, 100, RFC_COUNTING_METHOD_HCM,  /*with_tp*/ false );
+#endif
+#if !RFC_MINIMAL && RFC_ASTM_SUPPORT
+    bench_feed( "feed_astm/long_series", data_export, data_length, 100, RFC_COUNTING_METHOD_ASTM, /*with_tp*/ false );
+#endif
+#if RFC_TP_SUPPORT
+    bench_feed( "feed_tp/long_series",   data_export, data_length, 100, -1, /*with_tp*/ true );
+    bench_tp_prune();
+    bench_tp_refeed();
+#endif
+#if !RFC_MINIMAL
+    bench_rfm_readouts( 100 );
+#endif
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,285 @@
+/*
+ *
+ *   |                     .-.
+ *   |                    /   \
+ *   |     .-.===========/     \         .-.
+ *   |    /   \         /       \       /   \
+ *   |   /     \       /         \     /     \         .-.
+ *   +--/-------\-----/-----------\---/-------\-------/---\
+ *   | /         \   /             '-'=========\     /     \   /
+ *   |/           '-'                           \   /       '-'
+ *   |                                           '-'
+ *          ____  ___    _____   __________    ____ _       __
+ *         / __ \/   |  /  _/ | / / ____/ /   / __ \ |     / /
+ *        / /_/ / /| |  / //  |/ / /_  / /   / / / / | /| / /
+ *       / _, _/ ___ |_/ // /|  / __/ / /___/ /_/ /| |/ |/ /
+ *      /_/ |_/_/  |_/___/_/ |_/_/   /_____/\____/ |__/|__/
+ *
+ *    Rainflow Counting Algorithm (4-point-method), C99 compliant
+ *    Synthetic signal replay harness
+ *
+ *================================================================================
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2025, Andras Martin
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *================================================================================
+ */
+
+/*
+ * Replays generated load histories (see test/rfc_siggen.h) through
+ * RFC_feed at a configurable chunk size and reports throughput
+ * (samples/sec) and peak RSS. Unlike the benchmarks, which loop small
+ * signals, the replay works a signal of arbitrary length once, so cache
+ * and allocator behavior at production scale become visible.
+ *
+ *     rfc_replay [-s gaussian|narrowband|block] [-n samples]
+ *                [-c chunk_size] [-k class_count] [-S seed]
+ *
+ * Damage and residue count are printed as a checksum: for a fixed seed
+ * they must not change between runs or commits, regardless of chunking.
+ */
+
+#define RFC_VALUE_TYPE   double
+
+#include "../src/rainflow.h"
+#include "rfc_siggen.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#pragma comment( lib, "psapi.lib" )
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#define DEFAULT_SAMPLES     10000000
+#define DEFAULT_CHUNK       65536
+#define DEFAULT_CLASSES     100
+#define DEFAULT_SEED        20250827ULL
+
+/* Generator parameters, class range is derived from the actual extrema */
+#define SIGNAL_MEAN         0.0
+#define SIGNAL_STDDEV       1000.0
+#define SAMPLES_PER_CYCLE   40.0
+#define BANDWIDTH           0.02
+
+
+static double wall_time( void )
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+
+/* Peak resident set size in MiB, negative if not available */
+static double peak_rss_mib( void )
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+
+    if( GetProcessMemoryInfo( GetCurrentProcess(), &pmc, sizeof( pmc ) ) )
+    {
+        return (double)pmc.PeakWorkingSetSize / ( 1024.0 * 1024.0 );
+    }
+    return -1.0;
+#elif defined(__APPLE__)
+    struct rusage ru;
+
+    if( getrusage( RUSAGE_SELF, &ru ) == 0 )
+    {
+        return (double)ru.ru_maxrss / ( 1024.0 * 1024.0 );  /* Bytes */
+    }
+    return -1.0;
+#elif defined(__unix__)
+    struct rusage ru;
+
+    if( getrusage( RUSAGE_SELF, &ru ) == 0 )
+    {
+        return (double)ru.ru_maxrss / 1024.0;  /* KiB */
+    }
+    return -1.0;
+#else
+    return -1.0;
+#endif
+}
+
+
+static void usage( const char *argv0 )
+{
+    fprintf( stderr,
+             "Usage: %s [-s gaussian|narrowband|block] [-n samples]\n"
+             "          [-c chunk_size] [-k class_count] [-S seed]\n",
+             argv0 );
+}
+
+
+int main( int argc, char *argv[] )
+{
+    const char        *signal_name = "gaussian";
+    size_t             samples     = DEFAULT_SAMPLES;
+    size_t             chunk_size  = DEFAULT_CHUNK;
+    unsigned           class_count = DEFAULT_CLASSES;
+    unsigned long long seed        = DEFAULT_SEED;
+
+    rfc_ctx_s          ctx         = { sizeof(ctx) };
+    double            *data;
+    double             x_min, x_max, class_width, class_offset;
+    double             t0, dt_gen, dt_feed, rss;
+    size_t             residue_cnt;
+    size_t             i, pos;
+    int                n;
+
+    for( n = 1; n < argc; n++ )
+    {
+        if(      !strcmp( argv[n], "-s" ) && n + 1 < argc ) signal_name = argv[++n];
+        else if( !strcmp( argv[n], "-n" ) && n + 1 < argc ) samples     = (size_t)strtoull( argv[++n], NULL, 0 );
+        else if( !strcmp( argv[n], "-c" ) && n + 1 < argc ) chunk_size  = (size_t)strtoull( argv[++n], NULL, 0 );
+        else if( !strcmp( argv[n], "-k" ) && n + 1 < argc ) class_count = (unsigned)strtoul( argv[++n], NULL, 0 );
+        else if( !strcmp( argv[n], "-S" ) && n + 1 < argc ) seed        = strtoull( argv[++n], NULL, 0 );
+        else
+        {
+            usage( argv[0] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if( !samples || !chunk_size || !class_count )
+    {
+        usage( argv[0] );
+        return EXIT_FAILURE;
+    }
+
+    data = (double*)malloc( samples * sizeof(double) );
+
+    if( !data )
+    {
+        fprintf( stderr, "Out of memory (%llu samples)\n", (unsigned long long)samples );
+        return EXIT_FAILURE;
+    }
+
+    t0 = wall_time();
+    if( !strcmp( signal_name, "gaussian" ) )
+    {
+        siggen_gaussian( data, samples, seed, SIGNAL_MEAN, SIGNAL_STDDEV );
+    }
+    else if( !strcmp( signal_name, "narrowband" ) )
+    {
+        siggen_narrowband( data, samples, seed, SIGNAL_MEAN, SIGNAL_STDDEV,
+                           SAMPLES_PER_CYCLE, BANDWIDTH );
+    }
+    else if( !strcmp( signal_name, "block" ) )
+    {
+        siggen_block_program( data, samples, seed, SIGNAL_MEAN, 4.0 * SIGNAL_STDDEV );
+    }
+    else
+    {
+        usage( argv[0] );
+        free( data );
+        return EXIT_FAILURE;
+    }
+    dt_gen = wall_time() - t0;
+
+    /* Class range from the actual extrema */
+    x_min = x_max = data[0];
+    for( i = 1; i < samples; i++ )
+    {
+        if( data[i] > x_max ) x_max = data[i];
+        if( data[i] < x_min ) x_min = data[i];
+    }
+
+    class_width  = ( class_count > 1 ) ? ( ( x_max - x_min ) / ( class_count - 1 ) )
+                                       : ( x_max - x_min );
+    class_offset = x_min - class_width / 2;
+
+    if( !RFC_init( &ctx, class_count, class_width, class_offset, class_width, RFC_FLAGS_DEFAULT ) )
+    {
+        fprintf( stderr, "RFC_init failed\n" );
+        free( data );
+        return EXIT_FAILURE;
+    }
+
+    t0 = wall_time();
+    for( pos = 0; pos < samples; pos += chunk_size )
+    {
+        size_t this_chunk = ( samples - pos < chunk_size ) ? ( samples - pos ) : chunk_size;
+
+        if( !RFC_feed( &ctx, data + pos, this_chunk ) )
+        {
+            fprintf( stderr, "RFC_feed failed at sample %llu\n", (unsigned long long)pos );
+            free( data );
+            return EXIT_FAILURE;
+        }
+    }
+    dt_feed = wall_time() - t0;
+
+    residue_cnt = ctx.residue_cnt;
+
+#if RFC_MINIMAL
+    /* Minimal builds only support the pure 4 point method */
+    if( !RFC_finalize( &ctx, RFC_RES_NONE ) )
+#else /*!RFC_MINIMAL*/
+    if( !RFC_finalize( &ctx, RFC_RES_HALFCYCLES ) )
+#endif /*RFC_MINIMAL*/
+    {
+        fprintf( stderr, "RFC_finalize failed\n" );
+        free( data );
+        return EXIT_FAILURE;
+    }
+
+    rss = peak_rss_mib();
+
+    printf( "signal      = %s\n",    signal_name );
+    printf( "samples     = %llu\n",  (unsigned long long)samples );
+    printf( "chunk size  = %llu\n",  (unsigned long long)chunk_size );
+    printf( "class count = %u\n",    class_count );
+    printf( "seed        = %llu\n",  seed );
+    printf( "generation  = %.3f s\n", dt_gen );
+    printf( "feed        = %.3f s  (%.3f Msamples/s)\n", dt_feed, (double)samples / dt_feed / 1e6 );
+    if( rss >= 0.0 )
+    {
+        printf( "peak rss    = %.1f MiB\n", rss );
+    }
+    else
+    {
+        printf( "peak rss    = n/a\n" );
+    }
+    printf( "damage      = %.10e\n", ctx.damage );
+    printf( "residue     = %llu\n",  (unsigned long long)residue_cnt );
+
+    RFC_deinit( &ctx );
+    free( data );
+
+    return EXIT_SUCCESS;
+}
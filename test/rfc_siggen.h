@@ -0,0 +1,102 @@
+/*
+ *
+ *   |                     .-.
+ *   |                    /   \
+ *   |     .-.===========/     \         .-.
+ *   |    /   \         /       \       /   \
+ *   |   /     \       /         \     /     \         .-.
+ *   +--/-------\-----/-----------\---/-------\-------/---\
+ *   | /         \   /             '-'=========\     /     \   /
+ *   |/           '-'                           \   /       '-'
+ *   |                                           '-'
+ *          ____  ___    _____   __________    ____ _       __
+ *         / __ \/   |  /  _/ | / / ____/ /   / __ \ |     / /
+ *        / /_/ / /| |  / //  |/ / /_  / /   / / / / | /| / /
+ *       / _, _/ ___ |_/ // /|  / __/ / /___/ /_/ /| |/ |/ /
+ *      /_/ |_/_/  |_/___/_/ |_/_/   /_____/\____/ |__/|__/
+ *
+ *    Rainflow Counting Algorithm (4-point-method), C99 compliant
+ *    Synthetic load-signal generator
+ *
+ *================================================================================
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2025, Andras Martin
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *================================================================================
+ */
+
+/*
+ * Parameterized load histories of arbitrary length, generated directly
+ * into memory. The recorded long series (test/long_series.csv) is only
+ * 10k samples and fits any cache; these generators provide workloads at
+ * production scale for the replay harness (test/rfc_replay.c) and the
+ * benchmarks. All generators are deterministic for a given seed, driven
+ * by the same 64 bit LCG as the benchmark's noise source.
+ */
+
+#ifndef RFC_SIGGEN_H
+#define RFC_SIGGEN_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Deterministic random source */
+typedef struct siggen_rng
+{
+    unsigned long long  state;                  /* LCG state */
+    double              gauss_spare;            /* Cached second Box-Muller deviate */
+    int                 gauss_has_spare;
+} siggen_rng_s;
+
+void    siggen_rng_init      ( siggen_rng_s *rng, unsigned long long seed );
+double  siggen_rng_uniform   ( siggen_rng_s *rng );     /* Uniform [0,1) */
+double  siggen_rng_gaussian  ( siggen_rng_s *rng );     /* Standard normal deviate */
+
+/* Gaussian (white) load history, mean +- stddev */
+void    siggen_gaussian      ( double *out, size_t count, unsigned long long seed,
+                               double mean, double stddev );
+
+/* Narrowband Gaussian process: carrier of samples_per_cycle samples with
+   slowly varying (Rayleigh distributed) envelope and phase. bandwidth in
+   (0,1] controls how fast the envelope wanders, small values give the
+   classic beat pattern */
+void    siggen_narrowband    ( double *out, size_t count, unsigned long long seed,
+                               double mean, double stddev,
+                               double samples_per_cycle, double bandwidth );
+
+/* Eight-step block program (Gassner type): constant amplitude blocks with
+   graded cycle counts, two samples (peak/valley) per cycle around mean.
+   The block order is shuffled per program pass with the given seed */
+void    siggen_block_program ( double *out, size_t count, unsigned long long seed,
+                               double mean, double max_amplitude );
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /*RFC_SIGGEN_H*/
@@ -455,6 +455,95 @@ TEST RFC_tp_prune_test( int ccnt )
 }
 
 
+TEST RFC_tp_autoprune_test( void )
+{
+    RFC_VALUE_TYPE      data[DATA_LEN];
+    size_t              data_len;
+    RFC_VALUE_TYPE      x_max;
+    RFC_VALUE_TYPE      x_min;
+    unsigned            class_count         =  100;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_ref             = { sizeof(ctx_ref) };
+    size_t              i, n;
+
+    if(1)
+    {
+#include "long_series.c"
+
+        ASSERT( data_length == DATA_LEN );
+
+        data_len = data_length;
+
+        for( i = 0; i < data_len; i++ )
+        {
+            double value = data_export[i];
+            data[i] = value;
+            if( !i )
+            {
+                x_max = x_min = value;
+            }
+            else
+            {
+                if( value > x_max ) x_max = value;
+                if( value < x_min ) x_min = value;
+            }
+        }
+    }
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width;
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        RFC_deinit( &ctx );
+    }
+
+    /* Count with autoprune against an unpruned reference */
+    ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+    ASSERT( RFC_tp_init( &ctx, NULL, 128, /* is_static */ false ) );
+    ASSERT( RFC_tp_init_autoprune( &ctx, true, /* size */ 300, /* threshold */ 600 ) );
+    ASSERT( RFC_init( &ctx_ref, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+    ASSERT( RFC_tp_init( &ctx_ref, NULL, 128, /* is_static */ false ) );
+
+    ASSERT( RFC_feed( &ctx, data, /* count */ data_len ) );
+    ASSERT( RFC_feed( &ctx_ref, data, /* count */ data_len ) );
+    ASSERT( RFC_finalize( &ctx, /* residual_method */ RFC_RES_NONE ) );
+    ASSERT( RFC_finalize( &ctx_ref, /* residual_method */ RFC_RES_NONE ) );
+
+    /* Countings must not be affected by pruning the turning point history */
+    ASSERT( ctx.damage == ctx_ref.damage );
+    ASSERT( memcmp( ctx.rfm, ctx_ref.rfm, sizeof(rfc_counts_t) * class_count * class_count ) == 0 );
+
+    /* Storage is compact again and holds the tail of the unpruned history */
+    ASSERT( ctx.internal.tp_prune_removal == 0 );
+    ASSERT( ctx.tp_cnt <= 600 );
+    ASSERT( ctx.tp_cnt < ctx_ref.tp_cnt );
+
+    n = ctx.tp_cnt;
+    for( i = 0; i < n; i++ )
+    {
+        ASSERT( ctx.tp[n-1-i].value == ctx_ref.tp[ctx_ref.tp_cnt-1-i].value );
+        ASSERT( ctx.tp[n-1-i].pos   == ctx_ref.tp[ctx_ref.tp_cnt-1-i].pos );
+
+        if( i )
+        {
+            ASSERT( ctx.tp[n-1-i].pos < ctx.tp[n-i].pos );
+        }
+    }
+
+    ASSERT( RFC_deinit( &ctx_ref ) );
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    PASS();
+}
+
+
 bool RFC_tp_refeed_test_export( const char* filename, const rfc_ctx_s *lhs, const rfc_ctx_s *rhs )
 {
     FILE* fid = fopen( filename, "wt" );
@@ -970,32 +1059,1551 @@ TEST RFC_cycle_up( int ccnt )
         }
         for( i = 0; i < ctx.tp_cnt; i++ )
         {
-            ASSERT_EQ( ctx.tp[i].pos, i + 1 );
-            ASSERT_EQ( ctx.tp[i].tp_pos, 0 );
+            ASSERT_EQ( ctx.tp[i].pos, i + 1 );
+            ASSERT_EQ( ctx.tp[i].tp_pos, 0 );
+        }
+#endif /*RFC_TP_SUPPORT*/
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    PASS();
+}
+
+
+TEST RFC_cycle_down( int ccnt )
+{
+    RFC_VALUE_TYPE      x_max           =  4;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  ccnt ? 4 : 0;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+#if RFC_TP_SUPPORT
+    rfc_value_tuple_s   tp[10];
+#endif /*RFC_TP_SUPPORT*/
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE data[] = {4,2,3,1};
+        RFC_VALUE_TYPE sum = 0.0;
+
+#if RFC_TP_SUPPORT
+        ASSERT( NUMEL(tp) >= NUMEL(data) );
+#endif /*RFC_TP_SUPPORT*/
+
+        ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+#if RFC_TP_SUPPORT
+        ASSERT( RFC_tp_init( &ctx, tp, NUMEL(tp), /* is_static */ true ) );
+#endif /*RFC_TP_SUPPORT*/
+        ASSERT( RFC_feed( &ctx, data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_finalize( &ctx, /* residual_method */ RFC_RES_NONE ) );
+
+        for( i = 0; i < class_count * class_count; i++ )
+        {
+            sum += ctx.rfm[i] / ctx.full_inc;
+        }
+
+        if( class_count )
+        {
+            ASSERT_EQ( sum, 1.0 );
+            ASSERT_EQ( rfm_peek( &ctx, 2, 3 ), 1 * ctx.full_inc );
+            ASSERT_EQ( ctx.residue_cnt, 2 );
+            ASSERT_EQ( ctx.residue[0].value, 4.0 );
+            ASSERT_EQ( ctx.residue[1].value, 1.0 );
+            ASSERT_EQ( ctx.state, RFC_STATE_FINISHED );
+            ASSERT_EQ( ctx.residue[0].pos, 1 );
+            ASSERT_EQ( ctx.residue[1].pos, 4 );
+
+#if !RFC_MINIMAL
+            ASSERT_EQ( ctx.lc[0], 1 * ctx.full_inc );
+            ASSERT_EQ( ctx.lc[1], 3 * ctx.full_inc );
+            ASSERT_EQ( ctx.lc[2], 1 * ctx.full_inc );
+
+            /* Check lc count */
+            CHECK_CALL( RFC_lc_test( &ctx, true ) );
+            strip_buffer( NULL );
+#endif /*!RFC_MINIMAL*/
+        }
+#if RFC_TP_SUPPORT
+        if( class_count )
+        {
+            ASSERT_EQ( ctx.residue[0].tp_pos, 1 );
+            ASSERT_EQ( ctx.residue[1].tp_pos, 4 );
+        }
+        for( i = 0; i < ctx.tp_cnt; i++ )
+        {
+            ASSERT_EQ( ctx.tp[i].pos, i + 1 );
+            ASSERT_EQ( ctx.tp[i].tp_pos, 0 );
+        }
+#endif /*RFC_TP_SUPPORT*/
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    PASS();
+}
+
+
+TEST RFC_residue_stress_test( int ccnt )
+{
+    RFC_VALUE_TYPE      x_max           =  4;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  ccnt ? 4 : 0;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+#if RFC_TP_SUPPORT
+    rfc_value_tuple_s   tp[30];
+#endif /*RFC_TP_SUPPORT*/
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE data[] = {2,3,1,4,1,3,2,3, 2,3,1,4,1,3,2,3, 2,3,1,4,1,3,2,3, 1.9};
+        RFC_VALUE_TYPE sum = 0.0;
+
+#if RFC_TP_SUPPORT
+        ASSERT( NUMEL(tp) >= NUMEL(data) );
+#endif /*RFC_TP_SUPPORT*/
+
+        ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+#if RFC_TP_SUPPORT
+        ASSERT( RFC_tp_init( &ctx, tp, NUMEL(tp), /* is_static */ true ) );
+#endif /*RFC_TP_SUPPORT*/
+        ASSERT( RFC_feed( &ctx, data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_finalize( &ctx, /* residual_method */ RFC_RES_NONE ) );
+
+        for( i = 0; i < class_count * class_count; i++ )
+        {
+            sum += ctx.rfm[i] / ctx.full_inc;
+        }
+
+        if( class_count )
+        {
+            ASSERT_EQ( sum, 9.0 );
+            ASSERT_EQ( rfm_peek( &ctx, 1, 3 ), 2 * ctx.full_inc );
+            ASSERT_EQ( rfm_peek( &ctx, 3, 2 ), 5 * ctx.full_inc );
+            ASSERT_EQ( rfm_peek( &ctx, 4, 1 ), 2 * ctx.full_inc );
+            ASSERT_EQ( ctx.residue_cnt, 7 );
+            ASSERT_EQ( ctx.residue[0].value, 2.0 );
+            ASSERT_EQ( ctx.residue[1].value, 3.0 );
+            ASSERT_EQ( ctx.residue[2].value, 1.0 );
+            ASSERT_EQ( ctx.residue[3].value, 4.0 );
+            ASSERT_EQ( ctx.residue[4].value, 1.0 );
+            ASSERT_EQ( ctx.residue[5].value, 3.0 );
+            ASSERT_EQ( ctx.residue[6].value, 1.9 );
+            ASSERT_EQ( ctx.residue[7].value, 3.0 );
+            ASSERT_EQ( ctx.residue[8].value, 1.9 );
+            ASSERT_EQ( ctx.state, RFC_STATE_FINISHED );
+            ASSERT_EQ( ctx.residue[0].pos, 1 );
+            ASSERT_EQ( ctx.residue[1].pos, 2 );
+            ASSERT_EQ( ctx.residue[2].pos, 3 );
+            ASSERT_EQ( ctx.residue[3].pos, 20 );
+            ASSERT_EQ( ctx.residue[4].pos, 21 );
+            ASSERT_EQ( ctx.residue[5].pos, 24 );
+            ASSERT_EQ( ctx.residue[6].pos, 25 );
+            ASSERT_EQ( ctx.residue[7].pos, 24 );
+            ASSERT_EQ( ctx.residue[8].pos, 25 );
+        }
+#if RFC_TP_SUPPORT
+        if( class_count )
+        {
+            ASSERT_EQ( ctx.residue[0].tp_pos, 1 );
+            ASSERT_EQ( ctx.residue[1].tp_pos, 2 );
+            ASSERT_EQ( ctx.residue[2].tp_pos, 3 );
+            ASSERT_EQ( ctx.residue[3].tp_pos, 20 );
+            ASSERT_EQ( ctx.residue[4].tp_pos, 21 );
+            ASSERT_EQ( ctx.residue[5].tp_pos, 24 );
+            ASSERT_EQ( ctx.residue[6].tp_pos, 25 );
+        }
+        for( i = 0; i < ctx.tp_cnt; i++ )
+        {
+            ASSERT_EQ( ctx.tp[i].pos, i + 1 );
+            ASSERT_EQ( ctx.tp[i].tp_pos, 0 );
+        }
+#endif /*RFC_TP_SUPPORT*/
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    PASS();
+}
+
+
+TEST RFC_small_example( int ccnt )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  ccnt ? (unsigned)x_max : 0;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+#if RFC_TP_SUPPORT
+    rfc_value_tuple_s   tp[20];
+#endif /*RFC_TP_SUPPORT*/
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE data[] = {2,5,3,6,2,4,1,6,1,4,1,5,3,6,3,6,1,5,2};
+        RFC_VALUE_TYPE sum = 0.0;
+
+#if RFC_TP_SUPPORT
+        ASSERT( NUMEL(tp) >= NUMEL(data) );
+#endif /*RFC_TP_SUPPORT*/
+
+        ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+#if RFC_TP_SUPPORT
+        ASSERT( RFC_tp_init( &ctx, tp, NUMEL(tp), /* is_static */ true ) );
+#endif /*RFC_TP_SUPPORT*/
+        ASSERT( RFC_feed( &ctx, data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_finalize( &ctx, /* residual_method */ RFC_RES_NONE ) );
+
+        for( i = 0; i < class_count * class_count; i++ )
+        {
+            sum += ctx.rfm[i] / ctx.full_inc;
+        }
+
+        if( class_count )
+        {
+            ASSERT_EQ( sum, 7.0 );
+            ASSERT_EQ( rfm_peek( &ctx, 5, 3 ), 2 * ctx.full_inc );
+            ASSERT_EQ( rfm_peek( &ctx, 6, 3 ), 1 * ctx.full_inc );
+            ASSERT_EQ( rfm_peek( &ctx, 1, 4 ), 1 * ctx.full_inc );
+            ASSERT_EQ( rfm_peek( &ctx, 2, 4 ), 1 * ctx.full_inc );
+            ASSERT_EQ( rfm_peek( &ctx, 1, 6 ), 2 * ctx.full_inc );
+            ASSERT_EQ( ctx.residue_cnt, 5 );
+            ASSERT_EQ( ctx.residue[0].value, 2.0 );
+            ASSERT_EQ( ctx.residue[1].value, 6.0 );
+            ASSERT_EQ( ctx.residue[2].value, 1.0 );
+            ASSERT_EQ( ctx.residue[3].value, 5.0 );
+            ASSERT_EQ( ctx.residue[4].value, 2.0 );
+#if !RFC_MINIMAL
+            /* Check lc count */
+            CHECK_CALL( RFC_lc_test( &ctx, true ) );
+            strip_buffer( NULL );
+#endif /*!RFC_MINIMAL*/
+        }
+        ASSERT_EQ( ctx.state, RFC_STATE_FINISHED );
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    PASS();
+}
+
+
+#if !RFC_MINIMAL
+TEST RFC_feed_prefilter( int ccnt )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  ccnt ? (unsigned)x_max : 0;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_ref         = { sizeof(ctx_ref) };   /* reference, fed sample-by-sample */
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        /* Monotone runs and plateaus, prefilter in RFC_feed() must not alter results */
+        RFC_VALUE_TYPE data[] = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+
+        ASSERT( RFC_init( &ctx,     class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_ref, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        /* RFC_feed() skips monotone run interiors, RFC_feed_scaled() feeds every sample */
+        ASSERT( RFC_feed( &ctx, data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_feed_scaled( &ctx_ref, data, /* count */ NUMEL( data ), /* factor */ 1.0 ) );
+
+        ASSERT( RFC_finalize( &ctx,     /* residual_method */ RFC_RES_NONE ) );
+        ASSERT( RFC_finalize( &ctx_ref, /* residual_method */ RFC_RES_NONE ) );
+
+        ASSERT_EQ( ctx.residue_cnt, ctx_ref.residue_cnt );
+        for( i = 0; i < ctx.residue_cnt; i++ )
+        {
+            ASSERT_EQ( ctx.residue[i].value, ctx_ref.residue[i].value );
+            ASSERT_EQ( ctx.residue[i].pos,   ctx_ref.residue[i].pos );
+        }
+
+        for( i = 0; i < class_count * class_count; i++ )
+        {
+            ASSERT_EQ( ctx.rfm[i], ctx_ref.rfm[i] );
+        }
+
+        for( i = 0; i < class_count; i++ )
+        {
+            ASSERT_EQ( ctx.rp[i], ctx_ref.rp[i] );
+            ASSERT_EQ( ctx.lc[i], ctx_ref.lc[i] );
+        }
+
+        ASSERT_EQ( ctx.damage, ctx_ref.damage );
+        ASSERT_EQ( ctx.internal.pos, ctx_ref.internal.pos );
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    if( ctx_ref.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_ref ) );
+    }
+
+    PASS();
+}
+
+
+TEST RFC_ctx_merge_test( int ccnt )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  ccnt ? (unsigned)x_max : 0;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_lhs         = { sizeof(ctx_lhs) };   /* first chunk, merge destination */
+    rfc_ctx_s           ctx_rhs         = { sizeof(ctx_rhs) };   /* second chunk, merge source */
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE data[]    = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+        size_t         split_at  = 13;
+
+        ASSERT( RFC_init( &ctx,     class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_lhs, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_rhs, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        /* Reference counts the series in one pass, the chunks are counted separately and merged */
+        ASSERT( RFC_feed( &ctx,     data,            /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_feed( &ctx_lhs, data,            /* count */ split_at ) );
+        ASSERT( RFC_feed( &ctx_rhs, data + split_at, /* count */ NUMEL( data ) - split_at ) );
+
+        ASSERT( RFC_ctx_merge( &ctx_lhs, &ctx_rhs ) );
+
+        ASSERT( RFC_finalize( &ctx,     /* residual_method */ RFC_RES_NONE ) );
+        ASSERT( RFC_finalize( &ctx_lhs, /* residual_method */ RFC_RES_NONE ) );
+
+        ASSERT_EQ( ctx_lhs.residue_cnt, ctx.residue_cnt );
+        for( i = 0; i < ctx.residue_cnt; i++ )
+        {
+            ASSERT_EQ( ctx_lhs.residue[i].value, ctx.residue[i].value );
+            ASSERT_EQ( ctx_lhs.residue[i].pos,   ctx.residue[i].pos );
+        }
+
+        for( i = 0; i < class_count * class_count; i++ )
+        {
+            /* Cycles closing near the seam may appear transposed (standing vs. hanging) */
+            size_t j = ( i % class_count ) * class_count + i / class_count;
+
+            ASSERT_EQ( ctx_lhs.rfm[i] + ctx_lhs.rfm[j], ctx.rfm[i] + ctx.rfm[j] );
+        }
+
+        for( i = 0; i < class_count; i++ )
+        {
+            ASSERT_EQ( ctx_lhs.rp[i], ctx.rp[i] );
+            ASSERT_EQ( ctx_lhs.lc[i], ctx.lc[i] );
+        }
+
+        if( class_count )
+        {
+            /* Cycles close in different order, damage summation differs in the last bits */
+            ASSERT_IN_RANGE( 1.0, ctx_lhs.damage / ctx.damage, 1e-10 );
+        }
+        else
+        {
+            ASSERT_EQ( ctx_lhs.damage, 0.0 );
+        }
+        ASSERT_EQ( ctx_lhs.internal.pos, ctx.internal.pos );
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    if( ctx_lhs.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_lhs ) );
+    }
+
+    if( ctx_rhs.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_rhs ) );
+    }
+
+    PASS();
+}
+
+
+TEST RFC_ctx_attach_test( void )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  (unsigned)x_max;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_coarse      = { sizeof(ctx_coarse) };   /* follower, 3 class grid */
+    rfc_ctx_s           ctx_fine        = { sizeof(ctx_fine) };     /* follower, leader grid */
+    rfc_ctx_s           ctx_ref         = { sizeof(ctx_ref) };      /* reference, fed directly */
+    rfc_ctx_s           ctx_err         = { sizeof(ctx_err) };      /* throwaway leader for rejection checks */
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE data[] = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+
+        ASSERT( RFC_init( &ctx,        class_count,     class_width,     class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_fine,   class_count,     class_width,     class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_coarse, class_count / 2, class_width * 2, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_ref,    class_count / 2, class_width * 2, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_err,    class_count,     class_width,     class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        /* Contexts may not follow themselves */
+        ASSERT( !RFC_ctx_attach( &ctx_err, &ctx_err ) );
+        ASSERT_EQ( ctx_err.error, RFC_ERROR_INVARG );
+        ASSERT( RFC_deinit( &ctx_err ) );
+
+        ASSERT( RFC_ctx_attach( &ctx, &ctx_fine ) );
+        ASSERT( RFC_ctx_attach( &ctx, &ctx_coarse ) );
+
+        /* One pass over the leader counts all attached grids */
+        ASSERT( RFC_feed( &ctx, data, /* count */ NUMEL( data ) ) );
+
+        /* Followers must be freshly initialized when attached */
+        ASSERT( RFC_init( &ctx_err, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( !RFC_ctx_attach( &ctx_err, &ctx_fine ) );
+        ASSERT_EQ( ctx_err.error, RFC_ERROR_INVARG );
+
+        /* The leader finalizes first, forwarding a pending interim point */
+        ASSERT( RFC_finalize( &ctx,        /* residual_method */ RFC_RES_NONE ) );
+        ASSERT( RFC_finalize( &ctx_fine,   /* residual_method */ RFC_RES_NONE ) );
+        ASSERT( RFC_finalize( &ctx_coarse, /* residual_method */ RFC_RES_NONE ) );
+
+        /* A follower on the leader grid matches the leader exactly */
+        ASSERT_EQ( ctx_fine.residue_cnt, ctx.residue_cnt );
+        for( i = 0; i < ctx.residue_cnt; i++ )
+        {
+            ASSERT_EQ( ctx_fine.residue[i].value, ctx.residue[i].value );
+            ASSERT_EQ( ctx_fine.residue[i].pos,   ctx.residue[i].pos );
+        }
+
+        for( i = 0; i < class_count * class_count; i++ )
+        {
+            ASSERT_EQ( ctx_fine.rfm[i], ctx.rfm[i] );
+        }
+
+        for( i = 0; i < class_count; i++ )
+        {
+            ASSERT_EQ( ctx_fine.rp[i], ctx.rp[i] );
+            ASSERT_EQ( ctx_fine.lc[i], ctx.lc[i] );
+        }
+
+        ASSERT_EQ( ctx_fine.damage, ctx.damage );
+        ASSERT_EQ( ctx_fine.internal.pos, ctx.internal.pos );
+
+        /* A coarser follower matches a reference counting the raw stream on its
+           grid: with a shared hysteresis the settled turning points coincide */
+        ASSERT( RFC_feed( &ctx_ref, data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_finalize( &ctx_ref, /* residual_method */ RFC_RES_NONE ) );
+
+        ASSERT_EQ( ctx_coarse.residue_cnt, ctx_ref.residue_cnt );
+        for( i = 0; i < ctx_ref.residue_cnt; i++ )
+        {
+            ASSERT_EQ( ctx_coarse.residue[i].cls, ctx_ref.residue[i].cls );
+            ASSERT_EQ( ctx_coarse.residue[i].pos, ctx_ref.residue[i].pos );
+        }
+
+        for( i = 0; i < ( class_count / 2 ) * ( class_count / 2 ); i++ )
+        {
+            ASSERT_EQ( ctx_coarse.rfm[i], ctx_ref.rfm[i] );
+        }
+
+        for( i = 0; i < class_count / 2; i++ )
+        {
+            ASSERT_EQ( ctx_coarse.rp[i], ctx_ref.rp[i] );
+            ASSERT_EQ( ctx_coarse.lc[i], ctx_ref.lc[i] );
+        }
+
+        ASSERT_EQ( ctx_coarse.damage, ctx_ref.damage );
+
+        /* Detaching leaves the follower results intact */
+        ASSERT( RFC_ctx_detach( &ctx, &ctx_fine ) );
+        ASSERT( RFC_ctx_detach( &ctx, &ctx_coarse ) );
+        ASSERT( !RFC_ctx_detach( &ctx, &ctx_coarse ) );
+        ASSERT_EQ( ctx.error, RFC_ERROR_INVARG );
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    if( ctx_coarse.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_coarse ) );
+    }
+
+    if( ctx_fine.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_fine ) );
+    }
+
+    if( ctx_ref.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_ref ) );
+    }
+
+    if( ctx_err.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_err ) );
+    }
+
+    PASS();
+}
+
+
+TEST RFC_lc_rp_delta_test( void )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  (unsigned)x_max;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE       data[]  = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+        rfc_counts_t         lc[6], rp[6], lc_mirror[6] = {0}, rp_mirror[6] = {0}, counts[6];
+        unsigned             index[6], count;
+        const rfc_counts_t  *view;
+        size_t               lc_seen = 0, rp_seen = 0, version;
+
+        ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        /* Mirror the histograms chunk by chunk from deltas only */
+        for( i = 0; i < NUMEL( data ); i += 9 )
+        {
+            unsigned j;
+
+            ASSERT( RFC_feed( &ctx, data + i, /* count */ 9 ) );
+
+            count = class_count;
+            ASSERT( RFC_lc_get_delta( &ctx, &lc_seen, index, counts, &count ) );
+            for( j = 0; j < count; j++ )
+            {
+                lc_mirror[ index[j] ] = counts[j];
+            }
+
+            count = class_count;
+            ASSERT( RFC_rp_get_delta( &ctx, &rp_seen, index, counts, &count ) );
+            for( j = 0; j < count; j++ )
+            {
+                rp_mirror[ index[j] ] = counts[j];
+            }
+        }
+
+        /* Nothing changed since the last poll */
+        ASSERT( RFC_lc_get_delta( &ctx, &lc_seen, index, counts, &count ) );
+        ASSERT_EQ( count, 0 );
+        ASSERT( RFC_rp_get_delta( &ctx, &rp_seen, index, counts, &count ) );
+        ASSERT_EQ( count, 0 );
+
+        /* The mirrors match a full copy readout */
+        ASSERT( RFC_lc_get( &ctx, lc, /*level*/ NULL ) );
+        ASSERT( RFC_rp_get( &ctx, rp, /*Sa*/ NULL ) );
+        for( i = 0; i < class_count; i++ )
+        {
+            ASSERT_EQ( lc_mirror[i], lc[i] );
+            ASSERT_EQ( rp_mirror[i], rp[i] );
+        }
+
+        /* Zero-copy views refer the live histograms */
+        ASSERT( RFC_lc_view( &ctx, &view, &version ) );
+        ASSERT( view == ctx.lc );
+        ASSERT_EQ( version, lc_seen );
+        ASSERT( RFC_rp_view( &ctx, &view, &version ) );
+        ASSERT( view == ctx.rp );
+        ASSERT_EQ( version, rp_seen );
+
+        /* Clearing stamps every bin, a subsequent poll resyncs completely */
+        ASSERT( RFC_clear_counts( &ctx ) );
+        count = class_count;
+        ASSERT( RFC_rp_get_delta( &ctx, &rp_seen, index, counts, &count ) );
+        ASSERT_EQ( count, class_count );
+        for( i = 0; i < count; i++ )
+        {
+            ASSERT_EQ( counts[i], 0 );
+        }
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    PASS();
+}
+
+
+#if RFC_DAMAGE_FAST
+TEST RFC_damage_lut_share_test( void )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  (unsigned)x_max;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_share       = { sizeof(ctx_share) };  /* adopts the table of ctx */
+    rfc_ctx_s           ctx_err         = { sizeof(ctx_err) };    /* differently parametrized */
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE  data[]  = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+
+        ASSERT( RFC_init( &ctx,       class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_share, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        /* Identically parametrized contexts share one immutable table */
+        ASSERT( RFC_damage_lut_share( &ctx_share, &ctx ) );
+        ASSERT( ctx_share.damage_lut    == ctx.damage_lut );
+        ASSERT( ctx.damage_lut_refcnt   != NULL );
+        ASSERT_EQ( *ctx.damage_lut_refcnt, 2 );
+
+        /* The table was completed before sharing */
+        for( i = 0; i < class_count; i++ )
+        {
+            ASSERT( ctx.damage_lut_row_valid[i] );
+        }
+
+        /* Both contexts count independently, damage matches */
+        ASSERT( RFC_feed( &ctx,       data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_feed( &ctx_share, data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_finalize( &ctx,       /* residual_method */ RFC_RES_REPEATED ) );
+        ASSERT( RFC_finalize( &ctx_share, /* residual_method */ RFC_RES_REPEATED ) );
+        ASSERT( ctx.damage > 0.0 );
+        ASSERT_EQ( ctx.damage, ctx_share.damage );
+
+        /* Differing class parameters refuse to share */
+        ASSERT( RFC_init( &ctx_err, class_count, class_width * 2, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( !RFC_damage_lut_share( &ctx_err, &ctx ) );
+        ASSERT_EQ( RFC_error_get( &ctx_err ), RFC_ERROR_INVARG );
+
+        /* Donor goes first, reference counting keeps the table alive */
+        ASSERT( RFC_deinit( &ctx ) );
+        ASSERT( ctx_share.damage_lut_refcnt != NULL );
+        ASSERT_EQ( *ctx_share.damage_lut_refcnt, 1 );
+        ASSERT( RFC_deinit( &ctx_share ) );
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    if( ctx_share.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_share ) );
+    }
+
+    if( ctx_err.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_err ) );
+    }
+
+    PASS();
+}
+#endif /*RFC_DAMAGE_FAST*/
+
+
+#if RFC_HCM_SUPPORT
+TEST RFC_hcm_init_test( void )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  (unsigned)x_max;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_hcm         = { sizeof(ctx_hcm) };  /* counts on a caller provided stack */
+    rfc_ctx_s           ctx_err         = { sizeof(ctx_err) };  /* gets an undersized stack */
+    /* Stack for 2*class_count+1 turning points, alignment is in the callers hand */
+    static rfc_value_tuple_s
+                        stack[2*6+1];
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE  data[]  = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+
+        ASSERT( RFC_init( &ctx,     class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_hcm, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ctx.counting_method     = RFC_COUNTING_METHOD_HCM;
+        ctx_hcm.counting_method = RFC_COUNTING_METHOD_HCM;
+
+        /* Undersized buffers are rejected, the stack must hold 2*class_count+1 points */
+        ASSERT( RFC_init( &ctx_err, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( !RFC_hcm_init( &ctx_err, stack, /* stack_cap */ 2 * class_count, /* is_static */ true ) );
+        ASSERT_EQ( RFC_error_get( &ctx_err ), RFC_ERROR_INVARG );
+
+        /* The static stack replaces the one from RFC_init() */
+        ASSERT( RFC_hcm_init( &ctx_hcm, stack, /* stack_cap */ NUMEL( stack ), /* is_static */ true ) );
+        ASSERT( ctx_hcm.internal.hcm.stack == stack );
+        ASSERT( ctx_hcm.internal.hcm.stack_static );
+
+        /* Counting matches the context with the default heap stack */
+        ASSERT( RFC_feed( &ctx,     data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_feed( &ctx_hcm, data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_finalize( &ctx,     /* residual_method */ RFC_RES_HALFCYCLES ) );
+        ASSERT( RFC_finalize( &ctx_hcm, /* residual_method */ RFC_RES_HALFCYCLES ) );
+
+        for( i = 0; i < (size_t)class_count * class_count; i++ )
+        {
+            ASSERT_EQ( ctx.rfm[i], ctx_hcm.rfm[i] );
+        }
+        ASSERT_EQ( ctx.damage, ctx_hcm.damage );
+
+        /* RFC_deinit() leaves the static stack alone (the address sanitizer
+           would trip on freeing it otherwise) */
+        ASSERT( RFC_deinit( &ctx_hcm ) );
+        ASSERT( RFC_deinit( &ctx ) );
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    if( ctx_hcm.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_hcm ) );
+    }
+
+    if( ctx_err.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_err ) );
+    }
+
+    PASS();
+}
+#endif /*RFC_HCM_SUPPORT*/
+
+
+TEST RFC_rfm_sparse_test( void )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  (unsigned)x_max;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_sp          = { sizeof(ctx_sp) };   /* sparse rainflow matrix storage */
+    unsigned            from, to;
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE  data[]      = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+        rfc_counts_t    lc[6], lc_sp[6], rp[6], rp_sp[6];
+        rfc_counts_t    sum, sum_sp;
+        rfc_rfm_item_s *items = NULL, *items_sp = NULL;
+        unsigned        count, count_sp;
+        double          damage, damage_sp;
+
+        ASSERT( RFC_init( &ctx,    class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_sp, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_rfm_init_sparse( &ctx_sp, /* cap */ 0 ) );
+
+        /* Sparse storage supersedes the dense matrix */
+        ASSERT(  ctx_sp.rfm        == NULL );
+        ASSERT(  ctx_sp.rfm_sparse != NULL );
+
+        /* Sparse storage must be requested before feeding */
+        ASSERT( RFC_feed( &ctx, data, /* count */ 1 ) );
+        ASSERT( !RFC_rfm_init_sparse( &ctx, /* cap */ 0 ) );
+
+        ASSERT( RFC_feed( &ctx,    data + 1, /* count */ NUMEL( data ) - 1 ) );
+        ASSERT( RFC_feed( &ctx_sp, data,     /* count */ NUMEL( data ) ) );
+
+        ASSERT( RFC_finalize( &ctx,    /* residual_method */ RFC_RES_HALFCYCLES ) );
+        ASSERT( RFC_finalize( &ctx_sp, /* residual_method */ RFC_RES_HALFCYCLES ) );
+
+        /* Counting is identical, only the matrix storage differs */
+        ASSERT_EQ( ctx_sp.damage, ctx.damage );
+
+        for( from = 1; from <= class_count; from++ )
+        {
+            for( to = 1; to <= class_count; to++ )
+            {
+                ASSERT_EQ( rfm_peek( &ctx_sp, from, to ), rfm_peek( &ctx, from, to ) );
+            }
+        }
+
+        ASSERT( RFC_rfm_non_zeros( &ctx,    &count ) );
+        ASSERT( RFC_rfm_non_zeros( &ctx_sp, &count_sp ) );
+        ASSERT_EQ( count_sp, count );
+
+        ASSERT( RFC_rfm_sum( &ctx,    0, class_count - 1, 0, class_count - 1, &sum ) );
+        ASSERT( RFC_rfm_sum( &ctx_sp, 0, class_count - 1, 0, class_count - 1, &sum_sp ) );
+        ASSERT_EQ( sum_sp, sum );
+
+        ASSERT( RFC_rfm_damage( &ctx,    0, class_count - 1, 0, class_count - 1, &damage ) );
+        ASSERT( RFC_rfm_damage( &ctx_sp, 0, class_count - 1, 0, class_count - 1, &damage_sp ) );
+        ASSERT_EQ( damage_sp, damage );
+
+        /* Sparse elements are delivered in row-major order, like the dense matrix */
+        count = count_sp = 0;
+        ASSERT( RFC_rfm_get( &ctx,    &items,    &count ) );
+        ASSERT( RFC_rfm_get( &ctx_sp, &items_sp, &count_sp ) );
+        ASSERT_EQ( count_sp, count );
+        for( i = 0; i < count; i++ )
+        {
+            ASSERT_EQ( items_sp[i].from,   items[i].from );
+            ASSERT_EQ( items_sp[i].to,     items[i].to );
+            ASSERT_EQ( items_sp[i].counts, items[i].counts );
+        }
+        (void)ctx.mem_alloc(    items,    0, 0, RFC_MEM_AIM_RFM_ELEMENTS );
+        (void)ctx_sp.mem_alloc( items_sp, 0, 0, RFC_MEM_AIM_RFM_ELEMENTS );
+
+        /* Histograms derived from the sparse matrix */
+        ASSERT( RFC_lc_from_rfm( &ctx,    lc,    NULL, NULL, RFC_FLAGS_COUNT_LC ) );
+        ASSERT( RFC_lc_from_rfm( &ctx_sp, lc_sp, NULL, NULL, RFC_FLAGS_COUNT_LC ) );
+        ASSERT( RFC_rp_from_rfm( &ctx,    rp,    NULL, NULL ) );
+        ASSERT( RFC_rp_from_rfm( &ctx_sp, rp_sp, NULL, NULL ) );
+        for( i = 0; i < class_count; i++ )
+        {
+            ASSERT_EQ( lc_sp[i], lc[i] );
+            ASSERT_EQ( rp_sp[i], rp[i] );
+        }
+
+        ASSERT( RFC_rfm_make_symmetric( &ctx ) );
+        ASSERT( RFC_rfm_make_symmetric( &ctx_sp ) );
+
+        for( from = 1; from <= class_count; from++ )
+        {
+            for( to = 1; to <= class_count; to++ )
+            {
+                ASSERT_EQ( rfm_peek( &ctx_sp, from, to ), rfm_peek( &ctx, from, to ) );
+            }
+        }
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    if( ctx_sp.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_sp ) );
+    }
+
+    PASS();
+}
+
+
+TEST RFC_ctx_serialize_test( int ccnt )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  ccnt ? (unsigned)x_max : 0;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_rst         = { sizeof(ctx_rst) };   /* restored from the snapshot */
+    void               *snapshot        = NULL;
+    size_t              snapshot_size;
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE data[]    = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+        size_t         split_at  = 13;
+
+        ASSERT( RFC_init( &ctx,     class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_rst, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        /* Snapshot in mid-stream, the reference continues counting uninterrupted */
+        ASSERT( RFC_feed( &ctx, data, /* count */ split_at ) );
+        ASSERT( RFC_ctx_serialize( &ctx, &snapshot, &snapshot_size ) );
+        ASSERT( snapshot != NULL );
+
+        /* Restoring requires a freshly initialized context with matching class count */
+        ASSERT( RFC_ctx_deserialize( &ctx_rst, snapshot, snapshot_size ) );
+        ASSERT( !RFC_ctx_deserialize( &ctx_rst, snapshot, snapshot_size ) );
+
+        /* Both count the remainder, results must not differ at all */
+        ASSERT( RFC_feed( &ctx,     data + split_at, /* count */ NUMEL( data ) - split_at ) );
+        ASSERT( RFC_feed( &ctx_rst, data + split_at, /* count */ NUMEL( data ) - split_at ) );
+
+        ASSERT( RFC_finalize( &ctx,     /* residual_method */ RFC_RES_HALFCYCLES ) );
+        ASSERT( RFC_finalize( &ctx_rst, /* residual_method */ RFC_RES_HALFCYCLES ) );
+
+        ASSERT_EQ( ctx_rst.damage, ctx.damage );
+        ASSERT_EQ( ctx_rst.internal.pos, ctx.internal.pos );
+
+        ASSERT_EQ( ctx_rst.residue_cnt, ctx.residue_cnt );
+        for( i = 0; i < ctx.residue_cnt; i++ )
+        {
+            ASSERT_EQ( ctx_rst.residue[i].value, ctx.residue[i].value );
+            ASSERT_EQ( ctx_rst.residue[i].pos,   ctx.residue[i].pos );
+        }
+
+        for( i = 0; i < class_count * class_count; i++ )
+        {
+            ASSERT_EQ( ctx_rst.rfm[i], ctx.rfm[i] );
+        }
+
+        for( i = 0; i < class_count; i++ )
+        {
+            ASSERT_EQ( ctx_rst.rp[i], ctx.rp[i] );
+            ASSERT_EQ( ctx_rst.lc[i], ctx.lc[i] );
+        }
+    } while(0);
+
+    if( snapshot )
+    {
+        (void)ctx.mem_alloc( snapshot, 0, 0, RFC_MEM_AIM_TEMP );
+    }
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    if( ctx_rst.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_rst ) );
+    }
+
+    PASS();
+}
+
+
+TEST RFC_finalize_preview_test( void )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  (unsigned)x_max;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_ref         = { sizeof(ctx_ref) };   /* destructively finalized reference */
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE   data[]     = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+        rfc_res_method_e methods[]  = { RFC_RES_IGNORE, RFC_RES_HALFCYCLES, RFC_RES_FULLCYCLES,
+                                        RFC_RES_CLORMANN_SEEGER, RFC_RES_REPEATED, RFC_RES_RP_DIN45667 };
+        rfc_counts_t     rfm_delta[6*6], rp_delta[6];
+        rfc_result_s     result;
+        double           damage_before;
+        size_t           residue_before;
+        size_t           m;
+
+        ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_feed( &ctx, data, /* count */ NUMEL( data ) ) );
+
+        damage_before  = ctx.damage;
+        residue_before = ctx.residue_cnt;
+
+        for( m = 0; m < NUMEL( methods ); m++ )
+        {
+            ASSERT( RFC_init( &ctx_ref, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+            ASSERT( RFC_feed( &ctx_ref, data, /* count */ NUMEL( data ) ) );
+            ASSERT( RFC_finalize( &ctx_ref, methods[m] ) );
+
+            result.rfm = rfm_delta;
+            result.rp  = rp_delta;
+            ASSERT( RFC_finalize_preview( &ctx, methods[m], &result ) );
+
+            /* The preview matches a destructive finalize bit for bit */
+            ASSERT_EQ( ctx_ref.damage,         result.damage );
+            ASSERT_EQ( ctx_ref.damage_residue, result.damage_residue );
+            ASSERT_EQ( ctx_ref.residue_cnt,    result.residue_cnt );
+
+            for( i = 0; i < (size_t)class_count * class_count; i++ )
+            {
+                ASSERT_EQ( ctx_ref.rfm[i], (rfc_counts_t)( ctx.rfm[i] + rfm_delta[i] ) );
+            }
+
+            for( i = 0; i < class_count; i++ )
+            {
+                ASSERT_EQ( ctx_ref.rp[i], (rfc_counts_t)( ctx.rp[i] + rp_delta[i] ) );
+            }
+
+            /* The context itself keeps streaming unaffected */
+            ASSERT_EQ( damage_before,  ctx.damage );
+            ASSERT_EQ( residue_before, ctx.residue_cnt );
+            ASSERT( ctx.state == RFC_STATE_BUSY || ctx.state == RFC_STATE_BUSY_INTERIM );
+
+            ASSERT( RFC_deinit( &ctx_ref ) );
+        }
+
+        /* Counting continues after previewing, as if nothing happened */
+        ASSERT( RFC_feed( &ctx, data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_finalize( &ctx, /* residual_method */ RFC_RES_HALFCYCLES ) );
+
+        ASSERT( RFC_init( &ctx_ref, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_feed( &ctx_ref, data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_feed( &ctx_ref, data, /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_finalize( &ctx_ref, /* residual_method */ RFC_RES_HALFCYCLES ) );
+        ASSERT_EQ( ctx_ref.damage, ctx.damage );
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    if( ctx_ref.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_ref ) );
+    }
+
+    PASS();
+}
+
+
+TEST RFC_feed_ring_test( void )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  (unsigned)x_max;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_ring        = { sizeof(ctx_ring) };   /* fed through the ring buffer */
+    rfc_ring_buffer_s   ring;
+    rfc_value_t         ring_storage[8];
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE data[]   = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+        size_t         fed      = 0;
+        size_t         drained;
+
+        ASSERT( RFC_init( &ctx,      class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_ring, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        ASSERT( RFC_feed_ring_attach( &ctx_ring, &ring, ring_storage, NUMEL( ring_storage ) ) );
+
+        /* The ring must be attached before feeding */
+        ASSERT(  RFC_feed( &ctx, data, /* count */ 1 ) );
+        ASSERT( !RFC_feed_ring_attach( &ctx, &ring, ring_storage, NUMEL( ring_storage ) ) );
+        ASSERT(  RFC_feed( &ctx, data + 1, NUMEL( data ) - 1 ) );
+
+        /* Draining without published samples is a no-op */
+        ASSERT( RFC_feed_ring_drain( &ctx_ring, &drained ) );
+        ASSERT_EQ( drained, (size_t)0 );
+
+        /* A burst beyond the free space is rejected as a whole */
+        ASSERT( !RFC_feed_ring_push( &ring, data, NUMEL( ring_storage ) ) );
+        ASSERT(  RFC_feed_ring_push( &ring, data, NUMEL( ring_storage ) - 1 ) );
+        ASSERT( !RFC_feed_ring_push( &ring, data, 1 ) );
+        ASSERT(  RFC_feed_ring_drain( &ctx_ring, &drained ) );
+        ASSERT_EQ( drained, NUMEL( ring_storage ) - 1 );
+        fed = drained;
+
+        /* Push the remainder in small bursts, wrapping the ring repeatedly */
+        while( fed < NUMEL( data ) )
+        {
+            size_t burst = NUMEL( data ) - fed;
+
+            if( burst > 3 )
+            {
+                burst = 3;
+            }
+
+            ASSERT( RFC_feed_ring_push( &ring, data + fed, burst ) );
+            ASSERT( RFC_feed_ring_drain( &ctx_ring, &drained ) );
+            ASSERT_EQ( drained, burst );
+            fed += burst;
+        }
+
+        ASSERT( RFC_finalize( &ctx,      /* residual_method */ RFC_RES_HALFCYCLES ) );
+        ASSERT( RFC_finalize( &ctx_ring, /* residual_method */ RFC_RES_HALFCYCLES ) );
+
+        ASSERT_EQ( ctx_ring.damage, ctx.damage );
+        ASSERT_EQ( ctx_ring.internal.pos, ctx.internal.pos );
+
+        for( i = 0; i < class_count * class_count; i++ )
+        {
+            ASSERT_EQ( ctx_ring.rfm[i], ctx.rfm[i] );
+        }
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    if( ctx_ring.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_ring ) );
+    }
+
+    PASS();
+}
+
+
+#if RFC_FILE_SUPPORT
+TEST RFC_feed_file_test( void )
+{
+    unsigned            class_count     =  100;
+    RFC_VALUE_TYPE      class_width     =  50;
+    RFC_VALUE_TYPE      class_offset    = -2500;
+    RFC_VALUE_TYPE      hysteresis      =  50;
+    rfc_ctx_s           ctx_file        = { sizeof(ctx_file) };   /* fed via RFC_feed_file() */
+    const char         *filename        = "rfc_feed_file_test.tmp";
+    RFC_VALUE_TYPE      data[400];
+    size_t              i;
+
+    for( i = 0; i < NUMEL( data ); i++ )
+    {
+        data[i] = (RFC_VALUE_TYPE)( 1000.0 * sin( 0.37 * (double)i ) + 800.0 * sin( 0.11 * (double)i ) );
+    }
+
+    do
+    {
+        FILE *file;
+
+        /* Raw binary64, plain series: must match RFC_feed() bit for bit */
+        ASSERT( RFC_init( &ctx,      class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_file, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        ASSERT( RFC_feed( &ctx, data, NUMEL( data ) ) );
+
+        file = fopen( filename, "wb" );
+        ASSERT( file != NULL );
+        for( i = 0; i < NUMEL( data ); i++ )
+        {
+            double value = (double)data[i];
+            ASSERT_EQ( fwrite( &value, sizeof(value), 1, file ), (size_t)1 );
+        }
+        fclose( file );
+
+        ASSERT( RFC_feed_file( &ctx_file, filename, RFC_FILE_FORMAT_F64, /*channel_count*/ 1, /*channel*/ 0 ) );
+
+        ASSERT_EQ( ctx_file.damage, ctx.damage );
+        ASSERT_EQ( ctx_file.internal.pos, ctx.internal.pos );
+        ASSERT_EQ( ctx_file.residue_cnt, ctx.residue_cnt );
+        ASSERT( 0 == memcmp( ctx_file.rfm, ctx.rfm, sizeof(rfc_counts_t) * class_count * class_count ) );
+
+        ASSERT( RFC_deinit( &ctx_file ) );
+
+        /* Interleaved 3 channel binary64, feed channel 1 only */
+        ASSERT( RFC_init( &ctx_file, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        file = fopen( filename, "wb" );
+        ASSERT( file != NULL );
+        for( i = 0; i < NUMEL( data ); i++ )
+        {
+            double record[3];
+
+            record[0] = (double)i;                /* time channel */
+            record[1] = (double)data[i];
+            record[2] = -1e9;                     /* out of range decoy */
+            ASSERT_EQ( fwrite( record, sizeof(record), 1, file ), (size_t)1 );
+        }
+        fclose( file );
+
+        ASSERT( RFC_feed_file( &ctx_file, filename, RFC_FILE_FORMAT_F64, /*channel_count*/ 3, /*channel*/ 1 ) );
+
+        ASSERT_EQ( ctx_file.damage, ctx.damage );
+        ASSERT_EQ( ctx_file.internal.pos, ctx.internal.pos );
+        ASSERT( 0 == memcmp( ctx_file.rfm, ctx.rfm, sizeof(rfc_counts_t) * class_count * class_count ) );
+
+        ASSERT( RFC_deinit( &ctx_file ) );
+
+        /* CSV with header, blank line and mixed field formats, column 1 */
+        ASSERT( RFC_init( &ctx_file, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        file = fopen( filename, "w" );
+        ASSERT( file != NULL );
+        fprintf( file, "time;load;flag\n\n" );
+        for( i = 0; i < NUMEL( data ); i++ )
+        {
+            /* %.17g round trips doubles and exercises fast and strtod path */
+            fprintf( file, "%u%c%.17g%c1\n", (unsigned)i,
+                     ( i % 2 ) ? ';' : ',', (double)data[i],
+                     ( i % 2 ) ? ';' : ',' );
+        }
+        fclose( file );
+
+        ASSERT( RFC_feed_file( &ctx_file, filename, RFC_FILE_FORMAT_CSV, /*channel_count*/ 3, /*channel*/ 1 ) );
+
+        ASSERT_EQ( ctx_file.damage, ctx.damage );
+        ASSERT_EQ( ctx_file.internal.pos, ctx.internal.pos );
+        ASSERT( 0 == memcmp( ctx_file.rfm, ctx.rfm, sizeof(rfc_counts_t) * class_count * class_count ) );
+
+        ASSERT( RFC_deinit( &ctx_file ) );
+
+        /* Binary32 matches feeding float-quantized values */
+        ASSERT( RFC_init( &ctx_file, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        file = fopen( filename, "wb" );
+        ASSERT( file != NULL );
+        for( i = 0; i < NUMEL( data ); i++ )
+        {
+            float value = (float)data[i];
+            ASSERT_EQ( fwrite( &value, sizeof(value), 1, file ), (size_t)1 );
+        }
+        fclose( file );
+
+        ASSERT( RFC_feed_file( &ctx_file, filename, RFC_FILE_FORMAT_F32, /*channel_count*/ 1, /*channel*/ 0 ) );
+
+        ASSERT( RFC_deinit( &ctx ) );
+        ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        for( i = 0; i < NUMEL( data ); i++ )
+        {
+            RFC_VALUE_TYPE value = (RFC_VALUE_TYPE)(float)data[i];
+            ASSERT( RFC_feed( &ctx, &value, 1 ) );
+        }
+
+        ASSERT_EQ( ctx_file.damage, ctx.damage );
+        ASSERT_EQ( ctx_file.internal.pos, ctx.internal.pos );
+        ASSERT( 0 == memcmp( ctx_file.rfm, ctx.rfm, sizeof(rfc_counts_t) * class_count * class_count ) );
+
+        ASSERT( RFC_deinit( &ctx_file ) );
+
+        /* Missing file raises RFC_ERROR_FILE */
+        ASSERT( RFC_init( &ctx_file, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( !RFC_feed_file( &ctx_file, "rfc_feed_file_test.missing", RFC_FILE_FORMAT_F64, 1, 0 ) );
+        ASSERT_EQ( ctx_file.error, RFC_ERROR_FILE );
+
+        /* Invalid channel selection */
+        ASSERT( !RFC_feed_file( &ctx_file, filename, RFC_FILE_FORMAT_F64, 2, 2 ) );
+    } while(0);
+
+    remove( filename );
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    if( ctx_file.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_file ) );
+    }
+
+    PASS();
+}
+#endif /*RFC_FILE_SUPPORT*/
+
+
+#if RFC_FILE_SUPPORT && RFC_TP_SUPPORT
+TEST RFC_tp_export_test( void )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  (unsigned)x_max;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_imp         = { sizeof(ctx_imp) };   /* rebuilt from the archive */
+    rfc_ctx_s           ctx_err         = { sizeof(ctx_err) };
+    rfc_value_tuple_s   tp[32], tp_imp[32];
+    rfc_tp_export_s     writer;
+    const char         *filename        = "rfc_tp_export_test.tmp";
+    RFC_VALUE_TYPE      data[]          = { 2, 3, 4, 5, 4, 3, 2, 3, 4, 5, 6, 6, 6, 2, 1, 2, 3, 4, 4, 1, 2, 5, 5, 3, 2, 6, 1 };
+    int                 format;
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    /* Binary64, then binary32 (the data is exact in float, so results match) */
+    for( format = 0; format < 2; format++ )
+    {
+        do
+        {
+            size_t half;
+
+            ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+            ASSERT( RFC_tp_init( &ctx, tp, NUMEL(tp), /* is_static */ true ) );
+            ASSERT( RFC_feed( &ctx, data, NUMEL(data) ) );
+            ASSERT( RFC_finalize( &ctx, RFC_RES_NONE ) );
+
+            /* Archive the turning points in two slices plus a results record */
+            half = ctx.tp_cnt / 2;
+            ASSERT( RFC_tp_export_open( &ctx, &writer, filename,
+                                        format ? RFC_FILE_FORMAT_F32 : RFC_FILE_FORMAT_F64 ) );
+            ASSERT( RFC_tp_export_append( &ctx, &writer, tp, half ) );
+            ASSERT( RFC_tp_export_append( &ctx, &writer, tp + half, ctx.tp_cnt - half ) );
+            ASSERT( RFC_tp_export_results( &ctx, &writer ) );
+            ASSERT( RFC_tp_export_close( &ctx, &writer ) );
+            ASSERT_EQ( writer.tp_cnt, ctx.tp_cnt );
+
+            /* Feeding the archive back reproduces the results bit for bit */
+            ASSERT( RFC_init( &ctx_imp, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+            ASSERT( RFC_tp_init( &ctx_imp, tp_imp, NUMEL(tp_imp), /* is_static */ true ) );
+            ASSERT( RFC_tp_import( &ctx_imp, filename ) );
+            ASSERT( RFC_finalize( &ctx_imp, RFC_RES_NONE ) );
+
+            ASSERT_EQ( ctx_imp.damage, ctx.damage );
+            ASSERT_EQ( ctx_imp.residue_cnt, ctx.residue_cnt );
+            ASSERT_EQ( ctx_imp.tp_cnt, ctx.tp_cnt );
+            ASSERT( 0 == memcmp( ctx_imp.rfm, ctx.rfm, sizeof(rfc_counts_t) * class_count * class_count ) );
+
+            /* Stream positions survive the delta encoding */
+            for( i = 0; i < ctx.tp_cnt; i++ )
+            {
+                ASSERT_EQ( tp_imp[i].pos,   tp[i].pos );
+                ASSERT_EQ( tp_imp[i].value, tp[i].value );
+            }
+        } while(0);
+
+        if( ctx.state != RFC_STATE_INIT0 )
+        {
+            ASSERT( RFC_deinit( &ctx ) );
+        }
+
+        if( ctx_imp.state != RFC_STATE_INIT0 )
+        {
+            ASSERT( RFC_deinit( &ctx_imp ) );
+        }
+    }
+
+    do
+    {
+        rfc_value_tuple_s bogus[2] = { {0}, {0} };
+        FILE             *file;
+
+        ASSERT( RFC_init( &ctx_err, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        /* CSV has no fixed value width */
+        ASSERT( !RFC_tp_export_open( &ctx_err, &writer, filename, RFC_FILE_FORMAT_CSV ) );
+        ASSERT_EQ( ctx_err.error, RFC_ERROR_INVARG );
+        ASSERT( RFC_deinit( &ctx_err ) );
+
+        /* Positions must increase strictly */
+        ASSERT( RFC_init( &ctx_err, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_tp_export_open( &ctx_err, &writer, filename, RFC_FILE_FORMAT_F64 ) );
+        bogus[0].value = 2; bogus[0].pos = 5;
+        bogus[1].value = 4; bogus[1].pos = 5;
+        ASSERT( !RFC_tp_export_append( &ctx_err, &writer, bogus, 2 ) );
+        ASSERT_EQ( ctx_err.error, RFC_ERROR_DATA_INCONSISTENT );
+        ASSERT( RFC_tp_export_close( &ctx_err, &writer ) );
+        ASSERT( RFC_deinit( &ctx_err ) );
+
+        /* Missing file raises RFC_ERROR_FILE */
+        ASSERT( RFC_init( &ctx_err, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( !RFC_tp_import( &ctx_err, "rfc_tp_export_test.missing" ) );
+        ASSERT_EQ( ctx_err.error, RFC_ERROR_FILE );
+        ASSERT( RFC_deinit( &ctx_err ) );
+
+        /* Wrong magic is rejected as inconsistent data */
+        file = fopen( filename, "wb" );
+        ASSERT( file != NULL );
+        ASSERT_EQ( fwrite( "NOTRFTP1", 1, 8, file ), (size_t)8 );
+        fclose( file );
+
+        ASSERT( RFC_init( &ctx_err, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( !RFC_tp_import( &ctx_err, filename ) );
+        ASSERT_EQ( ctx_err.error, RFC_ERROR_DATA_INCONSISTENT );
+    } while(0);
+
+    remove( filename );
+
+    if( ctx_err.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_err ) );
+    }
+
+    PASS();
+}
+#endif /*RFC_FILE_SUPPORT && RFC_TP_SUPPORT*/
+
+
+#if RFC_DH_SUPPORT
+TEST RFC_dh_sparse_test( void )
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  (unsigned)x_max;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_ctx_s           ctx_sp          = { sizeof(ctx_sp) };   /* sparse damage history storage */
+    rfc_ctx_s           ctx_rst         = { sizeof(ctx_rst) };  /* restored from the snapshot */
+    rfc_ctx_s           ctx_err         = { sizeof(ctx_err) };
+#if RFC_TP_SUPPORT
+    rfc_value_tuple_s   tp[32], tp_sp[32], tp_rst[32];
+#endif /*RFC_TP_SUPPORT*/
+    void               *snapshot        = NULL;
+    size_t              snapshot_size;
+    size_t              i;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE data[]   = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+        size_t         split_at = 13;
+        double         damage, damage_sp, total;
+
+        ASSERT( RFC_init( &ctx,     class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_sp,  class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_init( &ctx_rst, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+#if RFC_TP_SUPPORT
+        ASSERT( RFC_tp_init( &ctx,     tp,     NUMEL(tp),     /*is_static*/ true ) );
+        ASSERT( RFC_tp_init( &ctx_sp,  tp_sp,  NUMEL(tp_sp),  /*is_static*/ true ) );
+        ASSERT( RFC_tp_init( &ctx_rst, tp_rst, NUMEL(tp_rst), /*is_static*/ true ) );
+#endif /*RFC_TP_SUPPORT*/
+
+        /* Small capacities to exercise storage growth */
+        ASSERT( RFC_dh_init( &ctx, RFC_SD_HALF_23, /*dh*/ NULL, /*dh_cap*/ 8, /*is_static*/ false ) );
+        ASSERT( RFC_dh_init_sparse( &ctx_sp,  RFC_SD_HALF_23, /*cap*/ 4 ) );
+        ASSERT( RFC_dh_init_sparse( &ctx_rst, RFC_SD_HALF_23, /*cap*/ 4 ) );
+
+        /* Transient methods write the history densely and are refused */
+        ASSERT(  RFC_init( &ctx_err, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( !RFC_dh_init_sparse( &ctx_err, RFC_SD_TRANSIENT_23c, /*cap*/ 0 ) );
+        ASSERT_EQ( RFC_ERROR_INVARG, ctx_err.error );
+        ASSERT(  RFC_deinit( &ctx_err ) );
+
+        /* Snapshot in mid-stream, the sparse history travels with it */
+        ASSERT( RFC_feed( &ctx_sp, data, /* count */ split_at ) );
+        ASSERT( RFC_ctx_serialize( &ctx_sp, &snapshot, &snapshot_size ) );
+        ASSERT( RFC_ctx_deserialize( &ctx_rst, snapshot, snapshot_size ) );
+
+        ASSERT( RFC_feed( &ctx,     data,            /* count */ NUMEL( data ) ) );
+        ASSERT( RFC_feed( &ctx_sp,  data + split_at, /* count */ NUMEL( data ) - split_at ) );
+        ASSERT( RFC_feed( &ctx_rst, data + split_at, /* count */ NUMEL( data ) - split_at ) );
+
+        /* Sparse storage must be requested before feeding */
+        ASSERT( !RFC_dh_init_sparse( &ctx_sp, RFC_SD_HALF_23, /*cap*/ 0 ) );
+
+        ASSERT( RFC_finalize( &ctx,     /* residual_method */ RFC_RES_HALFCYCLES ) );
+        ASSERT( RFC_finalize( &ctx_sp,  /* residual_method */ RFC_RES_HALFCYCLES ) );
+        ASSERT( RFC_finalize( &ctx_rst, /* residual_method */ RFC_RES_HALFCYCLES ) );
+
+        /* Counting is identical, only the history storage differs */
+        ASSERT_EQ( ctx_sp.damage, ctx.damage );
+        ASSERT_EQ( ctx_sp.dh_cnt, ctx.dh_cnt );
+        ASSERT( ctx_sp.dh_sparse_cnt > 0 );
+        ASSERT( ctx_sp.dh_sparse_cnt < ctx_sp.dh_cnt );
+
+        /* Window sums agree between dense and sparse storage */
+        for( i = 0; i < ctx.dh_cnt; i += 8 )
+        {
+            ASSERT( RFC_dh_window_damage( &ctx,    i, i + 8, &damage ) );
+            ASSERT( RFC_dh_window_damage( &ctx_sp, i, i + 8, &damage_sp ) );
+            ASSERT_EQ( damage_sp, damage );
+            ASSERT( RFC_dh_window_damage( &ctx_rst, i, i + 8, &damage_sp ) );
+            ASSERT_EQ( damage_sp, damage );
         }
-#endif /*RFC_TP_SUPPORT*/
+
+        /* The whole history accounts the total damage */
+        ASSERT( RFC_dh_window_damage( &ctx_sp, 0, (size_t)-1, &total ) );
+        ASSERT_IN_RANGE( 1.0, total / ctx.damage, 1e-10 );
+
+        /* A window beyond the stream end is empty */
+        ASSERT( RFC_dh_window_damage( &ctx_sp, ctx_sp.dh_cnt, (size_t)-1, &total ) );
+        ASSERT_EQ( 0.0, total );
     } while(0);
 
+    if( snapshot )
+    {
+        (void)ctx_sp.mem_alloc( snapshot, 0, 0, RFC_MEM_AIM_TEMP );
+    }
+
     if( ctx.state != RFC_STATE_INIT0 )
     {
         ASSERT( RFC_deinit( &ctx ) );
     }
 
+    if( ctx_sp.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_sp ) );
+    }
+
+    if( ctx_rst.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_rst ) );
+    }
+
     PASS();
 }
+#endif /*RFC_DH_SUPPORT*/
 
 
-TEST RFC_cycle_down( int ccnt )
+TEST RFC_mem_arena_test( int slab_size )
 {
-    RFC_VALUE_TYPE      x_max           =  4;
+    RFC_VALUE_TYPE      x_max           =  6;
     RFC_VALUE_TYPE      x_min           =  1;
-    unsigned            class_count     =  ccnt ? 4 : 0;
+    unsigned            class_count     =  (unsigned)x_max;
     RFC_VALUE_TYPE      class_width;
     RFC_VALUE_TYPE      class_offset;
     RFC_VALUE_TYPE      hysteresis;
-#if RFC_TP_SUPPORT
-    rfc_value_tuple_s   tp[10];
-#endif /*RFC_TP_SUPPORT*/
+    rfc_ctx_s           ctx_arena       = { sizeof(ctx_arena) };   /* allocates from an arena slab */
     size_t              i;
 
     calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
@@ -1003,58 +2611,45 @@ TEST RFC_cycle_down( int ccnt )
 
     do
     {
-        RFC_VALUE_TYPE data[] = {4,2,3,1};
-        RFC_VALUE_TYPE sum = 0.0;
+        RFC_VALUE_TYPE  data[]  = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+        rfc_rfm_item_s *items   = NULL;
+        unsigned        count;
 
-#if RFC_TP_SUPPORT
-        ASSERT( NUMEL(tp) >= NUMEL(data) );
-#endif /*RFC_TP_SUPPORT*/
+        /* Attach before RFC_init(), which does the first allocations;
+           a small slab exercises the transparent heap fallback */
+        ASSERT( RFC_mem_arena_init( &ctx_arena, (size_t)slab_size ) );
+        ASSERT( RFC_init( &ctx_arena, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+
+        /* Attaching twice or after RFC_init() is refused */
+        ASSERT( !RFC_mem_arena_init( &ctx_arena, (size_t)slab_size ) );
 
         ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
-#if RFC_TP_SUPPORT
-        ASSERT( RFC_tp_init( &ctx, tp, NUMEL(tp), /* is_static */ true ) );
-#endif /*RFC_TP_SUPPORT*/
-        ASSERT( RFC_feed( &ctx, data, /* count */ NUMEL( data ) ) );
-        ASSERT( RFC_finalize( &ctx, /* residual_method */ RFC_RES_NONE ) );
 
-        for( i = 0; i < class_count * class_count; i++ )
-        {
-            sum += ctx.rfm[i] / ctx.full_inc;
-        }
+        ASSERT( RFC_feed( &ctx,       data, NUMEL( data ) ) );
+        ASSERT( RFC_feed( &ctx_arena, data, NUMEL( data ) ) );
 
-        if( class_count )
-        {
-            ASSERT_EQ( sum, 1.0 );
-            ASSERT_EQ( rfm_peek( &ctx, 2, 3 ), 1 * ctx.full_inc );
-            ASSERT_EQ( ctx.residue_cnt, 2 );
-            ASSERT_EQ( ctx.residue[0].value, 4.0 );
-            ASSERT_EQ( ctx.residue[1].value, 1.0 );
-            ASSERT_EQ( ctx.state, RFC_STATE_FINISHED );
-            ASSERT_EQ( ctx.residue[0].pos, 1 );
-            ASSERT_EQ( ctx.residue[1].pos, 4 );
+        ASSERT( RFC_finalize( &ctx,       /* residual_method */ RFC_RES_HALFCYCLES ) );
+        ASSERT( RFC_finalize( &ctx_arena, /* residual_method */ RFC_RES_HALFCYCLES ) );
 
-#if !RFC_MINIMAL
-            ASSERT_EQ( ctx.lc[0], 1 * ctx.full_inc );
-            ASSERT_EQ( ctx.lc[1], 3 * ctx.full_inc );
-            ASSERT_EQ( ctx.lc[2], 1 * ctx.full_inc );
+        /* Counting doesn't depend on the allocator */
+        ASSERT_EQ( ctx_arena.damage, ctx.damage );
 
-            /* Check lc count */
-            CHECK_CALL( RFC_lc_test( &ctx, true ) );
-            strip_buffer( NULL );
-#endif /*!RFC_MINIMAL*/
-        }
-#if RFC_TP_SUPPORT
-        if( class_count )
+        for( i = 0; i < class_count * class_count; i++ )
         {
-            ASSERT_EQ( ctx.residue[0].tp_pos, 1 );
-            ASSERT_EQ( ctx.residue[1].tp_pos, 4 );
+            ASSERT_EQ( ctx_arena.rfm[i], ctx.rfm[i] );
         }
-        for( i = 0; i < ctx.tp_cnt; i++ )
+
+        for( i = 0; i < class_count; i++ )
         {
-            ASSERT_EQ( ctx.tp[i].pos, i + 1 );
-            ASSERT_EQ( ctx.tp[i].tp_pos, 0 );
+            ASSERT_EQ( ctx_arena.rp[i], ctx.rp[i] );
+            ASSERT_EQ( ctx_arena.lc[i], ctx.lc[i] );
         }
-#endif /*RFC_TP_SUPPORT*/
+
+        /* Handed out buffers are released through .mem_alloc as usual */
+        count = 0;
+        ASSERT( RFC_rfm_get( &ctx_arena, &items, &count ) );
+        ASSERT( count > 0 );
+        (void)ctx_arena.mem_alloc( items, 0, 0, RFC_MEM_AIM_RFM_ELEMENTS );
     } while(0);
 
     if( ctx.state != RFC_STATE_INIT0 )
@@ -1062,21 +2657,24 @@ TEST RFC_cycle_down( int ccnt )
         ASSERT( RFC_deinit( &ctx ) );
     }
 
+    if( ctx_arena.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_arena ) );
+    }
+
     PASS();
 }
 
 
-TEST RFC_residue_stress_test( int ccnt )
+TEST RFC_wl_param_set_test(void)
 {
-    RFC_VALUE_TYPE      x_max           =  4;
+    RFC_VALUE_TYPE      x_max           =  6;
     RFC_VALUE_TYPE      x_min           =  1;
-    unsigned            class_count     =  ccnt ? 4 : 0;
+    unsigned            class_count     =  (unsigned)x_max;
     RFC_VALUE_TYPE      class_width;
     RFC_VALUE_TYPE      class_offset;
     RFC_VALUE_TYPE      hysteresis;
-#if RFC_TP_SUPPORT
-    rfc_value_tuple_s   tp[30];
-#endif /*RFC_TP_SUPPORT*/
+    rfc_ctx_s           ctx_wl          = { sizeof(ctx_wl) };   /* Woehler curve set mid-stream */
     size_t              i;
 
     calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
@@ -1084,69 +2682,33 @@ TEST RFC_residue_stress_test( int ccnt )
 
     do
     {
-        RFC_VALUE_TYPE data[] = {2,3,1,4,1,3,2,3, 2,3,1,4,1,3,2,3, 2,3,1,4,1,3,2,3, 1.9};
-        RFC_VALUE_TYPE sum = 0.0;
-
-#if RFC_TP_SUPPORT
-        ASSERT( NUMEL(tp) >= NUMEL(data) );
-#endif /*RFC_TP_SUPPORT*/
+        RFC_VALUE_TYPE  data[]  = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+        rfc_wl_param_s  wl;
 
         ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
-#if RFC_TP_SUPPORT
-        ASSERT( RFC_tp_init( &ctx, tp, NUMEL(tp), /* is_static */ true ) );
-#endif /*RFC_TP_SUPPORT*/
-        ASSERT( RFC_feed( &ctx, data, /* count */ NUMEL( data ) ) );
-        ASSERT( RFC_finalize( &ctx, /* residual_method */ RFC_RES_NONE ) );
+        ASSERT( RFC_wl_init_elementary( &ctx, /*sx*/ 400.0, /*nx*/ 2e6, /*k*/ 6.0 ) );
+        ASSERT( RFC_wl_param_get( &ctx, &wl ) );
 
-        for( i = 0; i < class_count * class_count; i++ )
-        {
-            sum += ctx.rfm[i] / ctx.full_inc;
-        }
+        ASSERT( RFC_init( &ctx_wl, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
 
-        if( class_count )
-        {
-            ASSERT_EQ( sum, 9.0 );
-            ASSERT_EQ( rfm_peek( &ctx, 1, 3 ), 2 * ctx.full_inc );
-            ASSERT_EQ( rfm_peek( &ctx, 3, 2 ), 5 * ctx.full_inc );
-            ASSERT_EQ( rfm_peek( &ctx, 4, 1 ), 2 * ctx.full_inc );
-            ASSERT_EQ( ctx.residue_cnt, 7 );
-            ASSERT_EQ( ctx.residue[0].value, 2.0 );
-            ASSERT_EQ( ctx.residue[1].value, 3.0 );
-            ASSERT_EQ( ctx.residue[2].value, 1.0 );
-            ASSERT_EQ( ctx.residue[3].value, 4.0 );
-            ASSERT_EQ( ctx.residue[4].value, 1.0 );
-            ASSERT_EQ( ctx.residue[5].value, 3.0 );
-            ASSERT_EQ( ctx.residue[6].value, 1.9 );
-            ASSERT_EQ( ctx.residue[7].value, 3.0 );
-            ASSERT_EQ( ctx.residue[8].value, 1.9 );
-            ASSERT_EQ( ctx.state, RFC_STATE_FINISHED );
-            ASSERT_EQ( ctx.residue[0].pos, 1 );
-            ASSERT_EQ( ctx.residue[1].pos, 2 );
-            ASSERT_EQ( ctx.residue[2].pos, 3 );
-            ASSERT_EQ( ctx.residue[3].pos, 20 );
-            ASSERT_EQ( ctx.residue[4].pos, 21 );
-            ASSERT_EQ( ctx.residue[5].pos, 24 );
-            ASSERT_EQ( ctx.residue[6].pos, 25 );
-            ASSERT_EQ( ctx.residue[7].pos, 24 );
-            ASSERT_EQ( ctx.residue[8].pos, 25 );
-        }
-#if RFC_TP_SUPPORT
-        if( class_count )
-        {
-            ASSERT_EQ( ctx.residue[0].tp_pos, 1 );
-            ASSERT_EQ( ctx.residue[1].tp_pos, 2 );
-            ASSERT_EQ( ctx.residue[2].tp_pos, 3 );
-            ASSERT_EQ( ctx.residue[3].tp_pos, 20 );
-            ASSERT_EQ( ctx.residue[4].tp_pos, 21 );
-            ASSERT_EQ( ctx.residue[5].tp_pos, 24 );
-            ASSERT_EQ( ctx.residue[6].tp_pos, 25 );
-        }
-        for( i = 0; i < ctx.tp_cnt; i++ )
+        ASSERT( RFC_feed( &ctx, data, NUMEL( data ) ) );
+
+        /* Switch the Woehler curve mid-stream, before any cycle has closed;
+           cycles closing afterwards must accrue damage with the new
+           parameters (stale look-up tables must be rebuilt) */
+        ASSERT( RFC_feed( &ctx_wl, data, /* count */ 2 ) );
+        ASSERT( RFC_wl_param_set( &ctx_wl, &wl ) );
+        ASSERT( RFC_feed( &ctx_wl, data + 2, NUMEL( data ) - 2 ) );
+
+        ASSERT( RFC_finalize( &ctx,    /* residual_method */ RFC_RES_HALFCYCLES ) );
+        ASSERT( RFC_finalize( &ctx_wl, /* residual_method */ RFC_RES_HALFCYCLES ) );
+
+        ASSERT_EQ( ctx_wl.damage, ctx.damage );
+
+        for( i = 0; i < class_count * class_count; i++ )
         {
-            ASSERT_EQ( ctx.tp[i].pos, i + 1 );
-            ASSERT_EQ( ctx.tp[i].tp_pos, 0 );
+            ASSERT_EQ( ctx_wl.rfm[i], ctx.rfm[i] );
         }
-#endif /*RFC_TP_SUPPORT*/
     } while(0);
 
     if( ctx.state != RFC_STATE_INIT0 )
@@ -1154,21 +2716,26 @@ TEST RFC_residue_stress_test( int ccnt )
         ASSERT( RFC_deinit( &ctx ) );
     }
 
+    if( ctx_wl.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_wl ) );
+    }
+
     PASS();
 }
 
 
-TEST RFC_small_example( int ccnt )
+TEST RFC_damage_from_rfm_wl_test(void)
 {
     RFC_VALUE_TYPE      x_max           =  6;
     RFC_VALUE_TYPE      x_min           =  1;
-    unsigned            class_count     =  ccnt ? (unsigned)x_max : 0;
+    unsigned            class_count     =  (unsigned)x_max;
     RFC_VALUE_TYPE      class_width;
     RFC_VALUE_TYPE      class_offset;
     RFC_VALUE_TYPE      hysteresis;
-#if RFC_TP_SUPPORT
-    rfc_value_tuple_s   tp[20];
-#endif /*RFC_TP_SUPPORT*/
+    rfc_wl_param_s      wl[3];
+    double              damage_batch[3];
+    double              damage_single;
     size_t              i;
 
     calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
@@ -1176,46 +2743,33 @@ TEST RFC_small_example( int ccnt )
 
     do
     {
-        RFC_VALUE_TYPE data[] = {2,5,3,6,2,4,1,6,1,4,1,5,3,6,3,6,1,5,2};
-        RFC_VALUE_TYPE sum = 0.0;
-
-#if RFC_TP_SUPPORT
-        ASSERT( NUMEL(tp) >= NUMEL(data) );
-#endif /*RFC_TP_SUPPORT*/
+        RFC_VALUE_TYPE  data[]  = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+        double          sx[]    = { 400.0, 300.0, 500.0 };
+        double          nx[]    = { 2e6,   1e6,   5e6   };
+        double          k[]     = { 6.0,   4.0,   5.0   };
 
         ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
-#if RFC_TP_SUPPORT
-        ASSERT( RFC_tp_init( &ctx, tp, NUMEL(tp), /* is_static */ true ) );
-#endif /*RFC_TP_SUPPORT*/
-        ASSERT( RFC_feed( &ctx, data, /* count */ NUMEL( data ) ) );
-        ASSERT( RFC_finalize( &ctx, /* residual_method */ RFC_RES_NONE ) );
 
-        for( i = 0; i < class_count * class_count; i++ )
+        /* Take complete parameter sets from the elementary rule */
+        for( i = 0; i < NUMEL( wl ); i++ )
         {
-            sum += ctx.rfm[i] / ctx.full_inc;
+            ASSERT( RFC_wl_init_elementary( &ctx, sx[i], nx[i], k[i] ) );
+            ASSERT( RFC_wl_param_get( &ctx, &wl[i] ) );
         }
 
-        if( class_count )
+        ASSERT( RFC_feed( &ctx, data, NUMEL( data ) ) );
+        ASSERT( RFC_finalize( &ctx, /* residual_method */ RFC_RES_HALFCYCLES ) );
+
+        /* The batch kernel must match a per-set full matrix rescan */
+        ASSERT( RFC_damage_from_rfm_wl( &ctx, damage_batch, /*rfm*/ NULL, wl, (unsigned)NUMEL( wl ) ) );
+
+        for( i = 0; i < NUMEL( wl ); i++ )
         {
-            ASSERT_EQ( sum, 7.0 );
-            ASSERT_EQ( rfm_peek( &ctx, 5, 3 ), 2 * ctx.full_inc );
-            ASSERT_EQ( rfm_peek( &ctx, 6, 3 ), 1 * ctx.full_inc );
-            ASSERT_EQ( rfm_peek( &ctx, 1, 4 ), 1 * ctx.full_inc );
-            ASSERT_EQ( rfm_peek( &ctx, 2, 4 ), 1 * ctx.full_inc );
-            ASSERT_EQ( rfm_peek( &ctx, 1, 6 ), 2 * ctx.full_inc );
-            ASSERT_EQ( ctx.residue_cnt, 5 );
-            ASSERT_EQ( ctx.residue[0].value, 2.0 );
-            ASSERT_EQ( ctx.residue[1].value, 6.0 );
-            ASSERT_EQ( ctx.residue[2].value, 1.0 );
-            ASSERT_EQ( ctx.residue[3].value, 5.0 );
-            ASSERT_EQ( ctx.residue[4].value, 2.0 );
-#if !RFC_MINIMAL
-            /* Check lc count */
-            CHECK_CALL( RFC_lc_test( &ctx, true ) );
-            strip_buffer( NULL );
-#endif /*!RFC_MINIMAL*/
+            ASSERT( RFC_wl_param_set( &ctx, &wl[i] ) );
+            ASSERT( RFC_damage_from_rfm( &ctx, &damage_single, /*rfm*/ NULL ) );
+            ASSERT( damage_single > 0.0 );
+            ASSERT_IN_RANGE( damage_single, damage_batch[i], damage_single * 1e-10 );
         }
-        ASSERT_EQ( ctx.state, RFC_STATE_FINISHED );
     } while(0);
 
     if( ctx.state != RFC_STATE_INIT0 )
@@ -1227,6 +2781,104 @@ TEST RFC_small_example( int ccnt )
 }
 
 
+#if RFC_STATS_SUPPORT
+TEST RFC_stats_test(void)
+{
+    RFC_VALUE_TYPE      x_max           =  6;
+    RFC_VALUE_TYPE      x_min           =  1;
+    unsigned            class_count     =  (unsigned)x_max;
+    RFC_VALUE_TYPE      class_width;
+    RFC_VALUE_TYPE      class_offset;
+    RFC_VALUE_TYPE      hysteresis;
+    rfc_stats_s         stats;
+
+    calc_class_param( x_max, x_min, class_count, &class_width, &class_offset );
+    hysteresis = class_width * 0.99;
+
+    do
+    {
+        RFC_VALUE_TYPE  data[]  = {2,3,4,5,4,3,2,3,4,5,6,6,6,2,1,2,3,4,4,1,2,5,5,3,2,6,1};
+
+        ASSERT( RFC_init( &ctx, class_count, class_width, class_offset, hysteresis, RFC_FLAGS_DEFAULT ) );
+        ASSERT( RFC_feed( &ctx, data, NUMEL( data ) ) );
+
+        ASSERT( RFC_stats_get( &ctx, &stats ) );
+        ASSERT_EQ( stats.samples_fed, NUMEL( data ) );
+        ASSERT( stats.tp_emitted > 0 );
+        ASSERT( stats.tp_emitted <= stats.samples_fed );
+        ASSERT( stats.cycles_4ptm > 0 );
+        ASSERT_EQ( stats.cycles_hcm, (size_t)0 );
+        ASSERT_EQ( stats.cycles_astm, (size_t)0 );
+        ASSERT( stats.residue_depth_max > 0 );
+        ASSERT( stats.mem_allocs > 0 );
+        ASSERT_EQ( stats.tp_prunes, (size_t)0 );
+
+        /* Reset clears the counters only, countings are left untouched */
+        ASSERT( RFC_stats_reset( &ctx ) );
+        ASSERT( RFC_stats_get( &ctx, &stats ) );
+        ASSERT_EQ( stats.samples_fed, (size_t)0 );
+        ASSERT_EQ( stats.cycles_4ptm, (size_t)0 );
+
+        ASSERT( RFC_feed( &ctx, data, NUMEL( data ) ) );
+        ASSERT( RFC_stats_get( &ctx, &stats ) );
+        ASSERT_EQ( stats.samples_fed, NUMEL( data ) );
+
+        ASSERT( RFC_finalize( &ctx, /* residual_method */ RFC_RES_HALFCYCLES ) );
+    } while(0);
+
+    if( ctx.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx ) );
+    }
+
+    PASS();
+}
+#endif /*RFC_STATS_SUPPORT*/
+
+#if RFC_USE_INTEGRAL_COUNTS > 1
+TEST RFC_counts_saturation_test(void)
+{
+    rfc_ctx_s ctx_sat = { sizeof(ctx_sat) };
+
+    do
+    {
+        RFC_VALUE_TYPE  data[]  = {1,6,2,8};
+        rfc_counts_t    counts;
+
+        ASSERT( RFC_init( &ctx_sat, 10 /*class_count*/, 1 /*class_width*/, -0.5 /*class_offset*/, 1 /*hysteresis*/, RFC_FLAGS_DEFAULT ) );
+        ASSERT_EQ( RFC_error_get( &ctx_sat ), RFC_ERROR_NOERROR );
+
+        /* Preload the 6->2 cell at the clamp, the next closed cycle saturates */
+        ASSERT( RFC_rfm_poke( &ctx_sat, 6 /*from_val*/, 2 /*to_val*/, (rfc_counts_t)RFC_COUNTS_LIMIT, false /*add_only*/ ) );
+        ASSERT_EQ( RFC_error_get( &ctx_sat ), RFC_ERROR_NOERROR );
+
+        /* Two passes close two 6-2 cycles and one 8-1 cycle */
+        ASSERT( RFC_feed( &ctx_sat, data, NUMEL( data ) ) );
+        ASSERT( RFC_feed( &ctx_sat, data, NUMEL( data ) ) );
+        ASSERT( RFC_finalize( &ctx_sat, /* residual_method */ RFC_RES_NONE ) );
+
+        /* The preloaded cell is clamped and the error latched */
+        ASSERT( RFC_rfm_peek( &ctx_sat, 6, 2, &counts ) );
+        ASSERT_EQ( counts, (rfc_counts_t)RFC_COUNTS_LIMIT );
+        ASSERT_EQ( RFC_error_get( &ctx_sat ), RFC_ERROR_COUNTS_SATURATED );
+
+        /* Counting proceeded, other cells are unaffected */
+        ASSERT( RFC_rfm_peek( &ctx_sat, 8, 1, &counts ) );
+        ASSERT_EQ( counts, (rfc_counts_t)RFC_FULL_CYCLE_INCREMENT );
+    } while(0);
+
+    if( ctx_sat.state != RFC_STATE_INIT0 )
+    {
+        ASSERT( RFC_deinit( &ctx_sat ) );
+    }
+
+    PASS();
+}
+#endif /*RFC_USE_INTEGRAL_COUNTS > 1*/
+
+#endif /*!RFC_MINIMAL*/
+
+
 TEST RFC_long_series( int ccnt, int class_count_ar )
 {
     bool                need_conf           =  false;
@@ -2042,6 +3694,66 @@ TEST RFC_at_test( void )
         FAIL();
     }
 }
+
+
+TEST RFC_at_lut_test( void )
+{
+    double Sa[]   = {  0.1, 1.0, 2.0, 2.0, 2.0, 3.0, 3.0, 2.0, 3.0, 4.0, 3.0, 2.0, 0.2 };
+    double Sm[]   = {  9.0, 4.0, 4.0, 3.0, 2.0, 3.0, 2.0, 1.0, 1.0, 1.0, 0.0, -2.0, -9.0 };
+    double Sa_t[ NUMEL( Sa ) ];
+    double tol    = 1e-3;  /* Grid nodes are exact, tolerance covers bilinear interpolation error */
+    int    i;
+
+    ASSERT( RFC_init( &ctx, 10 /* class_count */, 1 /* class_width */, 0 /* class_offset */,
+                            1 /* hysteresis */, 0 /*flags*/ ) );
+
+    ASSERT(
+    RFC_at_init( &ctx, NULL /* Sa */, NULL /* Sm */, 0 /* count */, 0.3 /* M */,
+                       0.0 /* Sm_rig */, -1.0 /* R_rig */, true /* R_pinned */, false /* symmetric */ )
+    );
+
+    /* Grid covering the test points, 400 cells per axis */
+    ASSERT( RFC_at_lut_init( &ctx, 10.0 /* Sa_max */, -10.0 /* Sm_min */, 10.0 /* Sm_max */,
+                                   400 /* Sa_divisions */, 400 /* Sm_divisions */ ) );
+    ASSERT( ctx.at_lut.grid != NULL );
+
+    /* Grid look-up against exact values, see RFC_at_test */
+    GREATEST_ASSERT_IN_RANGE( 0.0,       at_transform( &ctx,  0.0 /*Sa*/,  2.0 /*Sm*/ ), 0.0 /*tol*/ );
+    GREATEST_ASSERT_IN_RANGE( 0.153636,  at_transform( &ctx,  0.1 /*Sa*/,  9.0 /*Sm*/ ), tol /*tol*/ );  /* R =  89.0  */
+    GREATEST_ASSERT_IN_RANGE( 1.536363,  at_transform( &ctx,  1.0 /*Sa*/,  4.0 /*Sm*/ ), tol /*tol*/ );  /* R =  0.6   */
+    GREATEST_ASSERT_IN_RANGE( 2.836363,  at_transform( &ctx,  2.0 /*Sa*/,  4.0 /*Sm*/ ), tol /*tol*/ );  /* R =  0.333 */
+    GREATEST_ASSERT_IN_RANGE( 2.6,       at_transform( &ctx,  2.0 /*Sa*/,  2.0 /*Sm*/ ), tol /*tol*/ );  /* R =  0.0   */
+    GREATEST_ASSERT_IN_RANGE( 3.9,       at_transform( &ctx,  3.0 /*Sa*/,  3.0 /*Sm*/ ), tol /*tol*/ );  /* R =  0.0   */
+    GREATEST_ASSERT_IN_RANGE( 3.3,       at_transform( &ctx,  3.0 /*Sa*/,  1.0 /*Sm*/ ), tol /*tol*/ );  /* R = -0.5   */
+    GREATEST_ASSERT_IN_RANGE( 3.0,       at_transform( &ctx,  3.0 /*Sa*/,  0.0 /*Sm*/ ), tol /*tol*/ );  /* R = -1.0   */
+    GREATEST_ASSERT_IN_RANGE( 1.4,       at_transform( &ctx,  2.0 /*Sa*/, -2.0 /*Sm*/ ), tol /*tol*/ );  /* R = -Inf   */
+    GREATEST_ASSERT_IN_RANGE( 0.14,      at_transform( &ctx,  0.2 /*Sa*/, -9.0 /*Sm*/ ), tol /*tol*/ );  /* R = -Inf   */
+
+    /* Points off the grid take the exact path */
+    GREATEST_ASSERT_IN_RANGE( 20.0,      at_transform( &ctx, 20.0 /*Sa*/,  0.0 /*Sm*/ ), 1e-10 /*tol*/ );
+
+    /* Batch transformation matches the scalar API element-wise */
+    ASSERT( RFC_at_transform_batch( &ctx, Sa, Sm, Sa_t, NUMEL( Sa ) ) );
+
+    for( i = 0; i < (int)NUMEL( Sa ); i++ )
+    {
+        GREATEST_ASSERT_IN_RANGE( at_transform( &ctx, Sa[i], Sm[i] ), Sa_t[i], 1e-10 /*tol*/ );
+    }
+
+    /* RFC_at_init() rebuilds an attached grid for the new reference curve */
+    ASSERT(
+    RFC_at_init( &ctx, NULL /* Sa */, NULL /* Sm */, 0 /* count */, 0.3 /* M */,
+                       0.0 /* Sm_rig */, -1.0 /* R_rig */, true /* R_pinned */, true /* symmetric */ )
+    );
+
+    GREATEST_ASSERT_IN_RANGE( 2.6,       at_transform( &ctx,  2.0 /*Sa*/, -2.0 /*Sm*/ ), tol /*tol*/ );  /* R =  0.0   */
+    GREATEST_ASSERT_IN_RANGE( 3.9,       at_transform( &ctx,  3.0 /*Sa*/, -3.0 /*Sm*/ ), tol /*tol*/ );  /* R =  0.0   */
+
+    ASSERT( RFC_deinit( &ctx ) );
+    ASSERT( ctx.at_lut.grid == NULL );
+
+    PASS();
+}
 #endif /*RFC_AT_SUPPORT*/
 
 
@@ -2407,6 +4119,44 @@ SUITE( RFC_TEST_SUITE )
     RUN_TEST1( RFC_cycle_down, 1 );
     RUN_TEST1( RFC_residue_stress_test, 1 );
     RUN_TEST1( RFC_small_example, 1 );
+#if !RFC_MINIMAL
+    RUN_TEST1( RFC_feed_prefilter, 0 );
+    RUN_TEST1( RFC_feed_prefilter, 1 );
+    RUN_TEST1( RFC_ctx_merge_test, 0 );
+    RUN_TEST1( RFC_ctx_merge_test, 1 );
+    RUN_TEST( RFC_ctx_attach_test );
+    RUN_TEST( RFC_lc_rp_delta_test );
+#if RFC_DAMAGE_FAST
+    RUN_TEST( RFC_damage_lut_share_test );
+#endif /*RFC_DAMAGE_FAST*/
+#if RFC_HCM_SUPPORT
+    RUN_TEST( RFC_hcm_init_test );
+#endif /*RFC_HCM_SUPPORT*/
+    RUN_TEST( RFC_rfm_sparse_test );
+    RUN_TEST1( RFC_ctx_serialize_test, 0 );
+    RUN_TEST1( RFC_ctx_serialize_test, 1 );
+    RUN_TEST( RFC_finalize_preview_test );
+    RUN_TEST( RFC_feed_ring_test );
+#if RFC_FILE_SUPPORT
+    RUN_TEST( RFC_feed_file_test );
+#endif /*RFC_FILE_SUPPORT*/
+#if RFC_FILE_SUPPORT && RFC_TP_SUPPORT
+    RUN_TEST( RFC_tp_export_test );
+#endif /*RFC_FILE_SUPPORT && RFC_TP_SUPPORT*/
+#if RFC_DH_SUPPORT
+    RUN_TEST( RFC_dh_sparse_test );
+#endif /*RFC_DH_SUPPORT*/
+    RUN_TEST1( RFC_mem_arena_test, 1024 * 1024 );  /* Everything fits the slab */
+    RUN_TEST1( RFC_mem_arena_test, 256 );          /* Heap fallback */
+    RUN_TEST( RFC_wl_param_set_test );
+    RUN_TEST( RFC_damage_from_rfm_wl_test );
+#if RFC_STATS_SUPPORT
+    RUN_TEST( RFC_stats_test );
+#endif /*RFC_STATS_SUPPORT*/
+#if RFC_USE_INTEGRAL_COUNTS > 1
+    RUN_TEST( RFC_counts_saturation_test );
+#endif /*RFC_USE_INTEGRAL_COUNTS > 1*/
+#endif /*!RFC_MINIMAL*/
     RUN_TESTp( RFC_long_series, 1, 0 );   /* Using default class count */
 #if RFC_AR_SUPPORT
     RUN_TESTp( RFC_long_series, 1, 50 );  /* Using reduced class_count to test auto resizing */
@@ -2430,11 +4180,13 @@ SUITE( RFC_TEST_SUITE )
     RUN_TEST1( RFC_test_turning_points, 1 );
     RUN_TEST1( RFC_tp_prune_test, 1 );
     RUN_TEST1( RFC_tp_refeed_test, 1 );
+    RUN_TEST( RFC_tp_autoprune_test );
 
 #endif /*RFC_TP_SUPPORT*/
 #if RFC_AT_SUPPORT
     /* Test amplitude transformation */
     RUN_TEST( RFC_at_test );
+    RUN_TEST( RFC_at_lut_test );
 #endif /*RFC_AT_SUPPORT*/
 }
 
@@ -2472,6 +4224,26 @@ int main( int argc, char *argv[] )
         GREATEST_SUITE_EXTERN( RFC_WRAPPER_SUITE_ADVANCED );
         RUN_SUITE( RFC_WRAPPER_SUITE_ADVANCED );
     }
+    {
+        GREATEST_SUITE_EXTERN( RFC_WRAPPER_SUITE_MMAP );
+        RUN_SUITE( RFC_WRAPPER_SUITE_MMAP );
+    }
+    {
+        GREATEST_SUITE_EXTERN( RFC_WRAPPER_SUITE_BANK );
+        RUN_SUITE( RFC_WRAPPER_SUITE_BANK );
+    }
+    {
+        GREATEST_SUITE_EXTERN( RFC_WRAPPER_SUITE_REFEED );
+        RUN_SUITE( RFC_WRAPPER_SUITE_REFEED );
+    }
+    {
+        GREATEST_SUITE_EXTERN( RFC_WRAPPER_SUITE_ASYNC );
+        RUN_SUITE( RFC_WRAPPER_SUITE_ASYNC );
+    }
+    {
+        GREATEST_SUITE_EXTERN( RFC_WRAPPER_SUITE_STATIC );
+        RUN_SUITE( RFC_WRAPPER_SUITE_STATIC );
+    }
 #endif /*!RFC_MINIMAL*/
     GREATEST_MAIN_END();        /* display results */
 
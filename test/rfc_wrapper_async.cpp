@@ -0,0 +1,123 @@
+
+/* Using Rainflow C-Library asynchronous feed facade */
+
+#include "../src/config.h"
+
+// Check for correct configuration
+#if !RFC_MINIMAL            && \
+     RFC_TP_SUPPORT         && \
+     RFC_HCM_SUPPORT        && \
+     RFC_ASTM_SUPPORT       && \
+     RFC_USE_DELEGATES      && \
+     RFC_GLOBAL_EXTREMA     && \
+     RFC_DAMAGE_FAST        && \
+     RFC_DH_SUPPORT         && \
+     RFC_AT_SUPPORT         && \
+     RFC_AR_SUPPORT
+
+#include "../src/rainflow.h"
+#include "../src/rainflow.hpp"
+#include "../greatest/greatest.h"
+
+#include <vector>
+
+#define CHUNK_COUNT  16
+#define CHUNK_SIZE   1000
+
+
+/* Deterministic pseudo random load, same sequence for both counters */
+static void random_signal( std::vector<double> &data, size_t count )
+{
+    unsigned long long state = 815;
+
+    data.resize( count );
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        state   = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        data[i] = (double)( state >> 11 ) * ( 1.0 / 9007199254740992.0 ) * 99.0;
+    }
+}
+
+
+TEST wrapper_test_async( void )
+{
+    /* Chunks queued through the facade must count identically to feeding
+     * the same stream synchronously */
+    Rainflow                 rf_sync, rf_async;
+    Rainflow::rfc_rfm_item_v rfm_sync, rfm_async;
+    std::vector<double>      data;
+    double                   damage_sync, damage_async;
+    size_t                   n;
+
+    random_signal( data, CHUNK_COUNT * CHUNK_SIZE );
+
+    ASSERT( rf_sync.init ( 100, 1, -0.5, 1 ) );
+    ASSERT( rf_async.init( 100, 1, -0.5, 1 ) );
+
+    ASSERT( rf_sync.feed( data ) );
+    ASSERT( rf_sync.finalize( Rainflow::RFC_RES_HALFCYCLES ) );
+
+    {
+        /* Shallow queue, submission blocks while the queue is full */
+        RainflowAsync                  async( rf_async, /*queue_depth*/ 2 );
+        std::vector<std::future<bool>> pending;
+
+        for( n = 0; n < CHUNK_COUNT; n++ )
+        {
+            pending.push_back( async.feed_async( &data[ n * CHUNK_SIZE ], CHUNK_SIZE ) );
+        }
+        pending.push_back( async.finalize_async( Rainflow::RFC_RES_HALFCYCLES ) );
+
+        for( n = 0; n < pending.size(); n++ )
+        {
+            ASSERT( pending[n].get() );
+        }
+
+        async.wait();
+    }   /* Facade leaves scope, worker joined */
+
+    ASSERT( rf_sync.damage ( &damage_sync ) );
+    ASSERT( rf_async.damage( &damage_async ) );
+    ASSERT_EQ( damage_sync, damage_async );
+
+    ASSERT( rf_sync.rfm_get ( rfm_sync ) );
+    ASSERT( rf_async.rfm_get( rfm_async ) );
+    ASSERT_EQ( rfm_sync.size(), rfm_async.size() );
+
+    for( n = 0; n < rfm_sync.size(); n++ )
+    {
+        ASSERT_EQ( rfm_sync[n].from,   rfm_async[n].from );
+        ASSERT_EQ( rfm_sync[n].to,     rfm_async[n].to );
+        ASSERT_EQ( rfm_sync[n].counts, rfm_async[n].counts );
+    }
+
+    ASSERT( rf_sync.deinit() );
+    ASSERT( rf_async.deinit() );
+
+    PASS();
+}
+
+
+/* Test suite for rfc_test.c */
+extern "C"
+SUITE( RFC_WRAPPER_SUITE_ASYNC )
+{
+    RUN_TEST( wrapper_test_async );
+}
+
+#else
+#include "../greatest/greatest.h"
+
+TEST wrapper_test_async( void )
+{
+    fprintf( stdout, "\nNothing to do in this configuration!" );
+    PASS();
+}
+
+extern "C"
+SUITE( RFC_WRAPPER_SUITE_ASYNC )
+{
+    RUN_TEST( wrapper_test_async );
+}
+#endif
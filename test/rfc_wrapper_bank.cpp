@@ -0,0 +1,154 @@
+
+/* Using Rainflow C-Library batch engine for many independent channels */
+
+#include "../src/config.h"
+
+// Check for correct configuration
+#if !RFC_MINIMAL            && \
+     RFC_TP_SUPPORT         && \
+     RFC_HCM_SUPPORT        && \
+     RFC_ASTM_SUPPORT       && \
+     RFC_USE_DELEGATES      && \
+     RFC_GLOBAL_EXTREMA     && \
+     RFC_DAMAGE_FAST        && \
+     RFC_DH_SUPPORT         && \
+     RFC_AT_SUPPORT         && \
+     RFC_AR_SUPPORT
+
+#include "../src/rainflow.h"
+#include "../src/rainflow.hpp"
+#include "../greatest/greatest.h"
+
+#include <vector>
+
+#define NUMEL(x) (sizeof(x)/sizeof(*(x)))
+
+#define CHANNEL_COUNT  4
+#define FRAME_COUNT    8
+
+
+/* Per channel variants of the familiar 1,6,2,8 scenario, each channel must
+   count independently of its neighbors */
+static const double channel_signal[CHANNEL_COUNT][FRAME_COUNT] =
+{
+    { 1, 6, 2, 8, 1, 6, 2, 8 },
+    { 2, 7, 3, 9, 2, 7, 3, 9 },
+    { 1, 8, 1, 8, 1, 8, 1, 8 },
+    { 3, 5, 2, 6, 3, 5, 2, 6 },
+};
+
+
+/* Feed the reference channel sequentially and compare damage and rainflow
+   matrix against the bank channel */
+static enum greatest_test_res check_against_reference( Rainflow &channel, unsigned i )
+{
+    Rainflow                      ref;
+    Rainflow::rfc_rfm_item_v      rfm_ref, rfm_bank;
+    double                        damage_ref, damage_bank;
+
+    ASSERT( ref.init( 10, 1, -0.5, 1 ) );
+    ASSERT( ref.feed( channel_signal[i], FRAME_COUNT ) );
+    ASSERT( ref.finalize( Rainflow::RFC_RES_NONE ) );
+
+    ASSERT( ref.damage( &damage_ref ) );
+    ASSERT( channel.damage( &damage_bank ) );
+    ASSERT_EQ( damage_ref, damage_bank );
+
+    ASSERT( ref.rfm_get( rfm_ref ) );
+    ASSERT( channel.rfm_get( rfm_bank ) );
+    ASSERT_EQ( rfm_ref.size(), rfm_bank.size() );
+
+    for( size_t n = 0; n < rfm_ref.size(); n++ )
+    {
+        ASSERT_EQ( rfm_ref[n].from,   rfm_bank[n].from );
+        ASSERT_EQ( rfm_ref[n].to,     rfm_bank[n].to );
+        ASSERT_EQ( rfm_ref[n].counts, rfm_bank[n].counts );
+    }
+
+    ASSERT( ref.deinit() );
+
+    PASS();
+}
+
+
+TEST wrapper_test_bank_interleaved( void )
+{
+    /* Worker pool enabled, frames gathered from the interleaved buffer */
+    RainflowBank bank( CHANNEL_COUNT, /*num_threads*/ 2 );
+    double       frames[ CHANNEL_COUNT * FRAME_COUNT ];
+    unsigned     i;
+    size_t       f;
+
+    for( f = 0; f < FRAME_COUNT; f++ )
+    {
+        for( i = 0; i < CHANNEL_COUNT; i++ )
+        {
+            frames[ f * CHANNEL_COUNT + i ] = channel_signal[i][f];
+        }
+    }
+
+    ASSERT( bank.init( 10, 1, -0.5, 1 ) );
+    ASSERT( bank.feed_batch( frames, FRAME_COUNT, RainflowBank::RFC_BATCH_INTERLEAVED ) );
+    ASSERT( bank.finalize( Rainflow::RFC_RES_NONE ) );
+
+    for( i = 0; i < CHANNEL_COUNT; i++ )
+    {
+        CHECK_CALL( check_against_reference( bank.channel( i ), i ) );
+    }
+
+    PASS();
+}
+
+
+TEST wrapper_test_bank_planar( void )
+{
+    /* Inline path (no worker pool), channels contiguous in memory */
+    RainflowBank bank( CHANNEL_COUNT, /*num_threads*/ 1 );
+    double       frames[ CHANNEL_COUNT * FRAME_COUNT ];
+    unsigned     i;
+    size_t       f;
+
+    for( i = 0; i < CHANNEL_COUNT; i++ )
+    {
+        for( f = 0; f < FRAME_COUNT; f++ )
+        {
+            frames[ (size_t)i * FRAME_COUNT + f ] = channel_signal[i][f];
+        }
+    }
+
+    ASSERT( bank.init( 10, 1, -0.5, 1 ) );
+    ASSERT( bank.feed_batch( frames, FRAME_COUNT, RainflowBank::RFC_BATCH_PLANAR ) );
+    ASSERT( bank.finalize( Rainflow::RFC_RES_NONE ) );
+
+    for( i = 0; i < CHANNEL_COUNT; i++ )
+    {
+        CHECK_CALL( check_against_reference( bank.channel( i ), i ) );
+    }
+
+    PASS();
+}
+
+
+/* Test suite for rfc_test.c */
+extern "C"
+SUITE( RFC_WRAPPER_SUITE_BANK )
+{
+    RUN_TEST( wrapper_test_bank_interleaved );
+    RUN_TEST( wrapper_test_bank_planar );
+}
+
+#else
+#include "../greatest/greatest.h"
+
+TEST wrapper_test_bank( void )
+{
+    fprintf( stdout, "\nNothing to do in this configuration!" );
+    PASS();
+}
+
+extern "C"
+SUITE( RFC_WRAPPER_SUITE_BANK )
+{
+    RUN_TEST( wrapper_test_bank );
+}
+#endif
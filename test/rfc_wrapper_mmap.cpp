@@ -0,0 +1,129 @@
+
+/* Using Rainflow C-Library with memory mapped turning point storage */
+
+#include "../src/config.h"
+
+// Check for correct configuration
+#if !defined(_WIN32)        && \
+    !RFC_MINIMAL            && \
+     RFC_TP_SUPPORT         && \
+     RFC_HCM_SUPPORT        && \
+     RFC_ASTM_SUPPORT       && \
+     RFC_USE_DELEGATES      && \
+     RFC_GLOBAL_EXTREMA     && \
+     RFC_DAMAGE_FAST        && \
+     RFC_DH_SUPPORT         && \
+     RFC_AT_SUPPORT         && \
+     RFC_AR_SUPPORT
+
+#include "../src/rainflow.h"
+#include "../src/rainflow_mmap.hpp"
+#include "../greatest/greatest.h"
+
+#define NUMEL(x) (sizeof(x)/sizeof(*(x)))
+
+// Declare memory mapped turning points storage (backed by an unlinked
+// temporary file, see src/rainflow_mmap.hpp)
+namespace RFC_CPP_NAMESPACE
+{
+    typedef struct rfc_value_tuple rfc_value_tuple_s;  /**< Tuple of value and index position */
+}
+
+
+/* If RFC_TP_STORAGE is defined, rainflow.hpp will define the
+ * class Rainflow supporting external turning points storage
+ * with given type */
+#define RFC_TP_STORAGE MmapStorageT<RFC_CPP_NAMESPACE::rfc_value_tuple_s>
+#include "../src/rainflow.hpp"
+
+
+
+
+TEST wrapper_test_mmap( void )
+{
+    /* Same scenario as in rfc_wrapper_advanced.cpp, turning points
+     * are kept in a memory mapped file instead of a std::vector */
+    Rainflow rf;
+
+    double values[] = { 1,6,2,8 };
+    std::vector<double> data( values, values + 4 );
+
+    ASSERT( rf.init( 10, 1, -0.5, 1 ) );
+
+    ASSERT( rf.feed( values, NUMEL(values) ) );
+    ASSERT( rf.tp_storage().size() == 3 );
+
+    ASSERT( rf.feed( data ) );
+    ASSERT( rf.tp_storage().size() == 7 );
+
+    ASSERT( rf.finalize( Rainflow::RFC_RES_REPEATED ) );
+    ASSERT( rf.tp_storage().size() == 8 );
+
+    ASSERT_EQ( rf.tp_storage()[0].value, 1 );
+    ASSERT_EQ( rf.tp_storage()[1].value, 6 );
+    ASSERT_EQ( rf.tp_storage()[2].value, 2 );
+    ASSERT_EQ( rf.tp_storage()[3].value, 8 );
+    ASSERT_EQ( rf.tp_storage()[4].value, 1 );
+    ASSERT_EQ( rf.tp_storage()[5].value, 6 );
+    ASSERT_EQ( rf.tp_storage()[6].value, 2 );
+    ASSERT_EQ( rf.tp_storage()[7].value, 8 );
+
+    ASSERT( rf.deinit() );
+
+    PASS();
+}
+
+
+TEST wrapper_test_mmap_growth( void )
+{
+    /* Exceed the initial mapping multiple times, storage grows by remapping */
+    Rainflow rf;
+    size_t   i;
+
+    ASSERT( rf.init( 10, 1, -0.5, 1 ) );
+
+    for( i = 0; i < 10000; i++ )
+    {
+        double values[] = { 1, 6, 2, 8 };
+
+        ASSERT( rf.feed( values, NUMEL(values) ) );
+    }
+
+    ASSERT( rf.finalize( Rainflow::RFC_RES_NONE ) );
+    ASSERT( rf.tp_storage().size() >= 4 * 10000 );
+    ASSERT( rf.tp_storage().capacity() >= rf.tp_storage().size() );
+
+    /* Spot check begin and end of the mapped history */
+    ASSERT_EQ( rf.tp_storage()[0].value, 1 );
+    ASSERT_EQ( rf.tp_storage()[1].value, 6 );
+    ASSERT_EQ( rf.tp_storage()[ rf.tp_storage().size() - 1 ].value, 8 );
+
+    ASSERT( rf.deinit() );
+
+    PASS();
+}
+
+
+/* Test suite for rfc_test.c */
+extern "C"
+SUITE( RFC_WRAPPER_SUITE_MMAP )
+{
+    RUN_TEST( wrapper_test_mmap );
+    RUN_TEST( wrapper_test_mmap_growth );
+}
+
+#else
+#include "../greatest/greatest.h"
+
+TEST wrapper_test_mmap( void )
+{
+    fprintf( stdout, "\nNothing to do in this configuration!" );
+    PASS();
+}
+
+extern "C"
+SUITE( RFC_WRAPPER_SUITE_MMAP )
+{
+    RUN_TEST( wrapper_test_mmap );
+}
+#endif
@@ -0,0 +1,171 @@
+
+/* Using Rainflow C-Library multithreaded turning point refeed */
+
+#include "../src/config.h"
+
+// Check for correct configuration
+#if !RFC_MINIMAL            && \
+     RFC_TP_SUPPORT         && \
+     RFC_HCM_SUPPORT        && \
+     RFC_ASTM_SUPPORT       && \
+     RFC_USE_DELEGATES      && \
+     RFC_GLOBAL_EXTREMA     && \
+     RFC_DAMAGE_FAST        && \
+     RFC_DH_SUPPORT         && \
+     RFC_AT_SUPPORT         && \
+     RFC_AR_SUPPORT
+
+#include "../src/rainflow.h"
+#include "../greatest/greatest.h"
+
+#include <vector>
+
+// Declare user defined turning points storage (tp_storage)
+namespace RFC_CPP_NAMESPACE
+{
+    typedef struct rfc_value_tuple rfc_value_tuple_s;  /**< Tuple of value and index position */
+    typedef std::vector<rfc_value_tuple_s> tp_storage;  /**< Turning points storage */
+}
+
+
+/* If RFC_TP_STORAGE is defined, rainflow.hpp will define the
+ * class Rainflow supporting external turning points storage
+ * with given type */
+#define RFC_TP_STORAGE RFC_CPP_NAMESPACE::tp_storage
+#include "../src/rainflow.hpp"
+
+#define NUM_THREADS  4
+
+
+/* Deterministic pseudo random load, nearly every sample a turning point */
+static void random_signal( std::vector<double> &data, size_t count )
+{
+    unsigned long long state = 4711;
+
+    data.resize( count );
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        state   = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        data[i] = (double)( state >> 11 ) * ( 1.0 / 9007199254740992.0 ) * 99.0;
+    }
+}
+
+
+static enum greatest_test_res feed_and_refeed( Rainflow &rf_seq, Rainflow &rf_par, size_t count )
+{
+    std::vector<double> data;
+
+    random_signal( data, count );
+
+    ASSERT( rf_seq.init( 100, 1, -0.5, 1 ) );
+    ASSERT( rf_par.init( 100, 1, -0.5, 1 ) );
+
+    ASSERT( rf_seq.feed( data ) );
+    ASSERT( rf_par.feed( data ) );
+
+    /* Requantize the turning point history with a raised hysteresis */
+    ASSERT( rf_seq.tp_refeed         ( 5.0, NULL ) );
+    ASSERT( rf_par.tp_refeed_parallel( 5.0, NULL, NUM_THREADS ) );
+
+    PASS();
+}
+
+
+TEST wrapper_test_refeed_fallback( void )
+{
+    /* History shorter than NUM_THREADS * 1024 turning points, the parallel
+     * variant falls back to tp_refeed() and must match exactly */
+    Rainflow                 rf_seq, rf_par;
+    Rainflow::rfc_rfm_item_v rfm_seq, rfm_par;
+    double                   damage_seq, damage_par;
+
+    CHECK_CALL( feed_and_refeed( rf_seq, rf_par, 1000 ) );
+
+    ASSERT( rf_seq.damage( &damage_seq ) );
+    ASSERT( rf_par.damage( &damage_par ) );
+    ASSERT_EQ( damage_seq, damage_par );
+
+    ASSERT( rf_seq.rfm_get( rfm_seq ) );
+    ASSERT( rf_par.rfm_get( rfm_par ) );
+    ASSERT_EQ( rfm_seq.size(), rfm_par.size() );
+
+    for( size_t n = 0; n < rfm_seq.size(); n++ )
+    {
+        ASSERT_EQ( rfm_seq[n].from,   rfm_par[n].from );
+        ASSERT_EQ( rfm_seq[n].to,     rfm_par[n].to );
+        ASSERT_EQ( rfm_seq[n].counts, rfm_par[n].counts );
+    }
+
+    ASSERT_EQ( rf_seq.tp_storage().size(), rf_par.tp_storage().size() );
+
+    ASSERT( rf_seq.deinit() );
+    ASSERT( rf_par.deinit() );
+
+    PASS();
+}
+
+
+TEST wrapper_test_refeed_parallel( void )
+{
+    /* Long history, counted concurrently on partitions. Results match the
+     * sequential refeed up to boundary effects at the partition seams, see
+     * tp_refeed_parallel() */
+    Rainflow                 rf_seq, rf_par;
+    Rainflow::rfc_rfm_item_v rfm_seq, rfm_par;
+    double                   damage_seq, damage_par;
+    double                   counts_seq = 0.0, counts_par = 0.0;
+
+    CHECK_CALL( feed_and_refeed( rf_seq, rf_par, 30000 ) );
+
+    ASSERT( rf_seq.damage( &damage_seq ) );
+    ASSERT( rf_par.damage( &damage_par ) );
+    ASSERT( damage_seq > 0.0 );
+    ASSERT_IN_RANGE( 1.0, damage_par / damage_seq, 1e-2 );
+
+    ASSERT( rf_seq.rfm_get( rfm_seq ) );
+    ASSERT( rf_par.rfm_get( rfm_par ) );
+
+    for( size_t n = 0; n < rfm_seq.size(); n++ ) counts_seq += (double)rfm_seq[n].counts;
+    for( size_t n = 0; n < rfm_par.size(); n++ ) counts_par += (double)rfm_par[n].counts;
+
+    /* At most one cycle may get lost or shifted per partition seam */
+    ASSERT( counts_seq > 0.0 );
+    ASSERT_IN_RANGE( counts_seq, counts_par, (double)( NUM_THREADS - 1 ) * RFC_FULL_CYCLE_INCREMENT );
+
+    /* Stream order of the recombined turning points */
+    for( size_t n = 1; n < rf_par.tp_storage().size(); n++ )
+    {
+        ASSERT( rf_par.tp_storage()[n-1].pos < rf_par.tp_storage()[n].pos );
+    }
+
+    ASSERT( rf_seq.deinit() );
+    ASSERT( rf_par.deinit() );
+
+    PASS();
+}
+
+
+/* Test suite for rfc_test.c */
+extern "C"
+SUITE( RFC_WRAPPER_SUITE_REFEED )
+{
+    RUN_TEST( wrapper_test_refeed_fallback );
+    RUN_TEST( wrapper_test_refeed_parallel );
+}
+
+#else
+#include "../greatest/greatest.h"
+
+TEST wrapper_test_refeed( void )
+{
+    fprintf( stdout, "\nNothing to do in this configuration!" );
+    PASS();
+}
+
+extern "C"
+SUITE( RFC_WRAPPER_SUITE_REFEED )
+{
+    RUN_TEST( wrapper_test_refeed );
+}
+#endif
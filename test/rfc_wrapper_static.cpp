@@ -0,0 +1,171 @@
+
+/* Using Rainflow C-Library compile time specialized counter */
+
+#include "../src/config.h"
+
+// Check for correct configuration
+#if !RFC_MINIMAL            && \
+     RFC_TP_SUPPORT         && \
+     RFC_HCM_SUPPORT        && \
+     RFC_ASTM_SUPPORT       && \
+     RFC_USE_DELEGATES      && \
+     RFC_GLOBAL_EXTREMA     && \
+     RFC_DAMAGE_FAST        && \
+     RFC_DH_SUPPORT         && \
+     RFC_AT_SUPPORT         && \
+     RFC_AR_SUPPORT
+
+#include "../src/rainflow.h"
+#include "../src/rainflow.hpp"
+#include "../greatest/greatest.h"
+
+#include <vector>
+
+#define NUMEL(x) (sizeof(x)/sizeof(*(x)))
+
+
+/* Derived counter exercising the CRTP hooks */
+struct HookCounter : RainflowStaticT<HookCounter>
+{
+    HookCounter() : cycles_seen( 0 ), turning_points_seen( 0 ) {}
+
+    void on_cycle( const rfc_value_tuple_s &, const rfc_value_tuple_s & ) { cycles_seen++; }
+    void on_turning_point( const rfc_value_tuple_s & )                    { turning_points_seen++; }
+
+    size_t cycles_seen;
+    size_t turning_points_seen;
+};
+
+
+/* Deterministic pseudo random load */
+static void random_signal( std::vector<double> &data, size_t count )
+{
+    unsigned long long state = 42;
+
+    data.resize( count );
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        state   = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        data[i] = (double)( state >> 11 ) * ( 1.0 / 9007199254740992.0 ) * 99.0;
+    }
+}
+
+
+TEST wrapper_test_static( void )
+{
+    /* The familiar 1,6,2,8 scenario, see rfc_wrapper_advanced.cpp: two
+     * passes close two 6-2 cycles and one 8-1 cycle, the residue keeps
+     * the enclosing 1,8 */
+    RainflowStatic rf;
+
+    double values[] = { 1,6,2,8, 1,6,2,8 };
+
+    ASSERT( rf.init( 10, 1, -0.5, 1 ) );
+
+    ASSERT( rf.feed( values, NUMEL(values) ) );
+    ASSERT( rf.finalize() );
+
+    ASSERT_EQ( rf.rfm_at( 6, 2 ), (RainflowStatic::rfc_counts_t)( 2 * RFC_FULL_CYCLE_INCREMENT ) );
+    ASSERT_EQ( rf.rfm_at( 8, 1 ), (RainflowStatic::rfc_counts_t)RFC_FULL_CYCLE_INCREMENT );
+    ASSERT_EQ( rf.rfm_at( 2, 6 ), 0 );
+    ASSERT( rf.damage() > 0.0 );
+    ASSERT_EQ( rf.pos(), NUMEL(values) );
+    ASSERT_EQ( rf.residue_cnt(), (size_t)2 );
+
+    PASS();
+}
+
+
+TEST wrapper_test_static_vs_dynamic( void )
+{
+    /* Statically dispatched counting must match the generic core: same
+     * rainflow matrix and damage on a long random load */
+    RainflowStatic           rf_static;
+    Rainflow                 rf;
+    Rainflow::rfc_rfm_item_v rfm;
+    std::vector<double>      data;
+    double                   damage;
+    size_t                   n;
+
+    random_signal( data, 5000 );
+
+    ASSERT( rf_static.init( 100, 1, -0.5, 1 ) );
+    ASSERT( rf.init       ( 100, 1, -0.5, 1 ) );
+
+    ASSERT( rf_static.feed( &data[0], data.size() ) );
+    ASSERT( rf.feed( data ) );
+
+    ASSERT( rf_static.finalize() );
+    ASSERT( rf.finalize( Rainflow::RFC_RES_NONE ) );
+
+    ASSERT( rf.rfm_get( rfm ) );
+    ASSERT( rfm.size() > 0 );
+
+    for( n = 0; n < rfm.size(); n++ )
+    {
+        ASSERT_EQ( rfm[n].counts, rf_static.rfm_at( rfm[n].from, rfm[n].to ) );
+    }
+
+    ASSERT( rf.damage( &damage ) );
+    ASSERT( damage > 0.0 );
+    ASSERT_IN_RANGE( 1.0, rf_static.damage() / damage, 1e-10 );
+
+    ASSERT( rf.deinit() );
+
+    PASS();
+}
+
+
+TEST wrapper_test_static_hooks( void )
+{
+    /* CRTP hooks fire for every closed cycle and confirmed turning point,
+     * counting itself stays untouched */
+    HookCounter         hooked;
+    RainflowStatic      plain;
+    std::vector<double> data;
+
+    random_signal( data, 1000 );
+
+    ASSERT( hooked.init( 100, 1, -0.5, 1 ) );
+    ASSERT( plain.init ( 100, 1, -0.5, 1 ) );
+
+    ASSERT( hooked.feed( &data[0], data.size() ) );
+    ASSERT( plain.feed ( &data[0], data.size() ) );
+
+    ASSERT( hooked.finalize() );
+    ASSERT( plain.finalize() );
+
+    ASSERT( hooked.cycles_seen > 0 );
+    ASSERT( hooked.turning_points_seen > 0 );
+    ASSERT( hooked.turning_points_seen >= 2 * hooked.cycles_seen );
+    ASSERT_EQ( plain.damage(), hooked.damage() );
+
+    PASS();
+}
+
+
+/* Test suite for rfc_test.c */
+extern "C"
+SUITE( RFC_WRAPPER_SUITE_STATIC )
+{
+    RUN_TEST( wrapper_test_static );
+    RUN_TEST( wrapper_test_static_vs_dynamic );
+    RUN_TEST( wrapper_test_static_hooks );
+}
+
+#else
+#include "../greatest/greatest.h"
+
+TEST wrapper_test_static( void )
+{
+    fprintf( stdout, "\nNothing to do in this configuration!" );
+    PASS();
+}
+
+extern "C"
+SUITE( RFC_WRAPPER_SUITE_STATIC )
+{
+    RUN_TEST( wrapper_test_static );
+}
+#endif